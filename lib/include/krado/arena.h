@@ -0,0 +1,109 @@
+// SPDX-FileCopyrightText: 2026 David Andrs <andrsd@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "krado/ptr.h"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <utility>
+
+namespace krado {
+
+/// Pool of objects handed out as `Ptr`s
+///
+/// Objects are allocated in chunks, so creating many small objects (like mesh vertices) takes one
+/// heap allocation per chunk instead of one per object. A chunk is freed once all objects in it
+/// were destroyed, so the `Ptr`s can outlive the arena.
+///
+/// Allocating is not thread-safe, destroying the `Ptr`s is.
+///
+/// @tparam T C++ type of the objects
+/// @tparam CHUNK_SIZE Number of objects in a chunk
+template <typename T, std::size_t CHUNK_SIZE = 256>
+class Arena {
+public:
+    Arena() = default;
+    Arena(const Arena &) = delete;
+    Arena & operator=(const Arena &) = delete;
+
+    Arena(Arena && other) noexcept :
+        chunk_(std::exchange(other.chunk_, nullptr)),
+        next_(std::exchange(other.next_, 0))
+    {
+    }
+
+    ~Arena() { release_chunk(); }
+
+    /// Allocate a new object and return a `Ptr` to it
+    ///
+    /// @tparam ARGS
+    /// @param args Arguments passed into a constructor
+    template <typename... ARGS>
+    Ptr<T>
+    alloc(ARGS &&... args)
+    {
+        if (this->chunk_ == nullptr || this->next_ == CHUNK_SIZE) {
+            release_chunk();
+            this->chunk_ = new Chunk();
+            this->next_ = 0;
+        }
+        auto & blk = this->chunk_->blocks[this->next_];
+        T * obj = new (blk.storage) T(std::forward<ARGS>(args)...);
+        blk.ptr = const_cast<void *>(static_cast<const void *>(obj));
+        blk.chunk = this->chunk_;
+        this->chunk_->refs.fetch_add(1, std::memory_order_relaxed);
+        ++this->next_;
+        return Ptr<T>(static_cast<detail::PtrControlBlock *>(&blk), obj);
+    }
+
+private:
+    struct Chunk;
+
+    /// Control block with the object stored in it
+    struct Block : detail::PtrControlBlock {
+        Block() : detail::PtrControlBlock(&Block::dispose_block) {}
+
+        static void
+        dispose_block(detail::PtrControlBlock * b)
+        {
+            auto * blk = static_cast<Block *>(b);
+            static_cast<T *>(blk->ptr)->~T();
+            Chunk::release(blk->chunk);
+        }
+
+        /// Chunk this block lives in
+        Chunk * chunk = nullptr;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    struct Chunk {
+        static void
+        release(Chunk * chunk)
+        {
+            if (chunk->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                delete chunk;
+        }
+
+        /// Number of live objects, plus one while the arena allocates from this chunk
+        std::atomic<std::size_t> refs { 1 };
+        std::array<Block, CHUNK_SIZE> blocks;
+    };
+
+    void
+    release_chunk()
+    {
+        if (this->chunk_ != nullptr)
+            Chunk::release(this->chunk_);
+        this->chunk_ = nullptr;
+    }
+
+    /// Chunk we allocate from
+    Chunk * chunk_ = nullptr;
+    /// Next free block in `chunk_`
+    std::size_t next_ = 0;
+};
+
+} // namespace krado
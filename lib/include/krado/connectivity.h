@@ -0,0 +1,336 @@
+// SPDX-FileCopyrightText: 2026 David Andrs <andrsd@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "krado/element.h"
+#include "krado/types.h"
+#include <compare>
+#include <iterator>
+#include <vector>
+
+namespace krado {
+
+/// Read-only view of elements stored in compressed row storage (see `Connectivity`)
+class ElementsView {
+public:
+    /// Random access iterator over the elements of the view
+    class Iterator {
+    public:
+        using iterator_concept = std::random_access_iterator_tag;
+        using iterator_category = std::input_iterator_tag;
+        using value_type = ElementView;
+        using difference_type = std::ptrdiff_t;
+        using reference = ElementView;
+
+        Iterator() = default;
+        Iterator(const ElementsView & view, std::size_t idx) :
+            types_(view.types_),
+            offsets_(view.offsets_),
+            ids_(view.ids_),
+            idx_(idx)
+        {
+        }
+
+        ElementView
+        operator*() const
+        {
+            auto first = this->offsets_[this->idx_];
+            auto n = this->offsets_[this->idx_ + 1] - first;
+            return { this->types_[this->idx_], { this->ids_ + first, n } };
+        }
+
+        ElementView
+        operator[](difference_type n) const
+        {
+            return *(*this + n);
+        }
+
+        Iterator &
+        operator++()
+        {
+            ++this->idx_;
+            return *this;
+        }
+
+        Iterator
+        operator++(int)
+        {
+            auto tmp = *this;
+            ++this->idx_;
+            return tmp;
+        }
+
+        Iterator &
+        operator--()
+        {
+            --this->idx_;
+            return *this;
+        }
+
+        Iterator
+        operator--(int)
+        {
+            auto tmp = *this;
+            --this->idx_;
+            return tmp;
+        }
+
+        Iterator &
+        operator+=(difference_type n)
+        {
+            this->idx_ += n;
+            return *this;
+        }
+
+        Iterator &
+        operator-=(difference_type n)
+        {
+            this->idx_ -= n;
+            return *this;
+        }
+
+        friend Iterator
+        operator+(Iterator it, difference_type n)
+        {
+            return it += n;
+        }
+
+        friend Iterator
+        operator+(difference_type n, Iterator it)
+        {
+            return it += n;
+        }
+
+        friend Iterator
+        operator-(Iterator it, difference_type n)
+        {
+            return it -= n;
+        }
+
+        friend difference_type
+        operator-(const Iterator & a, const Iterator & b)
+        {
+            return static_cast<difference_type>(a.idx_) - static_cast<difference_type>(b.idx_);
+        }
+
+        friend bool
+        operator==(const Iterator & a, const Iterator & b)
+        {
+            return a.idx_ == b.idx_;
+        }
+
+        friend auto
+        operator<=>(const Iterator & a, const Iterator & b)
+        {
+            return a.idx_ <=> b.idx_;
+        }
+
+    private:
+        const ElementType * types_ = nullptr;
+        const Index * offsets_ = nullptr;
+        const Index * ids_ = nullptr;
+        std::size_t idx_ = 0;
+    };
+
+    using value_type = ElementView;
+    using iterator = Iterator;
+    using const_iterator = Iterator;
+
+    ElementsView() = default;
+    ElementsView(const ElementType * types,
+                 const Index * offsets,
+                 const Index * ids,
+                 std::size_t n) :
+        types_(types),
+        offsets_(offsets),
+        ids_(ids),
+        n_(n)
+    {
+    }
+
+    /// Get number of elements
+    ///
+    /// @return Number of elements
+    [[nodiscard]] std::size_t
+    size() const
+    {
+        return this->n_;
+    }
+
+    /// Check if the view is empty
+    ///
+    /// @return `true` if there are no elements
+    [[nodiscard]] bool
+    empty() const
+    {
+        return this->n_ == 0;
+    }
+
+    /// Get an element
+    ///
+    /// @param idx Index of the element
+    /// @return Element view
+    [[nodiscard]] ElementView
+    operator[](std::size_t idx) const
+    {
+        return *Iterator(*this, idx);
+    }
+
+    [[nodiscard]] Iterator
+    begin() const
+    {
+        return { *this, 0 };
+    }
+
+    [[nodiscard]] Iterator
+    end() const
+    {
+        return { *this, this->n_ };
+    }
+
+private:
+    const ElementType * types_ = nullptr;
+    const Index * offsets_ = nullptr;
+    const Index * ids_ = nullptr;
+    std::size_t n_ = 0;
+};
+
+/// Element connectivity stored in compressed row storage
+///
+/// Vertex IDs of all elements are stored in one flat array, `offsets()[i]` is where the vertex
+/// IDs of element `i` start. Every element occupies only as much memory as it has vertices (plus
+/// its type and offset), and loops over elements stream through contiguous memory.
+class Connectivity {
+public:
+    Connectivity();
+
+    /// Create connectivity from elements
+    ///
+    /// @param elems Elements
+    Connectivity(const std::vector<Element> & elems);
+
+    /// Create connectivity from its compressed row storage
+    ///
+    /// The arrays are taken over without copying.
+    ///
+    /// @param types Type of every element
+    /// @param offsets Offsets into `ids` (number of elements + 1 entries)
+    /// @param ids Vertex IDs of all elements
+    Connectivity(std::vector<ElementType> types,
+                 std::vector<Index> offsets,
+                 std::vector<Index> ids);
+
+    /// Get number of elements
+    ///
+    /// @return Number of elements
+    [[nodiscard]] std::size_t size() const;
+
+    /// Check if there are no elements
+    ///
+    /// @return `true` if empty
+    [[nodiscard]] bool empty() const;
+
+    /// Reserve memory
+    ///
+    /// @param n_elems Number of elements
+    /// @param n_ids Total number of vertex IDs
+    void reserve(std::size_t n_elems, std::size_t n_ids);
+
+    /// Remove all elements
+    void clear();
+
+    /// Get an element
+    ///
+    /// @param idx Index of the element
+    /// @return Element view
+    [[nodiscard]] ElementView
+    operator[](std::size_t idx) const
+    {
+        auto first = this->offsets_[idx];
+        auto n = this->offsets_[idx + 1] - first;
+        return { this->types_[idx], { this->ids_.data() + first, n } };
+    }
+
+    /// Get an element with bounds checking
+    ///
+    /// @param idx Index of the element
+    /// @return Element view
+    [[nodiscard]] ElementView at(std::size_t idx) const;
+
+    /// Append an element
+    ///
+    /// @param elem Element to append
+    void push_back(ElementView elem);
+
+    /// Append an element
+    ///
+    /// @param elem Element to append
+    void push_back(const Element & elem);
+
+    /// Append elements
+    ///
+    /// @param elems Elements to append
+    /// @param ofst Offset added to vertex IDs of the appended elements
+    void append(ElementsView elems, Index ofst = 0);
+
+    /// Shift vertex IDs of a range of elements
+    ///
+    /// @param first First element
+    /// @param last One past the last element
+    /// @param ofst Offset added to the vertex IDs
+    void shift(std::size_t first, std::size_t last, Index ofst);
+
+    /// Renumber vertex IDs of all elements
+    ///
+    /// @param new_ids New vertex ID for every old vertex ID
+    void remap(Span<const Index> new_ids);
+
+    /// Reorder elements
+    ///
+    /// @param new_ids New index for every element (a permutation)
+    void permute(Span<const Index> new_ids);
+
+    /// Get element types
+    ///
+    /// @return Type of every element
+    [[nodiscard]] const std::vector<ElementType> & types() const;
+
+    /// Get offsets into the vertex ID array
+    ///
+    /// @return Offsets (number of elements + 1 entries)
+    [[nodiscard]] const std::vector<Index> & offsets() const;
+
+    /// Get vertex IDs of all elements
+    ///
+    /// @return Vertex IDs
+    [[nodiscard]] const std::vector<Index> & ids() const;
+
+    /// Get a view of the elements
+    ///
+    /// @return View of the elements
+    [[nodiscard]] ElementsView view() const;
+
+    operator ElementsView() const
+    {
+        return this->view();
+    }
+
+    /// Get the amount of memory used by the connectivity
+    ///
+    /// @return Memory in bytes
+    [[nodiscard]] std::size_t memory_usage() const;
+
+private:
+    /// Check that the vertex IDs can be addressed by `Index` offsets
+    void check_size(std::size_t n_ids) const;
+
+    /// Element types
+    std::vector<ElementType> types_;
+    /// Offsets into `ids_`
+    std::vector<Index> offsets_;
+    /// Vertex IDs
+    std::vector<Index> ids_;
+};
+
+} // namespace krado
@@ -0,0 +1,361 @@
+// SPDX-FileCopyrightText: 2026 David Andrs <andrsd@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "krado/point.h"
+#include "krado/types.h"
+#include <compare>
+#include <iterator>
+#include <vector>
+
+namespace krado {
+
+class BoundingBox3D;
+class Trsf;
+
+/// Read-only view of points whose coordinates are stored in separate x, y and z arrays
+///
+/// Points are returned by value, so the view can be used where a range of points is needed
+/// (range-based for loops, `std::ranges` algorithms, etc.)
+class PointsView {
+public:
+    /// Random access iterator over the points of the view
+    class Iterator {
+    public:
+        using iterator_concept = std::random_access_iterator_tag;
+        using iterator_category = std::input_iterator_tag;
+        using value_type = Point;
+        using difference_type = std::ptrdiff_t;
+        using reference = Point;
+
+        Iterator() = default;
+        Iterator(const PointsView & view, std::size_t idx) :
+            x_(view.x_),
+            y_(view.y_),
+            z_(view.z_),
+            idx_(idx)
+        {
+        }
+
+        Point
+        operator*() const
+        {
+            return Point(this->x_[this->idx_], this->y_[this->idx_], this->z_[this->idx_]);
+        }
+
+        Point
+        operator[](difference_type n) const
+        {
+            return *(*this + n);
+        }
+
+        Iterator &
+        operator++()
+        {
+            ++this->idx_;
+            return *this;
+        }
+
+        Iterator
+        operator++(int)
+        {
+            auto tmp = *this;
+            ++this->idx_;
+            return tmp;
+        }
+
+        Iterator &
+        operator--()
+        {
+            --this->idx_;
+            return *this;
+        }
+
+        Iterator
+        operator--(int)
+        {
+            auto tmp = *this;
+            --this->idx_;
+            return tmp;
+        }
+
+        Iterator &
+        operator+=(difference_type n)
+        {
+            this->idx_ += n;
+            return *this;
+        }
+
+        Iterator &
+        operator-=(difference_type n)
+        {
+            this->idx_ -= n;
+            return *this;
+        }
+
+        friend Iterator
+        operator+(Iterator it, difference_type n)
+        {
+            return it += n;
+        }
+
+        friend Iterator
+        operator+(difference_type n, Iterator it)
+        {
+            return it += n;
+        }
+
+        friend Iterator
+        operator-(Iterator it, difference_type n)
+        {
+            return it -= n;
+        }
+
+        friend difference_type
+        operator-(const Iterator & a, const Iterator & b)
+        {
+            return static_cast<difference_type>(a.idx_) - static_cast<difference_type>(b.idx_);
+        }
+
+        friend bool
+        operator==(const Iterator & a, const Iterator & b)
+        {
+            return a.idx_ == b.idx_;
+        }
+
+        friend auto
+        operator<=>(const Iterator & a, const Iterator & b)
+        {
+            return a.idx_ <=> b.idx_;
+        }
+
+    private:
+        const double * x_ = nullptr;
+        const double * y_ = nullptr;
+        const double * z_ = nullptr;
+        std::size_t idx_ = 0;
+    };
+
+    using value_type = Point;
+    using iterator = Iterator;
+    using const_iterator = Iterator;
+
+    PointsView() = default;
+    PointsView(const double * x, const double * y, const double * z, std::size_t n) :
+        x_(x),
+        y_(y),
+        z_(z),
+        n_(n)
+    {
+    }
+
+    /// Get number of points
+    ///
+    /// @return Number of points
+    [[nodiscard]] std::size_t
+    size() const
+    {
+        return this->n_;
+    }
+
+    /// Check if the view is empty
+    ///
+    /// @return `true` if there are no points
+    [[nodiscard]] bool
+    empty() const
+    {
+        return this->n_ == 0;
+    }
+
+    /// Get a point
+    ///
+    /// @param idx Index of the point
+    /// @return Point
+    [[nodiscard]] Point
+    operator[](std::size_t idx) const
+    {
+        return Point(this->x_[idx], this->y_[idx], this->z_[idx]);
+    }
+
+    [[nodiscard]] Iterator
+    begin() const
+    {
+        return { *this, 0 };
+    }
+
+    [[nodiscard]] Iterator
+    end() const
+    {
+        return { *this, this->n_ };
+    }
+
+    /// Get x-coordinates
+    ///
+    /// @return x-coordinates of all points
+    [[nodiscard]] Span<const double>
+    x() const
+    {
+        return { this->x_, this->n_ };
+    }
+
+    /// Get y-coordinates
+    ///
+    /// @return y-coordinates of all points
+    [[nodiscard]] Span<const double>
+    y() const
+    {
+        return { this->y_, this->n_ };
+    }
+
+    /// Get z-coordinates
+    ///
+    /// @return z-coordinates of all points
+    [[nodiscard]] Span<const double>
+    z() const
+    {
+        return { this->z_, this->n_ };
+    }
+
+private:
+    const double * x_ = nullptr;
+    const double * y_ = nullptr;
+    const double * z_ = nullptr;
+    std::size_t n_ = 0;
+};
+
+/// Point coordinates stored as a structure of arrays (separate x, y and z arrays)
+///
+/// Batch operations (transformation, bounding box, centroid) run over contiguous arrays of
+/// doubles, so they can be vectorized, and the arrays can be handed over to file formats that
+/// store coordinates separately (like ExodusII) without copying.
+class Coordinates {
+public:
+    Coordinates() = default;
+
+    /// Create coordinates from points
+    ///
+    /// @param points Points
+    Coordinates(const std::vector<Point> & points);
+
+    /// Create coordinates from separate arrays
+    ///
+    /// @param x x-coordinates
+    /// @param y y-coordinates
+    /// @param z z-coordinates
+    Coordinates(std::vector<double> x, std::vector<double> y, std::vector<double> z);
+
+    /// Get number of points
+    ///
+    /// @return Number of points
+    [[nodiscard]] std::size_t size() const;
+
+    /// Check if there are no points
+    ///
+    /// @return `true` if empty
+    [[nodiscard]] bool empty() const;
+
+    /// Reserve memory
+    ///
+    /// @param n Number of points
+    void reserve(std::size_t n);
+
+    /// Resize
+    ///
+    /// @param n Number of points
+    void resize(std::size_t n);
+
+    /// Remove all points
+    void clear();
+
+    /// Get a point
+    ///
+    /// @param idx Index of the point
+    /// @return Point
+    [[nodiscard]] Point
+    operator[](std::size_t idx) const
+    {
+        return Point(this->x_[idx], this->y_[idx], this->z_[idx]);
+    }
+
+    /// Get a point with bounds checking
+    ///
+    /// @param idx Index of the point
+    /// @return Point
+    [[nodiscard]] Point at(std::size_t idx) const;
+
+    /// Set a point
+    ///
+    /// @param idx Index of the point
+    /// @param pt New point
+    void
+    set(std::size_t idx, const Point & pt)
+    {
+        this->x_[idx] = pt.x;
+        this->y_[idx] = pt.y;
+        this->z_[idx] = pt.z;
+    }
+
+    /// Append a point
+    ///
+    /// @param pt Point to append
+    void push_back(const Point & pt);
+
+    /// Append points
+    ///
+    /// @param points Points to append
+    void append(PointsView points);
+
+    /// Reorder points
+    ///
+    /// @param new_ids New index for every point (a permutation)
+    void permute(Span<const Index> new_ids);
+
+    /// Get x-coordinates
+    ///
+    /// @return x-coordinates of all points
+    [[nodiscard]] const std::vector<double> & x() const;
+
+    /// Get y-coordinates
+    ///
+    /// @return y-coordinates of all points
+    [[nodiscard]] const std::vector<double> & y() const;
+
+    /// Get z-coordinates
+    ///
+    /// @return z-coordinates of all points
+    [[nodiscard]] const std::vector<double> & z() const;
+
+    /// Get a view of the points
+    ///
+    /// @return View of the points
+    [[nodiscard]] PointsView view() const;
+
+    operator PointsView() const
+    {
+        return this->view();
+    }
+
+    /// Transform all points
+    ///
+    /// @param tr Transformation
+    void transform(const Trsf & tr);
+
+    /// Compute bounding box of all points
+    ///
+    /// @return Bounding box
+    [[nodiscard]] BoundingBox3D bounding_box() const;
+
+    /// Compute centroid of a subset of points
+    ///
+    /// @param ids Indices of the points
+    /// @return Centroid (average) of the points
+    [[nodiscard]] Point centroid(Span<const Index> ids) const;
+
+private:
+    std::vector<double> x_;
+    std::vector<double> y_;
+    std::vector<double> z_;
+};
+
+} // namespace krado
@@ -13,6 +13,53 @@
 
 namespace krado {
 
+/// Read-only view of an element whose vertex IDs are stored elsewhere (e.g. in `Connectivity`)
+class ElementView {
+public:
+    ElementView(ElementType type, Span<const Index> vtx_ids) : elem_type_(type), vtx_ids_(vtx_ids)
+    {
+    }
+
+    /// Get element type
+    ///
+    /// @return Element type
+    [[nodiscard]] ElementType
+    type() const
+    {
+        return this->elem_type_;
+    }
+
+    /// Get number of vertices
+    ///
+    /// @return Number of vertices
+    [[nodiscard]] u8
+    num_vertices() const
+    {
+        return static_cast<u8>(this->vtx_ids_.size());
+    }
+
+    /// Get vertex ID fom local index
+    ///
+    /// @param idx Local vertex index
+    /// @return Vertex ID
+    [[nodiscard]] Index index(u8 idx) const;
+
+    /// Get vertex IDs
+    ///
+    /// @return Vertex IDs
+    [[nodiscard]] Span<const Index>
+    indices() const
+    {
+        return this->vtx_ids_;
+    }
+
+private:
+    /// Element type
+    ElementType elem_type_;
+    /// Vertex IDs
+    Span<const Index> vtx_ids_;
+};
+
 /// Class that represents an element
 class Element {
 private:
@@ -31,6 +78,17 @@ public:
     /// @param vtx_ids Vertex IDs composing the element
     Element(ElementType type, const std::vector<Index> & vtx_ids);
 
+    /// Build an element from a view (vertex IDs are copied)
+    ///
+    /// @param view Element view
+    Element(ElementView view);
+
+    /// Get a view of this element
+    ///
+    /// The view points into this element, so it is not available on temporaries.
+    operator ElementView() const &;
+    operator ElementView() const && = delete;
+
     /// Get element type
     ///
     /// @return Element type
@@ -57,6 +115,11 @@ public:
     /// @param ofst Offset by which we shift the indices
     void shift(Index ofst);
 
+    /// Renumber element indices
+    ///
+    /// @param new_ids New vertex ID for every old vertex ID
+    void remap(Span<const Index> new_ids);
+
 private:
     /// Element type
     ElementType elem_type_ = ElementType::INVALID;
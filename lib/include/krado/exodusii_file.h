@@ -13,11 +13,56 @@ namespace krado {
 
 class ExodusIIFile {
 public:
+    /// Storage format of the file
+    enum class Format {
+        /// NetCDF classic format with 64-bit offsets
+        NETCDF3,
+        /// NetCDF-4 (HDF5-based) format
+        NETCDF4
+    };
+
+    /// Compression of the data stored in the file
+    enum class Compression {
+        /// No compression
+        NONE,
+        /// Deflate (zlib)
+        ZLIB,
+        /// Szip
+        SZIP
+    };
+
+    /// Options used when writing a file
+    ///
+    /// `Format::NETCDF4` (and with it compression and 64-bit integers) is available only if krado
+    /// was built with an exodusIIcpp that can create files with a mode
+    /// (`KRADO_WITH_EXODUSII_NETCDF4`). Otherwise, `write` throws.
+    struct Options {
+        /// Storage format
+        Format format = Format::NETCDF3;
+        /// Compression (needs `Format::NETCDF4`)
+        Compression compression = Compression::NONE;
+        /// Compression level: 1-9 for deflate, pixels per block (even number in 4-32) for szip
+        int compression_level = 1;
+        /// Shuffle bytes before compressing (usually improves the compression ratio)
+        bool shuffle = true;
+        /// Store IDs and connectivity as 64-bit integers (needs `Format::NETCDF4`)
+        ///
+        /// This changes the storage width only. Counts and IDs are still written through the
+        /// 32-bit API, so a mesh can have at most 2^31 - 1 points and elements.
+        bool int64 = false;
+    };
+
     /// ExodusIIFile constructor
     ///
     /// @param file_name Name of the ExodusII file
     explicit ExodusIIFile(const std::filesystem::path & file_name);
 
+    /// ExodusIIFile constructor
+    ///
+    /// @param file_name Name of the ExodusII file
+    /// @param opts Options used when writing the file
+    ExodusIIFile(const std::filesystem::path & file_name, const Options & opts);
+
     /// Read mesh from ExodusII file
     ///
     /// @return Mesh object read from file
@@ -34,8 +79,13 @@ public:
     void write(const GeomModel & model);
 
 private:
+    /// Create the file with the format and compression given by the options
+    void create();
+
     /// File name
     std::string fn_;
+    /// Options used when writing
+    Options opts_;
     /// ExodusII file object
     exodusIIcpp::File exo_;
 };
@@ -5,6 +5,8 @@
 
 #include "krado/geom_shape.h"
 #include "krado/geom_vertex.h"
+#include "krado/point.h"
+#include "krado/vector.h"
 #include "TopoDS_Edge.hxx"
 #include "Geom_Curve.hxx"
 #include "GeomAPI_ProjectPointOnCurve.hxx"
@@ -14,8 +16,6 @@ namespace krado {
 
 class GeomModel;
 class GeomSurface;
-class Point;
-class Vector;
 
 class GeomCurve : public GeomShape {
 public:
@@ -60,6 +60,26 @@ public:
     /// @return Curvature at location `u`
     [[nodiscard]] double curvature(double u) const;
 
+    /// Get physical locations for several parametrical positions
+    ///
+    /// Lines and circles are evaluated directly, without going through OpenCASCADE.
+    ///
+    /// @param u Parameters specifying locations
+    /// @param pts Locations in 3D space (same size as `u`)
+    void point(Span<const double> u, Span<Point> pts) const;
+
+    /// Compute first derivatives at several parametrical positions
+    ///
+    /// @param u Parameters specifying locations
+    /// @param ders First derivatives (same size as `u`)
+    void d1(Span<const double> u, Span<Vector> ders) const;
+
+    /// Get curvature at several parametrical positions
+    ///
+    /// @param u Parameters specifying locations
+    /// @param curv Curvatures (same size as `u`)
+    void curvature(Span<const double> u, Span<double> curv) const;
+
     /// Get range of the parameter
     ///
     /// @return Range as a tuple [lower, upper]
@@ -115,6 +135,14 @@ private:
     double umax_;
     /// Mesh size for the edge.
     Optional<double> mesh_size_;
+    /// Location of a line or center of a circle
+    Point origin_;
+    /// Direction of a line or x-axis of a circle
+    Vector x_dir_;
+    /// y-axis of a circle
+    Vector y_dir_;
+    /// Radius of a circle
+    double radius_;
 
     friend class MeshCurve;
     friend Point get_circle_center(const GeomCurve & crv);
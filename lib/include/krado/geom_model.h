@@ -11,7 +11,9 @@
 #include "krado/geom_surface.h"
 #include "krado/geom_volume.h"
 #include "TopTools_DataMapOfShapeInteger.hxx"
+#include <filesystem>
 #include <map>
+#include <memory>
 
 class TopoDS_Vertex;
 class TopoDS_Edge;
@@ -27,6 +29,7 @@ class MeshCurve;
 class MeshSurface;
 class MeshVolume;
 class BoundingBox3D;
+class MeshCache;
 
 class GeomModel {
 public:
@@ -109,6 +112,26 @@ public:
     void mesh_volume(ShapeID id);
     void mesh_volume(Ptr<MeshVolume> volume);
 
+    /// Mesh all curves, surfaces and volumes that have a meshing scheme
+    ///
+    /// Curves are meshed first, then surfaces and then volumes. With `parallel`, independent
+    /// entities are meshed concurrently: a surface is meshed as soon as its curves are meshed and
+    /// a volume as soon as its surfaces are meshed. Volumes sharing a surface or a curve (and
+    /// surfaces sharing a curve, if their scheme is not thread-safe) are meshed in the order of
+    /// their IDs, so the result does not depend on the number of threads.
+    ///
+    /// @param parallel Mesh independent entities concurrently
+    void mesh_all(bool parallel = true);
+
+    /// Cache curve and surface meshes on disk
+    ///
+    /// Curves and surfaces with a cached mesh are restored from the cache instead of being meshed
+    /// by their scheme. Newly meshed curves and surfaces are stored in the cache. See `MeshCache`
+    /// for details.
+    ///
+    /// @param dir Directory with cached meshes
+    void set_mesh_cache(const std::filesystem::path & dir);
+
     /// Set block name
     ///
     /// @param marker Block marker
@@ -204,6 +227,9 @@ private:
     std::map<Marker, std::string> block_names_;
     std::map<Marker, std::string> side_set_names_;
     std::map<Marker, std::string> node_set_names_;
+
+    /// Cache of curve and surface meshes (if enabled)
+    std::unique_ptr<MeshCache> mesh_cache_;
 };
 
 /// Compute bounding box of a meshed geometrical model
@@ -5,9 +5,12 @@
 
 #include "krado/geom_shape.h"
 #include "krado/geom_curve.h"
+#include "krado/point.h"
+#include "krado/vector.h"
 #include "TopoDS_Face.hxx"
 #include "Geom_Surface.hxx"
-#include "GeomAPI_ProjectPointOnSurf.hxx"
+#include <memory>
+#include <mutex>
 #include <vector>
 
 namespace krado {
@@ -15,14 +18,13 @@ namespace krado {
 class GeomModel;
 class Wire;
 class UVParam;
-class Point;
-class Vector;
 
 class GeomSurface : public GeomShape {
 public:
     explicit GeomSurface(const TopoDS_Face & face);
     GeomSurface(const GeomSurface & other);
     GeomSurface(GeomSurface && other);
+    ~GeomSurface() override;
 
     int dim() const final;
 
@@ -47,6 +49,20 @@ public:
     /// @return First derivative
     [[nodiscard]] std::tuple<Vector, Vector> d1(UVParam param) const;
 
+    /// Get physical locations for several parametrical positions
+    ///
+    /// Planes are evaluated directly, without going through OpenCASCADE.
+    ///
+    /// @param uv Parameters specifying locations
+    /// @param pts Locations in 3D space (same size as `uv`)
+    void point(Span<const UVParam> uv, Span<Point> pts) const;
+
+    /// Get normal vectors at several parametrical locations
+    ///
+    /// @param uv Parameters specifying locations
+    /// @param normals Normal vectors (same size as `uv`)
+    void normal(Span<const UVParam> uv, Span<Vector> normals) const;
+
     /// Get range of the parameter
     ///
     /// @return Range as a tuple [lower, upper]
@@ -63,6 +79,35 @@ public:
     /// @return Parameters (u, v)
     [[nodiscard]] UVParam parameter_from_point(Point pt) const;
 
+    /// Get parameter on the surface from a physical location, starting from an initial guess
+    ///
+    /// The search starts at `guess` and falls back to a global search, if it fails. This is much
+    /// faster when the guess is close, like when moving a mesh vertex.
+    ///
+    /// @param pt Physical location
+    /// @param guess Initial guess of the parameters
+    /// @return Parameters (u, v)
+    [[nodiscard]] UVParam parameter_from_point(Point pt, UVParam guess) const;
+
+    /// Get parameters on the surface for several physical locations
+    ///
+    /// Points are projected concurrently.
+    ///
+    /// @param pts Physical locations
+    /// @param uv Parameters (u, v), same size as `pts`
+    void parameter_from_point(Span<const Point> pts, Span<UVParam> uv) const;
+
+    /// Get parameters on the surface for several physical locations, starting from initial guesses
+    ///
+    /// Points are projected concurrently.
+    ///
+    /// @param pts Physical locations
+    /// @param guess Initial guesses of the parameters, same size as `pts`
+    /// @param uv Parameters (u, v), same size as `pts`
+    void parameter_from_point(Span<const Point> pts,
+                              Span<const UVParam> guess,
+                              Span<UVParam> uv) const;
+
     /// Find nearest point
     ///
     /// @param pt Physical point
@@ -87,16 +132,36 @@ public:
     operator const TopoDS_Face &() const;
 
 private:
-    std::tuple<bool, UVParam> project(Point pt) const;
+    struct Projector;
+
+    /// Call `fn(proj)` with a projector that no other thread uses at the same time
+    ///
+    /// @param fn Function to call
+    /// @return Value returned by `fn`
+    template <typename FN>
+    auto with_projector(FN && fn) const;
+
+    std::tuple<bool, UVParam> project(Projector & proj, Point pt) const;
+    std::tuple<bool, UVParam> project(Projector & proj, Point pt, UVParam guess) const;
 
     Handle(Geom_Surface) surface_;
     double umin_, umax_;
     double vmin_, vmax_;
     /// Mesh size for the edge.
     Optional<double> mesh_size_;
-
-    /// Needs to be a pointer, because GeomSurface must be movable
-    mutable GeomAPI_ProjectPointOnSurf proj_pt_on_surface_;
+    /// `true` if the surface is a plane
+    bool is_plane_;
+    /// Location of a plane
+    Point origin_;
+    /// x-axis of a plane
+    Vector x_dir_;
+    /// y-axis of a plane
+    Vector y_dir_;
+
+    /// Idle projectors. Setting up a projector is expensive, so they are reused, but every thread
+    /// projecting points needs its own.
+    mutable std::vector<std::unique_ptr<Projector>> projectors_;
+    mutable std::mutex projectors_mutex_;
 
 public:
     static GeomSurface create(const Wire & wire);
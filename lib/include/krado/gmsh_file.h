@@ -0,0 +1,57 @@
+// SPDX-FileCopyrightText: 2026 David Andrs <andrsd@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "krado/mesh.h"
+#include <filesystem>
+#include <string>
+
+namespace krado {
+
+/// Gmsh MSH 4.1 file (binary or ASCII)
+///
+/// Physical groups of the highest-dimensional elements become cell sets and physical groups of
+/// elements one dimension lower become side sets (their elements are matched to element sides).
+/// Physical names become set names. Other elements are skipped when reading.
+///
+/// When writing, cells are grouped into entities by the cell sets they belong to. Every entity gets
+/// the physical groups of all its cell sets, so overlapping cell sets are kept. Every side set is
+/// written as an entity of lower-dimensional elements. Node sets are not written.
+class GmshFile {
+public:
+    /// Options used when writing a file
+    struct Options {
+        /// Write binary file (ASCII otherwise)
+        bool binary = true;
+    };
+
+    /// GmshFile constructor
+    ///
+    /// @param file_name Name of the file
+    explicit GmshFile(const std::filesystem::path & file_name);
+
+    /// GmshFile constructor
+    ///
+    /// @param file_name Name of the file
+    /// @param opts Options used when writing the file
+    GmshFile(const std::filesystem::path & file_name, const Options & opts);
+
+    /// Read mesh from the file
+    ///
+    /// @return Mesh object read from file
+    [[nodiscard]] Ptr<Mesh> read();
+
+    /// Write mesh into the file
+    ///
+    /// @param mesh Mesh object to write
+    void write(Ptr<const Mesh> mesh);
+
+private:
+    /// File name
+    std::string fn_;
+    /// Options used when writing
+    Options opts_;
+};
+
+} // namespace krado
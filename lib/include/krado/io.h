@@ -5,6 +5,7 @@
 
 #include "krado/mesh.h"
 #include "krado/geom_shape.h"
+#include "krado/exodusii_file.h"
 #include <vector>
 #include <filesystem>
 
@@ -14,12 +15,30 @@ class IO {
 public:
     /// Write mesh into a file
     ///
+    /// The format is given by the extension: `.kmesh` (krado mesh snapshot), `.msh` (Gmsh MSH 4.1),
+    /// anything else is ExodusII
+    ///
     /// @param file_name Name of the file
     /// @param mesh Mesh to write
     static void export_mesh(Ptr<const Mesh> mesh, const std::filesystem::path & file_name);
 
+    /// Write mesh into an ExodusII file
+    ///
+    /// Throws for `.kmesh` and `.msh` file names, so that ExodusII data are never written under
+    /// the extension of another format.
+    ///
+    /// @param mesh Mesh to write
+    /// @param file_name Name of the file
+    /// @param opts Storage format, compression and integer size of the file
+    static void export_mesh(Ptr<const Mesh> mesh,
+                            const std::filesystem::path & file_name,
+                            const ExodusIIFile::Options & opts);
+
     /// Read mesh from a file
     ///
+    /// The format is given by the extension: `.kmesh` (krado mesh snapshot), `.msh` (Gmsh MSH 4.1),
+    /// anything else is ExodusII
+    ///
     /// @param file_name Name of the file
     /// @return Mesh read from the file
     [[nodiscard]] static Ptr<Mesh> import_mesh(const std::filesystem::path & file_name);
@@ -0,0 +1,46 @@
+// SPDX-FileCopyrightText: 2026 David Andrs <andrsd@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "krado/mesh.h"
+#include <filesystem>
+#include <string>
+
+namespace krado {
+
+/// Native binary mesh snapshot (`.kmesh`)
+///
+/// The file starts with a versioned header followed by a table of sections. Every section is a
+/// plain array (point coordinates, element types, offsets and vertex IDs, cell/side/node sets,
+/// set names and, if the mesh was set up, the Hasse diagram) that starts at a 64-byte boundary.
+///
+/// Reading maps the file into memory and copies the sections straight into the mesh containers,
+/// nothing is parsed or rebuilt. A stored Hasse diagram is restored as well, so `Mesh::set_up`
+/// does not need to be called again.
+///
+/// Files are stored in the byte order of the machine that wrote them and can be read on machines
+/// with the same byte order only.
+class KMeshFile {
+public:
+    /// KMeshFile constructor
+    ///
+    /// @param file_name Name of the file
+    explicit KMeshFile(const std::filesystem::path & file_name);
+
+    /// Read mesh from the file
+    ///
+    /// @return Mesh object read from file
+    [[nodiscard]] Ptr<Mesh> read();
+
+    /// Write mesh into the file
+    ///
+    /// @param mesh Mesh object to write
+    void write(Ptr<const Mesh> mesh);
+
+private:
+    /// File name
+    std::string fn_;
+};
+
+} // namespace krado
@@ -4,12 +4,15 @@
 #pragma once
 
 #include "krado/bounding_box_3d.h"
+#include "krado/connectivity.h"
+#include "krado/coordinates.h"
 #include "krado/element.h"
 #include "krado/point.h"
 #include "krado/transform.h"
 #include "krado/hasse_diagram.h"
 #include "krado/ptr.h"
 #include "krado/types.h"
+#include <array>
 #include <map>
 #include <vector>
 #include <set>
@@ -17,6 +20,7 @@
 namespace krado {
 
 class GeomModel;
+class MeshVertexAbstract;
 
 /// Class representing a mesh
 ///
@@ -40,6 +44,12 @@ public:
     /// @param elements Elements
     Mesh(std::vector<Point> points, std::vector<Element> elements);
 
+    /// Construct mesh from coordinates and connectivity
+    ///
+    /// @param coords Point coordinates
+    /// @param connect Element connectivity
+    Mesh(Coordinates coords, Connectivity connect);
+
     Mesh(const Mesh & mesh) = delete;
     Mesh & operator=(const Mesh & mesh) = delete;
 
@@ -56,24 +66,34 @@ public:
     /// Get mesh points
     ///
     /// @return Mesh points
-    [[nodiscard]] Span<const Point> points() const;
+    [[nodiscard]] PointsView points() const;
 
     /// Get a point by index
     ///
     /// @param idx Index of the point
     /// @return Point
-    [[nodiscard]] const Point & point(Index idx) const;
+    [[nodiscard]] Point point(Index idx) const;
+
+    /// Get point coordinates (x, y and z stored in separate arrays)
+    ///
+    /// @return Point coordinates
+    [[nodiscard]] const Coordinates & coordinates() const;
 
     /// Get elements
     ///
     /// @return Mesh elements
-    [[nodiscard]] Span<const Element> elements() const;
+    [[nodiscard]] ElementsView elements() const;
 
     /// Get element of the mesh
     ///
     /// @param idx Index of the element
     /// @return Element
-    [[nodiscard]] const Element & element(Index idx) const;
+    [[nodiscard]] ElementView element(Index idx) const;
+
+    /// Get element connectivity (vertex IDs of all elements stored in one array)
+    ///
+    /// @return Element connectivity
+    [[nodiscard]] const Connectivity & connectivity() const;
 
     /// Scale mesh by a factor (isotropic)
     ///
@@ -139,6 +159,8 @@ public:
 
     /// Add another mesh to this mesh
     ///
+    /// To assemble a mesh from many parts, use `MeshBuilder`
+    ///
     /// @param other Mesh to add
     /// @return Reference to this mesh
     Mesh & add(const Mesh & other);
@@ -149,6 +171,16 @@ public:
     /// @return Reference to this mesh
     Mesh & remove_duplicate_points(double tolerance = 1e-12);
 
+    /// Renumber points and elements
+    ///
+    /// Element connectivity, cell sets, side sets and node sets are updated accordingly. Sets are
+    /// kept sorted by the new IDs. The Hasse diagram is discarded, call `set_up` to rebuild it.
+    ///
+    /// @param node_ids New index for every point (a permutation)
+    /// @param elem_ids New index for every element (a permutation)
+    /// @return Reference to this mesh
+    Mesh & renumber(Span<const Index> node_ids, Span<const Index> elem_ids);
+
     /// Duplicate mesh
     ///
     /// @return Duplicated mesh
@@ -182,6 +214,7 @@ public:
     /// @param cell_ids Cell IDs
     /// @return Reference to this mesh
     Mesh & set_cell_set(Marker id, const std::vector<Index> & cell_ids);
+    Mesh & set_cell_set(Marker id, std::vector<Index> && cell_ids);
 
     /// Remove cell sets
     ///
@@ -216,6 +249,7 @@ public:
     /// @param side_set Side set
     /// @return Reference to this mesh
     Mesh & set_side_set(Marker id, const std::vector<SideEntry> & side_set);
+    Mesh & set_side_set(Marker id, std::vector<SideEntry> && side_set);
 
     /// Remove side sets
     ///
@@ -252,6 +286,7 @@ public:
     /// @param node_ids Node IDs
     /// @return Reference to this mesh
     Mesh & set_node_set(Marker id, const std::vector<Index> & node_ids);
+    Mesh & set_node_set(Marker id, std::vector<Index> && node_ids);
 
     /// Remove node sets
     ///
@@ -287,7 +322,16 @@ public:
     [[nodiscard]] ElementType element_type(Index index) const;
 
     /// Prepare mesh
-    void set_up();
+    ///
+    /// @param relations Relations of the Hasse diagram to build. `support` needs
+    ///        `HasseDiagram::UPWARD`, `cone` needs `HasseDiagram::DOWNWARD`.
+    void set_up(Flags<HasseDiagram::Relation> relations = HasseDiagram::DOWNWARD |
+                                                          HasseDiagram::UPWARD);
+
+    /// Get the Hasse diagram built by `set_up`
+    ///
+    /// @return Hasse diagram
+    [[nodiscard]] const HasseDiagram & hasse_diagram() const;
 
     /// Get all boundary edge IDs
     ///
@@ -319,9 +363,9 @@ public:
 
 private:
     /// Mesh points
-    std::vector<Point> pnts_;
+    Coordinates pnts_;
     /// All mesh elements. Point, edge, face, and cell IDs are indexing into this container.
-    std::vector<Element> elems_;
+    Connectivity elems_;
     /// Cell set names
     std::map<Marker, std::string> cell_set_names_;
     /// Cell sets
@@ -336,6 +380,9 @@ private:
     std::map<Marker, std::vector<Index>> node_sets_;
     ///
     HasseDiagram hasse_;
+
+    friend class MeshBuilder;
+    friend class KMeshFile;
 };
 
 /// Create side set from Hasse indices
@@ -346,12 +393,106 @@ private:
 std::vector<SideEntry> create_side_set(const Mesh & mesh, const std::vector<HasseIndex> & idxs);
 std::vector<SideEntry> create_side_set(Ptr<const Mesh> mesh, const std::vector<HasseIndex> & idxs);
 
+/// Find element sides on the mesh boundary
+///
+/// Facets (faces in 3D, edges in 2D and vertices in 1D) are matched directly from the element
+/// connectivity, i.e. this does not need `Mesh::set_up`.
+///
+/// @param mesh Mesh
+/// @return Boundary sides ordered by element and local side number (ready for `set_side_set`)
+std::vector<SideEntry> boundary_sides(const Mesh & mesh);
+std::vector<SideEntry> boundary_sides(Ptr<const Mesh> mesh);
+
+/// Get the number of sides (facets) of an element type
+///
+/// @param type Element type
+/// @return Number of sides, 0 for types without sides
+u8 facet_count(ElementType type);
+
+/// Get the vertices of an element side (facet)
+///
+/// @param elem Element
+/// @param side Local side number
+/// @param vtx [out] Vertices of the side
+/// @return Number of vertices of the side
+std::size_t facet_vertices(ElementView elem, u8 side, std::array<Index, 4> & vtx);
+
+/// Find element sides given by their vertices
+///
+/// @param mesh Mesh
+/// @param facets Facets (faces in 3D, edges in 2D and vertices in 1D), the order of their vertices
+///        does not matter
+/// @return Side of the lowest-numbered element that has the facet, or nothing if no element has it
+std::vector<Optional<SideEntry>> match_sides(const Mesh & mesh, ElementsView facets);
+
+/// Find mesh points on the boundary
+///
+/// @param mesh Mesh
+/// @return Sorted indices of points that lie on boundary sides (see `boundary_sides`)
+std::vector<Index> boundary_nodes(const Mesh & mesh);
+
+/// Find coincident points
+///
+/// Points are processed in the order of their indices: a point that is not closer than
+/// `tolerance` to any of the previously kept points is kept, otherwise it coincides with the first
+/// such point. The result does not depend on the number of threads.
+///
+/// @param points Points
+/// @param tolerance Points closer than (or exactly at) this distance coincide
+/// @return Index of the kept point for each point (kept points map onto themselves)
+std::vector<Index> find_coincident_points(PointsView points, double tolerance);
+
+/// Compute bandwidth of the node graph (two nodes are connected if they share an element)
+///
+/// @param mesh Mesh
+/// @return Largest difference between IDs of two nodes of the same element
+std::size_t node_bandwidth(const Mesh & mesh);
+
+/// Reorder mesh nodes and elements to improve memory locality
+///
+/// - `Ordering::RCM` numbers nodes with the reverse Cuthill-McKee algorithm (minimizing the
+///   bandwidth) and sorts elements by their lowest node ID.
+/// - `Ordering::HILBERT` and `Ordering::MORTON` sort elements along a space filling curve through
+///   their centroids and number nodes in the order they are first used by the elements.
+///
+/// @param mesh Mesh to reorder
+/// @param ordering Ordering to use
+/// @return Reference to the mesh
+Mesh & reorder(Mesh & mesh, Ordering ordering);
+
 /// Compute bounding box around the mesh
 ///
 /// @return Bounding box
 BoundingBox3D compute_bounding_box(const Mesh & mesh);
 BoundingBox3D compute_bounding_box(Ptr<const Mesh> mesh);
 
+/// Consecutive numbering of the mesh vertices of a geometric model (see `number_vertices`)
+struct VertexNumbering {
+    /// Number of numbered vertices
+    Index n_vertices;
+    /// Numbering pass. Every numbered vertex remembers it, so numbers from another pass (or
+    /// vertices that are not part of the model) are detected.
+    u32 pass;
+
+    /// Get the index of a vertex into the mesh points
+    ///
+    /// @param vtx Mesh vertex
+    /// @return Index of the vertex
+    /// @throws Exception if the vertex was not numbered by this pass
+    [[nodiscard]] Index index(const MeshVertexAbstract & vtx) const;
+};
+
+/// Number all mesh vertices of a geometric model consecutively
+///
+/// Model vertices are numbered first, then vertices on curves and then vertices on surfaces (in
+/// the order of their IDs). The number is stored on the vertices (see `MeshVertexAbstract::num`),
+/// so mesh builders and exporters can look it up in constant time. Numbers assigned by a
+/// previous call (or at vertex creation) are overwritten.
+///
+/// @param model Geometric model
+/// @return Numbering, use `VertexNumbering::index` to get the vertex numbers
+VertexNumbering number_vertices(const GeomModel & model);
+
 /// Build mesh from geometric model
 ///
 /// @param model
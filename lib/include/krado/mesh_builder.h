@@ -0,0 +1,138 @@
+// SPDX-FileCopyrightText: 2026 David Andrs <andrsd@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "krado/connectivity.h"
+#include "krado/coordinates.h"
+#include "krado/element.h"
+#include "krado/point.h"
+#include "krado/ptr.h"
+#include "krado/types.h"
+#include <map>
+#include <string>
+#include <vector>
+
+namespace krado {
+
+class Mesh;
+
+/// Class for assembling a mesh from many parts
+///
+/// Points, elements and sets are appended into growing buffers (amortized O(1) per entry).
+/// Vertex indices of added elements are shifted while they are copied, and the buffers are moved
+/// into the resulting mesh, i.e. nothing is copied more than once.
+/// Use this instead of calling `Mesh::add` in a loop.
+///
+/// Example:
+/// ```
+/// MeshBuilder builder;
+/// for (auto & pin : pins)
+///     builder.add(pin);
+/// auto mesh = builder.build();
+/// ```
+class MeshBuilder {
+public:
+    MeshBuilder() = default;
+
+    /// Reserve memory
+    ///
+    /// @param n_points Expected number of points
+    /// @param n_elements Expected number of elements
+    /// @param n_indices Expected number of element vertex indices (defaults to 4 per element)
+    void reserve(std::size_t n_points, std::size_t n_elements, std::size_t n_indices = 0);
+
+    /// Get number of points added so far
+    ///
+    /// @return Number of points
+    [[nodiscard]] std::size_t num_points() const;
+
+    /// Get number of elements added so far
+    ///
+    /// @return Number of elements
+    [[nodiscard]] std::size_t num_elements() const;
+
+    /// Add a mesh
+    ///
+    /// Points, elements, cell sets, side sets and node sets of `mesh` are appended
+    ///
+    /// @param mesh Mesh to add
+    /// @return Reference to this builder
+    MeshBuilder & add(const Mesh & mesh);
+    MeshBuilder & add(Ptr<const Mesh> mesh);
+
+    /// Add a point
+    ///
+    /// @param pt Point to add
+    /// @return Index of the point
+    Index add_point(const Point & pt);
+
+    /// Add an element
+    ///
+    /// @param elem Element to add (vertex indices refer to points of this builder)
+    /// @return Index of the element
+    Index add_element(const Element & elem);
+
+    /// Add an element into a cell set
+    ///
+    /// @param id Cell set ID
+    /// @param elem Index of the element
+    void add_to_cell_set(Marker id, Index elem);
+
+    /// Add an element side into a side set
+    ///
+    /// @param id Side set ID
+    /// @param side Element side
+    void add_to_side_set(Marker id, SideEntry side);
+
+    /// Add a point into a node set
+    ///
+    /// @param id Node set ID
+    /// @param node Index of the point
+    void add_to_node_set(Marker id, Index node);
+
+    /// Set cell set name
+    ///
+    /// @param id Cell set ID
+    /// @param name Cell set name
+    void set_cell_set_name(Marker id, const std::string & name);
+
+    /// Set side set name
+    ///
+    /// @param id Side set ID
+    /// @param name Side set name
+    void set_side_set_name(Marker id, const std::string & name);
+
+    /// Set node set name
+    ///
+    /// @param id Node set ID
+    /// @param name Node set name
+    void set_node_set_name(Marker id, const std::string & name);
+
+    /// Build the mesh
+    ///
+    /// The builder is empty afterwards and can be reused
+    ///
+    /// @return Assembled mesh
+    [[nodiscard]] Ptr<Mesh> build();
+
+private:
+    /// Points
+    Coordinates pnts_;
+    /// Elements
+    Connectivity elems_;
+    /// Cell set names
+    std::map<Marker, std::string> cell_set_names_;
+    /// Cell sets
+    std::map<Marker, std::vector<Index>> cell_sets_;
+    /// Side set names
+    std::map<Marker, std::string> side_set_names_;
+    /// Side sets
+    std::map<Marker, std::vector<SideEntry>> side_sets_;
+    /// Node set names
+    std::map<Marker, std::string> node_set_names_;
+    /// Node sets
+    std::map<Marker, std::vector<Index>> node_sets_;
+};
+
+} // namespace krado
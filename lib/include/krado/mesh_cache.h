@@ -0,0 +1,94 @@
+// SPDX-FileCopyrightText: 2026 David Andrs <andrsd@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "krado/ptr.h"
+#include <filesystem>
+#include <string>
+
+namespace krado {
+
+class Scheme;
+class MeshCurve;
+class MeshSurface;
+
+/// On-disk cache of curve and surface meshes
+///
+/// Every cached mesh is stored in its own file named after a fingerprint of the geometry (entity
+/// type, orientation, parameter range, tolerance and points sampled over the parameter space), the
+/// scheme name and its parameters. Surface fingerprints also include the meshes of their curves,
+/// so a surface mesh is reused only if it connects to the same curve vertices. Fingerprints do not
+/// depend on shape IDs, so a mesh is found even if the model was loaded from a different file.
+///
+/// Curves store vertex parameters and segments, surfaces store vertex (u, v) parameters and
+/// elements. Physical coordinates are recomputed from the geometry when a mesh is restored.
+///
+/// Loading and storing different entities concurrently is safe.
+class MeshCache {
+public:
+    /// Create a cache
+    ///
+    /// @param dir Directory with cached meshes (created if it does not exist)
+    explicit MeshCache(const std::filesystem::path & dir);
+
+    /// Get directory with cached meshes
+    ///
+    /// @return Directory with cached meshes
+    [[nodiscard]] const std::filesystem::path & directory() const;
+
+    /// Restore curve mesh from the cache
+    ///
+    /// @param curve Curve without mesh
+    /// @param scheme Scheme that would mesh the curve
+    /// @return `true` if the mesh was restored, `false` if there is no cached mesh
+    bool load(Ptr<MeshCurve> curve, Scheme & scheme) const;
+
+    /// Restore surface mesh from the cache
+    ///
+    /// Curves of the surface must be meshed.
+    ///
+    /// @param surface Surface without mesh
+    /// @param scheme Scheme that would mesh the surface
+    /// @return `true` if the mesh was restored, `false` if there is no cached mesh
+    bool load(Ptr<MeshSurface> surface, Scheme & scheme) const;
+
+    /// Store curve mesh in the cache
+    ///
+    /// @param curve Meshed curve
+    /// @param scheme Scheme that meshed the curve
+    void store(Ptr<MeshCurve> curve, Scheme & scheme) const;
+
+    /// Store surface mesh in the cache
+    ///
+    /// Meshes with vertices that do not belong to the surface or its curves are not stored.
+    ///
+    /// @param surface Meshed surface
+    /// @param scheme Scheme that meshed the surface
+    void store(Ptr<MeshSurface> surface, Scheme & scheme) const;
+
+    /// Compute fingerprint of a curve mesh
+    ///
+    /// @param curve Curve
+    /// @param scheme Scheme meshing the curve
+    /// @return Fingerprint
+    [[nodiscard]] static std::string fingerprint(Ptr<MeshCurve> curve, Scheme & scheme);
+
+    /// Compute fingerprint of a surface mesh
+    ///
+    /// @param surface Surface (with meshed curves)
+    /// @param scheme Scheme meshing the surface
+    /// @return Fingerprint
+    [[nodiscard]] static std::string fingerprint(Ptr<MeshSurface> surface, Scheme & scheme);
+
+private:
+    /// Get file name of a cached mesh
+    ///
+    /// @param key Fingerprint of the mesh
+    /// @return Path to the file
+    [[nodiscard]] std::filesystem::path file_name(const std::string & key) const;
+
+    std::filesystem::path dir_;
+};
+
+} // namespace krado
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include "krado/arena.h"
 #include "krado/mesh_element.h"
 #include "krado/meshable.h"
 #include "krado/scheme.h"
@@ -42,6 +43,22 @@ public:
     /// @param vertex Curve vertex to add
     void add_vertex(Ptr<MeshCurveVertex> vertex);
 
+    /// Create a curve vertex and add it
+    ///
+    /// The vertex is allocated from a pool owned by this curve, which is much cheaper than
+    /// allocating vertices one by one.
+    ///
+    /// @param u Parameter on the curve
+    /// @return The new vertex
+    Ptr<MeshCurveVertex> add_vertex(double u);
+
+    /// Create curve vertices and add them
+    ///
+    /// Physical locations of all vertices are evaluated in one batch.
+    ///
+    /// @param u Parameters on the curve
+    void add_vertices(Span<const double> u);
+
     /// Get (internal) vertices on the curve
     ///
     /// @return Vertices on the curve
@@ -99,6 +116,8 @@ private:
     std::vector<Ptr<MeshVertex>> bnd_vtxs_;
     /// Vertices on the curve (excluding the bounding vertices)
     std::vector<Ptr<MeshCurveVertex>> curve_vtx_;
+    /// Memory for curve vertices
+    Arena<MeshCurveVertex> vtx_arena_;
     /// Segments of this curve, using vertex indexing local to this edge
     std::vector<MeshElement> segs_;
     ///
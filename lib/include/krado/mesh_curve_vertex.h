@@ -18,6 +18,13 @@ public:
     /// @param u Parameter on the curve
     MeshCurveVertex(const GeomCurve & geom_curve, double u);
 
+    /// Construct vertex on a curve with already evaluated physical location
+    ///
+    /// @param geom_curve Geometrical curve
+    /// @param u Parameter on the curve
+    /// @param pt Physical location corresponding to `u`
+    MeshCurveVertex(const GeomCurve & geom_curve, double u, const Point & pt);
+
     /// Get geometrical curve this vertex is connected to
     ///
     /// @return Geometrical curve this vertex is connected to
@@ -7,6 +7,7 @@
 #include "krado/ptr.h"
 #include <vector>
 #include <array>
+#include <initializer_list>
 #include <iostream>
 
 namespace krado {
@@ -15,13 +16,24 @@ class MeshVertexAbstract;
 class Point;
 
 /// Mesh element (generated by a mesh generator, i.e. not read from a mesh file)
+///
+/// Vertices are stored inline, so building an element does not allocate.
 class MeshElement {
 public:
+    /// Maximum number of vertices of an element
+    static constexpr int MAX_VERTICES = 4;
+
     /// Build an element
     ///
     /// @param type Element type
     /// @param vtx Vertices composing the element
     MeshElement(ElementType type, const std::vector<Ptr<MeshVertexAbstract>> & vtx);
+
+    /// Build an element
+    ///
+    /// @param type Element type
+    /// @param vtx Vertices composing the element
+    MeshElement(ElementType type, std::initializer_list<Ptr<MeshVertexAbstract>> vtx);
     ~MeshElement();
 
     /// Get element type
@@ -53,8 +65,12 @@ public:
     void swap_vertices(int idx1, int idx2);
 
 private:
+    void set_vertices(Span<const Ptr<MeshVertexAbstract>> vtx);
+
     ElementType type_;
-    std::vector<Ptr<MeshVertexAbstract>> vtx_;
+    /// Number of vertices
+    u8 n_vtx_;
+    std::array<Ptr<MeshVertexAbstract>, MAX_VERTICES> vtx_;
 
 public:
     static MeshElement Line2(const std::array<Ptr<MeshVertexAbstract>, 2> & vtx);
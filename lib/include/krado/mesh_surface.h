@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include "krado/arena.h"
 #include "krado/mesh_element.h"
 #include "krado/meshable.h"
 #include "krado/scheme.h"
@@ -76,6 +77,22 @@ public:
     /// @param vertex Vertex to add
     void add_vertex(Ptr<MeshSurfaceVertex> vertex);
 
+    /// Create a surface vertex and add it
+    ///
+    /// The vertex is allocated from a pool owned by this surface, which is much cheaper than
+    /// allocating vertices one by one.
+    ///
+    /// @param uv Parametric coordinates on the surface
+    /// @return The new vertex
+    Ptr<MeshSurfaceVertex> add_vertex(const UVParam & uv);
+
+    /// Create surface vertices and add them
+    ///
+    /// Physical locations of all vertices are evaluated in one batch.
+    ///
+    /// @param uv Parametric coordinates on the surface
+    void add_vertices(Span<const UVParam> uv);
+
     /// Add new triangle
     ///
     /// @param tri Local vertex indices
@@ -132,6 +149,8 @@ private:
     std::vector<Ptr<MeshCurve>> mesh_curves_;
     /// Surface vertices (not including boundary and mesh vertices)
     std::vector<Ptr<MeshSurfaceVertex>> surf_vtxs_;
+    /// Memory for surface vertices
+    Arena<MeshSurfaceVertex> vtx_arena_;
     /// Triangles
     std::vector<MeshElement> tris_;
     /// Quadrangles
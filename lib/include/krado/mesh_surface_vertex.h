@@ -23,6 +23,13 @@ public:
 
     MeshSurfaceVertex(const GeomSurface & geom_surface, UVParam uv);
 
+    /// Construct vertex on a surface with already evaluated physical location
+    ///
+    /// @param geom_surface Geometrical surface
+    /// @param uv Parameters on the surface
+    /// @param pt Physical location corresponding to `uv`
+    MeshSurfaceVertex(const GeomSurface & geom_surface, UVParam uv, const Point & pt);
+
     /// Get geometrical curve this vertex is connected to
     ///
     /// @return Geometrical curve this vertex is connected to
@@ -33,6 +40,11 @@ public:
     /// @return Parametrical position of the vertex on the curve
     [[nodiscard]] UVParam parameter() const;
 
+    /// Move the vertex to a parametrical position
+    ///
+    /// @param uv Parametrical position on the surface
+    void set_parameter(UVParam uv);
+
     /// Get physical position in the 3D space
     ///
     /// @return Physical position in the 3D space
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include "krado/types.h"
+
 namespace krado {
 
 class GeomShape;
@@ -29,18 +31,38 @@ public:
     /// @return Geometrical shape associated with this vertex
     [[nodiscard]] const GeomShape & geom_shape() const;
 
-    /// Get vertex number (this is globally unique number)
+    /// Get vertex number
+    ///
+    /// Vertices get a unique number when created. `number_vertices` renumbers all vertices of a
+    /// model consecutively, so the number can be used as an index into the mesh points.
     ///
-    /// This is/can be used by meshing algorithms that require vertex numbering
+    /// The number is overwritten every time the vertices are renumbered and there is no
+    /// notification about it. A number read before renumbering is stale afterwards, so it must
+    /// not be cached across calls to `number_vertices`.
+    ///
+    /// @return Vertex number
+    [[nodiscard]] Index num() const;
+
+    /// Set vertex number
+    ///
+    /// The previous number is overwritten, see `num`.
+    ///
+    /// @param num New vertex number
+    /// @param pass Numbering pass assigning the number (see `VertexNumbering`)
+    void set_num(Index num, u32 pass = 0);
+
+    /// Get the numbering pass that assigned the vertex number
     ///
-    /// @return Global vertex number
-    [[nodiscard]] int num() const;
+    /// @return Numbering pass, 0 if the number was not assigned by `number_vertices`
+    [[nodiscard]] u32 num_pass() const;
 
 private:
     /// Geometrical shape associated with this vertex
     const GeomShape & geom_shape_;
     /// vertex number
-    int num_;
+    Index num_;
+    /// Numbering pass that assigned `num_`
+    u32 num_pass_;
 };
 
 } // namespace krado
@@ -60,6 +60,8 @@ public:
         return *sch_ptr;
     }
 
+    [[nodiscard]] bool has_scheme() const;
+
     Scheme3D & scheme();
 
     /// Get the mesh size for this volume
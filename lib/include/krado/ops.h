@@ -5,6 +5,7 @@
 
 #include "krado/types.h"
 #include "krado/ptr.h"
+#include "krado/quality_measures.h"
 #include <vector>
 #include <tuple>
 #include <map>
@@ -24,6 +25,8 @@ class Axis2;
 class Wire;
 class Plane;
 class MeshSurface;
+class Pattern;
+class Trsf;
 
 /// Translate a shape
 ///
@@ -103,6 +106,48 @@ std::map<Marker, double> compute_volume(Ptr<const Mesh> mesh);
 /// @return Resulting mesh
 Ptr<Mesh> combine(const std::vector<Ptr<Mesh>> & parts);
 
+/// Combine mesh parts into one large mesh and merge coincident nodes on the part interfaces
+///
+/// Only nodes on the boundaries of the parts are matched (interior nodes cannot coincide), so
+/// this is much faster than `combine` followed by `Mesh::remove_duplicate_points`.
+///
+/// @param parts Mesh parts to combine
+/// @param merge_tolerance Nodes closer than this distance are merged
+/// @return Resulting mesh
+Ptr<Mesh> combine(const std::vector<Ptr<Mesh>> & parts, double merge_tolerance);
+
+/// Place copies of a prototype mesh and combine them into one mesh
+///
+/// The prototype is meshed once and every copy is obtained by transforming its points, so this is
+/// much faster than meshing identical parts (like pins in a lattice) one by one. Boundary nodes of
+/// the prototype are found only once and coincident nodes on the interfaces of the copies are
+/// merged. Cell, side and node sets of the prototype are carried over into every copy.
+///
+/// Placements must preserve orientation (i.e. no mirroring), elements are not reversed.
+///
+/// @param prototype Mesh of the prototype
+/// @param placements Transformation for every copy
+/// @param merge_tolerance Nodes closer than this distance are merged
+/// @return Resulting mesh
+Ptr<Mesh> instantiate(const Mesh & prototype,
+                      const std::vector<Trsf> & placements,
+                      double merge_tolerance);
+Ptr<Mesh> instantiate(Ptr<const Mesh> prototype,
+                      const std::vector<Trsf> & placements,
+                      double merge_tolerance);
+
+/// Place copies of a prototype mesh at points of a pattern and combine them into one mesh
+///
+/// Copy `i` is the prototype translated by `pattern.points()[i]`, so the prototype should be
+/// centered at the origin.
+///
+/// @param prototype Mesh of the prototype
+/// @param pattern Pattern with the positions of the copies
+/// @param merge_tolerance Nodes closer than this distance are merged
+/// @return Resulting mesh
+Ptr<Mesh> instantiate(const Mesh & prototype, const Pattern & pattern, double merge_tolerance);
+Ptr<Mesh> instantiate(Ptr<const Mesh> prototype, const Pattern & pattern, double merge_tolerance);
+
 /// Fuse 2 shapes
 ///
 /// @param shape Shape
@@ -224,10 +269,39 @@ GeomShape sweep(const GeomShape & profile, const Wire & spine);
 /// @return Resulting shell
 GeomShape sew(const std::vector<GeomShape> & faces, double tol = 1e-6);
 
+/// Smoothing method
+enum class SmoothingMethod {
+    /// Move vertices to the average of their neighbors
+    LAPLACE,
+    /// Move vertices to maximize the minimum quality of the surrounding elements
+    OPTIMIZE
+};
+
+/// Options for `smooth`
+struct SmoothingOptions {
+    /// Smoothing method
+    SmoothingMethod method = SmoothingMethod::LAPLACE;
+    /// Maximum number of iterations
+    int iterations = 1;
+    /// Quality metric used by `SmoothingMethod::OPTIMIZE`
+    qm::Metric metric = qm::Metric::SCALED_JACOBIAN;
+    /// Stop once the largest vertex displacement (`LAPLACE`) or the improvement of the minimum
+    /// quality (`OPTIMIZE`) is smaller than this
+    double tolerance = 0.;
+};
+
 /// Apply Laplace smoothing to a surface mesh
 ///
 /// @param surface Surface to smooth
 /// @param iterations Number of iterations
 void smooth(Ptr<MeshSurface> surface, int iterations = 1);
 
+/// Smooth a surface mesh
+///
+/// Only vertices inside the surface move, vertices on the bounding curves stay fixed.
+///
+/// @param surface Surface to smooth
+/// @param opts Smoothing options
+void smooth(Ptr<MeshSurface> surface, const SmoothingOptions & opts);
+
 } // namespace krado
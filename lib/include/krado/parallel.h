@@ -0,0 +1,188 @@
+// SPDX-FileCopyrightText: 2026 David Andrs <andrsd@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "krado/thread_pool.h"
+#include "krado/types.h"
+#include <algorithm>
+#include <vector>
+
+namespace krado {
+
+/// Split `[0, n)` into contiguous chunks and process them concurrently
+///
+/// Chunks are processed by the shared `ThreadPool`, at most one chunk per thread.
+///
+/// @param n Number of items
+/// @param grain Minimal number of items per chunk
+/// @param fn Function called as `fn(begin, end)` for each chunk
+template <typename FN>
+void
+parallel_for_chunks(std::size_t n, std::size_t grain, FN && fn)
+{
+    if (n == 0)
+        return;
+    grain = std::max<std::size_t>(grain, 1);
+    std::size_t n_chunks = std::min<std::size_t>(num_threads(), (n + grain - 1) / grain);
+    if (n_chunks <= 1) {
+        fn(std::size_t(0), n);
+        return;
+    }
+
+    ThreadPool::instance().run(n_chunks, [&](std::size_t chunk) {
+        fn(chunk * n / n_chunks, (chunk + 1) * n / n_chunks);
+    });
+}
+
+/// Call `fn(i)` for every `i` in `[0, n)` concurrently
+///
+/// @param n Number of items
+/// @param fn Function to call
+/// @param grain Minimal number of items processed by one thread
+template <typename FN>
+void
+parallel_for(std::size_t n, FN && fn, std::size_t grain = 1024)
+{
+    parallel_for_chunks(n, grain, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i)
+            fn(i);
+    });
+}
+
+/// Reduce values over `[0, n)` concurrently
+///
+/// Every chunk is mapped to a partial result, the partial results are then reduced in the order of
+/// the chunks (so the result is reproducible for a given number of threads).
+///
+/// @param n Number of items
+/// @param init Initial value (identity of `reduce`)
+/// @param map Function called as `map(begin, end)` returning the partial result of a chunk
+/// @param reduce Function combining two partial results
+/// @param grain Minimal number of items processed by one thread
+/// @return Reduced value
+template <typename T, typename MAP, typename REDUCE>
+T
+parallel_reduce(std::size_t n, T init, MAP && map, REDUCE && reduce, std::size_t grain = 1024)
+{
+    if (n == 0)
+        return init;
+    grain = std::max<std::size_t>(grain, 1);
+    std::size_t n_chunks = std::min<std::size_t>(num_threads(), (n + grain - 1) / grain);
+    std::vector<T> partial(n_chunks, init);
+    parallel_for(
+        n_chunks,
+        [&](std::size_t c) { partial[c] = map(c * n / n_chunks, (c + 1) * n / n_chunks); },
+        1);
+    for (auto & p : partial)
+        init = reduce(init, p);
+    return init;
+}
+
+/// Turn counts stored in `vals[1..n]` into offsets (in-place inclusive scan, `vals[0]` is kept)
+///
+/// @param vals Counts, typically CSR offsets with `vals[0] == 0`
+/// @return Sum of all values
+template <typename T>
+T
+parallel_offsets(std::vector<T> & vals)
+{
+    const std::size_t n = vals.size();
+    if (n == 0)
+        return T(0);
+
+    constexpr std::size_t GRAIN = 1 << 16;
+    std::size_t n_chunks = std::min<std::size_t>(num_threads(), (n + GRAIN - 1) / GRAIN);
+    if (n_chunks <= 1) {
+        for (std::size_t i = 1; i < n; ++i)
+            vals[i] += vals[i - 1];
+        return vals[n - 1];
+    }
+
+    // sum chunks, scan the chunk sums and then scan the chunks with their starting offsets
+    std::vector<T> chunk_sum(n_chunks, T(0));
+    parallel_for(
+        n_chunks,
+        [&](std::size_t c) {
+            for (std::size_t i = c * n / n_chunks; i < (c + 1) * n / n_chunks; ++i)
+                chunk_sum[c] += vals[i];
+        },
+        1);
+    T ofst(0);
+    for (auto & s : chunk_sum) {
+        auto v = s;
+        s = ofst;
+        ofst += v;
+    }
+    parallel_for(
+        n_chunks,
+        [&](std::size_t c) {
+            T acc = chunk_sum[c];
+            for (std::size_t i = c * n / n_chunks; i < (c + 1) * n / n_chunks; ++i) {
+                acc += vals[i];
+                vals[i] = acc;
+            }
+        },
+        1);
+    return vals[n - 1];
+}
+
+/// Sort a vector concurrently (chunks are sorted independently and then merged pairwise)
+///
+/// @param vals Values to sort
+/// @param comp Comparison function
+template <typename T, typename COMPARE>
+void
+parallel_sort(std::vector<T> & vals, COMPARE comp)
+{
+    constexpr std::size_t GRAIN = 1 << 15;
+    const std::size_t n = vals.size();
+    std::size_t n_chunks = std::min<std::size_t>(num_threads(), (n + GRAIN - 1) / GRAIN);
+    if (n_chunks <= 1) {
+        std::sort(vals.begin(), vals.end(), comp);
+        return;
+    }
+
+    std::vector<std::size_t> bounds(n_chunks + 1);
+    for (std::size_t c = 0; c <= n_chunks; ++c)
+        bounds[c] = c * n / n_chunks;
+    parallel_for(
+        n_chunks,
+        [&](std::size_t c) {
+            std::sort(vals.begin() + bounds[c], vals.begin() + bounds[c + 1], comp);
+        },
+        1);
+
+    std::vector<T> buffer(n);
+    auto * src = &vals;
+    auto * dst = &buffer;
+    while (bounds.size() > 2) {
+        std::size_t n_runs = bounds.size() - 1;
+        parallel_for(
+            (n_runs + 1) / 2,
+            [&](std::size_t p) {
+                auto lo = bounds[2 * p];
+                auto mid = bounds[std::min(2 * p + 1, n_runs)];
+                auto hi = bounds[std::min(2 * p + 2, n_runs)];
+                std::merge(src->begin() + lo,
+                           src->begin() + mid,
+                           src->begin() + mid,
+                           src->begin() + hi,
+                           dst->begin() + lo,
+                           comp);
+            },
+            1);
+        std::vector<std::size_t> merged;
+        merged.reserve(n_runs / 2 + 2);
+        for (std::size_t i = 0; i < bounds.size(); i += 2)
+            merged.push_back(bounds[i]);
+        if (merged.back() != n)
+            merged.push_back(n);
+        bounds = std::move(merged);
+        std::swap(src, dst);
+    }
+    if (src != &vals)
+        vals.swap(buffer);
+}
+
+} // namespace krado
@@ -4,61 +4,124 @@
 #pragma once
 
 #include "krado/exception.h"
+#include <atomic>
+#include <new>
 #include <utility>
 
 namespace krado {
 
+namespace detail {
+
+/// Control block shared by all `Ptr`s pointing to the same object
+struct PtrControlBlock {
+    using Dispose = void (*)(PtrControlBlock *);
+
+    explicit PtrControlBlock(Dispose dispose) : ptr(nullptr), strong(1), dispose(dispose) {}
+
+    /// The object
+    void * ptr;
+    /// Number of `Ptr`s pointing to the object (atomic, so `Ptr`s can be copied from several
+    /// threads)
+    std::atomic<std::size_t> strong;
+    /// Destroy the object and free the control block
+    Dispose dispose;
+};
+
+/// Control block of an object allocated separately from it
+template <typename T>
+struct PtrSeparateBlock : PtrControlBlock {
+    explicit PtrSeparateBlock(T * p) : PtrControlBlock(&PtrSeparateBlock::dispose_block)
+    {
+        this->ptr = const_cast<void *>(static_cast<const void *>(p));
+    }
+
+    static void
+    dispose_block(PtrControlBlock * blk)
+    {
+        delete static_cast<T *>(blk->ptr);
+        delete static_cast<PtrSeparateBlock *>(blk);
+    }
+};
+
+/// Control block with the object stored in it, so the object and its control block take a single
+/// allocation
+template <typename T>
+struct PtrInlineBlock : PtrControlBlock {
+    PtrInlineBlock() : PtrControlBlock(&PtrInlineBlock::dispose_block) {}
+
+    static void
+    dispose_block(PtrControlBlock * blk)
+    {
+        static_cast<T *>(blk->ptr)->~T();
+        delete static_cast<PtrInlineBlock *>(blk);
+    }
+
+    alignas(T) unsigned char storage[sizeof(T)];
+};
+
+} // namespace detail
+
+template <typename T, std::size_t CHUNK_SIZE>
+class Arena;
+
 /// Reference counted pointer.  It works like `std::shared_ptr<T>`
 ///
+/// The reference count is atomic, so `Ptr`s pointing to the same object can be copied and
+/// destroyed from several threads at the same time. The object itself is not protected.
+///
 /// @tparam T C++ type we point to
 template <typename T>
 class Ptr {
 private:
-    struct ControlBlock {
-        T * ptr;
-        std::size_t strong;
-        std::size_t weak;
-
-        explicit ControlBlock(T * p) : ptr(p), strong(1), weak(0) {}
-    };
+    using ControlBlock = detail::PtrControlBlock;
 
+    /// Control block shared with the other `Ptr`s to the same object
     ControlBlock * ctrl_;
+    /// The object seen as `T`. This can differ from the pointer in the control block when `T` is
+    /// a base class at a non-zero offset.
+    T * ptr_;
+
+    Ptr(ControlBlock * ctrl, T * ptr) : ctrl_(ctrl), ptr_(ptr) {}
+
+    void
+    acquire() const
+    {
+        if (this->ctrl_)
+            this->ctrl_->strong.fetch_add(1, std::memory_order_relaxed);
+    }
 
 public:
-    Ptr() : ctrl_(nullptr) {}
+    Ptr() : ctrl_(nullptr), ptr_(nullptr) {}
 
     // Construct from `nullptr`
-    Ptr(std::nullptr_t) : ctrl_(nullptr) {}
+    Ptr(std::nullptr_t) : ctrl_(nullptr), ptr_(nullptr) {}
 
-    // Cross-type constructor (Ptr<U> -> Ptr<T>)
+    // Cross-type constructor (Ptr<U> -> Ptr<T>), `casted` is `other.get()` converted to `T *`
     template <typename U>
-    Ptr(const Ptr<U> & other, T * casted) : ctrl_(nullptr)
+    Ptr(const Ptr<U> & other, T * casted) : ctrl_(nullptr), ptr_(nullptr)
     {
         if (casted) {
-            this->ctrl_ = reinterpret_cast<ControlBlock *>(other.ctrl_);
-            if (this->ctrl_)
-                ++this->ctrl_->strong;
+            this->ctrl_ = other.ctrl_;
+            this->ptr_ = casted;
+            acquire();
         }
     }
 
     // Copy constructor
-    Ptr(const Ptr & other) : ctrl_(other.ctrl_)
-    {
-        if (this->ctrl_)
-            ++this->ctrl_->strong;
-    }
+    Ptr(const Ptr & other) : ctrl_(other.ctrl_), ptr_(other.ptr_) { acquire(); }
 
     // Move constructor
-    Ptr(Ptr && other) noexcept : ctrl_(other.ctrl_) { other.ctrl_ = nullptr; }
+    Ptr(Ptr && other) noexcept : ctrl_(other.ctrl_), ptr_(other.ptr_)
+    {
+        other.ctrl_ = nullptr;
+        other.ptr_ = nullptr;
+    }
 
     // Converting copy constructor
     template <typename U, typename = std::enable_if_t<std::is_convertible<U *, T *>::value>>
-    Ptr(const Ptr<U> & other) : ctrl_(nullptr)
+    Ptr(const Ptr<U> & other) : ctrl_(other.ctrl_), ptr_(other.ptr_)
     {
-        if (other.ctrl_) {
-            this->ctrl_ = reinterpret_cast<ControlBlock *>(other.ctrl_);
-            ++this->ctrl_->strong;
-        }
+        acquire();
     }
 
     // Copy assignment
@@ -66,10 +129,10 @@ public:
     operator=(const Ptr & other)
     {
         if (this != &other) {
+            other.acquire();
             release();
-            this->ctrl_ = reinterpret_cast<ControlBlock *>(other.ctrl_);
-            if (this->ctrl_)
-                ++this->ctrl_->strong;
+            this->ctrl_ = other.ctrl_;
+            this->ptr_ = other.ptr_;
         }
         return *this;
     }
@@ -80,10 +143,10 @@ public:
     operator=(const Ptr<U> & other)
     {
         if (reinterpret_cast<const void *>(this) != reinterpret_cast<const void *>(&other)) {
+            other.acquire();
             release();
-            this->ctrl_ = reinterpret_cast<ControlBlock *>(other.ctrl_);
-            if (this->ctrl_)
-                ++this->ctrl_->strong;
+            this->ctrl_ = other.ctrl_;
+            this->ptr_ = other.ptr_;
         }
         return *this;
     }
@@ -94,6 +157,7 @@ public:
     {
         release();
         this->ctrl_ = nullptr;
+        this->ptr_ = nullptr;
         return *this;
     }
 
@@ -104,7 +168,9 @@ public:
         if (this != &other) {
             release();
             this->ctrl_ = other.ctrl_;
+            this->ptr_ = other.ptr_;
             other.ctrl_ = nullptr;
+            other.ptr_ = nullptr;
         }
         return *this;
     }
@@ -122,7 +188,7 @@ public:
     operator*() const
     {
         if (this->ctrl_)
-            return *this->ctrl_->ptr;
+            return *get();
         else
             throw Exception("Access into a null pointer");
     }
@@ -131,7 +197,7 @@ public:
     T *
     operator->() const
     {
-        return this->ctrl_->ptr;
+        return get();
     }
 
     // Compare two Ptr<T> of the same type
@@ -199,14 +265,14 @@ public:
     [[nodiscard]] T *
     get() const
     {
-        return this->ctrl_ ? this->ctrl_->ptr : nullptr;
+        return this->ptr_;
     }
 
     // Get the reference count
     [[nodiscard]] int
     ref_count() const
     {
-        return this->ctrl_ ? this->ctrl_->strong : 0;
+        return this->ctrl_ ? this->ctrl_->strong.load() : 0;
     }
 
     // Is this a null pointer?
@@ -216,22 +282,30 @@ public:
         return this->ctrl_ == nullptr;
     }
 
-    explicit Ptr(T * ptr) : ctrl_(new ControlBlock(ptr)) {}
+    /// Take ownership of an object allocated with `new`
+    ///
+    /// Prefer `alloc`, which allocates the object and its control block at once.
+    ///
+    /// @param ptr Object to own
+    explicit Ptr(T * ptr) :
+        ctrl_(ptr ? new detail::PtrSeparateBlock<T>(ptr) : nullptr),
+        ptr_(ptr)
+    {
+    }
 
 private:
     void
     release()
     {
-        if (this->ctrl_ && --this->ctrl_->strong == 0) {
-            delete this->ctrl_->ptr;
-            if (this->ctrl_->weak == 0)
-                delete this->ctrl_;
-        }
+        if (this->ctrl_ && this->ctrl_->strong.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            this->ctrl_->dispose(this->ctrl_);
     }
 
 public:
     /// Allocate a new object and return a `Ptr` to it
     ///
+    /// The object is stored together with its control block, so this takes a single allocation.
+    ///
     /// @tparam T C++ type we point to
     /// @tparam ARGS
     /// @param args Arguments passed into a constructor
@@ -239,7 +313,17 @@ public:
     static Ptr<T>
     alloc(ARGS &&... args)
     {
-        return Ptr<T>(new T(std::forward<ARGS>(args)...));
+        auto * blk = new detail::PtrInlineBlock<T>();
+        T * obj;
+        try {
+            obj = new (blk->storage) T(std::forward<ARGS>(args)...);
+            blk->ptr = const_cast<void *>(static_cast<const void *>(obj));
+        }
+        catch (...) {
+            delete blk;
+            throw;
+        }
+        return Ptr<T>(static_cast<ControlBlock *>(blk), obj);
     }
 
     template <typename U>
@@ -262,6 +346,8 @@ public:
 
     template <typename U>
     friend class Ptr;
+    template <typename U, std::size_t CHUNK_SIZE>
+    friend class Arena;
 };
 
 template <typename T, typename U>
@@ -93,6 +93,20 @@ enum class Metric {
     SKEWNESS,
 };
 
+/// Compute quality of an element from locations of its vertices
+///
+/// @param type Element type
+/// @param pts Locations of the element vertices
+/// @param metric Metric to compute
+/// @return Element quality
+double compute_metric(ElementType type, Span<const Point> pts, Metric metric);
+
+/// Check if higher values of a metric mean better elements
+///
+/// @param metric Metric to check
+/// @return `true` if higher values are better, `false` if lower values are better
+bool higher_is_better(Metric metric);
+
 struct QualityStats {
     Metric metric;
     /// Minimum quality
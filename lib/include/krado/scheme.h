@@ -24,6 +24,18 @@ public:
         return "";
     }
 
+    /// Check if the scheme can mesh several entities at the same time
+    ///
+    /// Schemes using global state must return `false`, `GeomModel::mesh_all` then runs them one
+    /// at a time (in the order of entity IDs) and never together with entities sharing a curve.
+    ///
+    /// @return `true` if the scheme is thread-safe
+    [[nodiscard]] virtual bool
+    is_thread_safe() const
+    {
+        return true;
+    }
+
 private:
     std::string name_;
 };
@@ -21,6 +21,9 @@ public:
 
     void mesh_surface(Ptr<MeshSurface> surface) override;
 
+    /// BAMG uses a global random number generator and adds segments to the bounding curves
+    [[nodiscard]] bool is_thread_safe() const override;
+
 private:
     Options opts_;
 };
@@ -21,6 +21,8 @@ public:
         double linear_deflection;
         double angular_deflection;
         bool is_relative;
+        /// Tessellate faces and transfer the triangulations into surfaces in parallel
+        bool in_parallel = true;
     };
 
 public:
@@ -0,0 +1,59 @@
+// SPDX-FileCopyrightText: 2026 David Andrs <andrsd@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "krado/types.h"
+#include <functional>
+#include <vector>
+
+namespace krado {
+
+/// Graph of tasks with dependencies
+///
+/// Tasks run on the shared `ThreadPool` as soon as all tasks they depend on finished. Tasks can use
+/// `parallel_for` and friends themselves.
+///
+/// Example:
+/// ```
+/// TaskGraph graph;
+/// auto a = graph.add([] { ... });
+/// auto b = graph.add([] { ... });
+/// graph.add([] { ... }, { a, b });  // runs after `a` and `b`
+/// graph.run();
+/// ```
+class TaskGraph {
+public:
+    TaskGraph() = default;
+
+    /// Add a task
+    ///
+    /// @param fn Function to execute
+    /// @param deps Tasks that must finish before this task starts
+    /// @return ID of the task
+    Index add(std::function<void()> fn, const std::vector<Index> & deps = {});
+
+    /// Get number of tasks
+    ///
+    /// @return Number of tasks
+    [[nodiscard]] std::size_t size() const;
+
+    /// Run all tasks and wait until they finish
+    ///
+    /// If a task throws, tasks that did not start yet are skipped and the first exception is
+    /// rethrown.
+    void run();
+
+private:
+    struct Task {
+        std::function<void()> fn;
+        /// Tasks that depend on this task
+        std::vector<Index> successors;
+        /// Number of tasks this task depends on
+        Index n_deps = 0;
+    };
+
+    std::vector<Task> tasks_;
+};
+
+} // namespace krado
@@ -0,0 +1,94 @@
+// SPDX-FileCopyrightText: 2026 David Andrs <andrsd@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace krado {
+
+/// Pool of worker threads shared by all parallel algorithms in krado
+///
+/// The calling thread always takes part in the work, so a pool running `n` threads has `n - 1`
+/// workers. The number of threads is given by `KRADO_NUM_THREADS` environment variable (or the
+/// number of hardware threads, if not set) and can be changed by `set_num_threads`.
+///
+/// @note This is a singleton
+class ThreadPool {
+public:
+    /// Create a pool
+    ///
+    /// @param n_threads Number of threads including the calling thread
+    explicit ThreadPool(unsigned int n_threads);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool & operator=(const ThreadPool &) = delete;
+
+    /// Get number of threads (including the calling thread)
+    ///
+    /// @return Number of threads
+    [[nodiscard]] unsigned int num_threads() const;
+
+    /// Change number of threads
+    ///
+    /// Must not be called while the pool is running tasks.
+    ///
+    /// @param n_threads Number of threads including the calling thread
+    void resize(unsigned int n_threads);
+
+    /// Call `fn(i)` for every `i` in `[0, n)` and wait until all calls finished
+    ///
+    /// The calling thread processes items, too, so this can be called from inside a task. If any
+    /// call throws, the first exception is rethrown once all started calls finished.
+    ///
+    /// @param n Number of items
+    /// @param fn Function to call
+    void run(std::size_t n, const std::function<void(std::size_t)> & fn);
+
+    /// Queue a task to be run by a worker
+    ///
+    /// @param task Task to run
+    void submit(std::function<void()> task);
+
+    /// Run one queued task in the calling thread
+    ///
+    /// @return `true` if a task was run, `false` if the queue was empty
+    bool run_pending_task();
+
+    /// Get the pool
+    ///
+    /// @return The pool
+    static ThreadPool & instance();
+
+private:
+    void start(unsigned int n_threads);
+    void stop();
+    void worker_loop();
+
+    /// Worker threads
+    std::vector<std::thread> workers_;
+    /// Queued tasks
+    std::deque<std::function<void()>> tasks_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stopping_ = false;
+};
+
+/// Get the number of threads used by parallel algorithms
+///
+/// @return Number of threads
+unsigned int num_threads();
+
+/// Set the number of threads used by parallel algorithms
+///
+/// @param n Number of threads (0 means the number of hardware threads)
+void set_num_threads(unsigned int n);
+
+} // namespace krado
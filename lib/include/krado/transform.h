@@ -75,6 +75,13 @@ public:
     /// @return Transformed point
     [[nodiscard]] Point operator*(const Point & other) const;
 
+    /// Get an entry of the transformation matrix
+    ///
+    /// @param row Row index (0-3)
+    /// @param col Column index (0-3)
+    /// @return Matrix entry
+    [[nodiscard]] double operator()(int row, int col) const;
+
 private:
     static constexpr int N = 4;
 
@@ -84,6 +84,16 @@ enum class QuadSplitMode : u8 {
     SPLIT4
 };
 
+/// Ordering of mesh nodes and elements (see `reorder`)
+enum class Ordering : u8 {
+    /// Reverse Cuthill-McKee ordering of the node graph
+    RCM,
+    /// Elements sorted along a Hilbert curve through their centroids
+    HILBERT,
+    /// Elements sorted along a Morton (Z-order) curve through their centroids
+    MORTON
+};
+
 class HasseKey {
 public:
     explicit constexpr HasseKey(u64 val) : value_(val) {}
@@ -213,6 +213,12 @@ human_number(T value)
 /// @return Formatted string `1h 2m 1.2s` or `100.2ms` (for short time durations)
 std::string human_time(double time);
 
+/// Print amount of memory in human readable form
+///
+/// @param bytes Number of bytes
+/// @return Formatted string `512B`, `1.50KiB`, `2.00MiB`, etc.
+std::string human_bytes(std::size_t bytes);
+
 /// Mark for unreachable code
 ///
 /// This is defined as `std::unreachable` in C++23, so we need this ATM.
@@ -0,0 +1,209 @@
+// SPDX-FileCopyrightText: 2026 David Andrs <andrsd@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "krado/connectivity.h"
+#include "krado/exception.h"
+#include "krado/parallel.h"
+#include <limits>
+#include <stdexcept>
+
+namespace krado {
+
+Connectivity::Connectivity() : offsets_(1, 0) {}
+
+Connectivity::Connectivity(const std::vector<Element> & elems) : offsets_(elems.size() + 1, 0)
+{
+    this->types_.resize(elems.size());
+    parallel_for(elems.size(), [&](std::size_t i) {
+        this->types_[i] = elems[i].type();
+        this->offsets_[i + 1] = elems[i].num_vertices();
+    });
+    std::size_t n_ids = 0;
+    for (auto & e : elems)
+        n_ids += e.num_vertices();
+    this->check_size(n_ids);
+    parallel_offsets(this->offsets_);
+
+    this->ids_.resize(n_ids);
+    parallel_for(elems.size(), [&](std::size_t i) {
+        auto ids = elems[i].indices();
+        std::copy(ids.begin(), ids.end(), this->ids_.begin() + this->offsets_[i]);
+    });
+}
+
+Connectivity::Connectivity(std::vector<ElementType> types,
+                           std::vector<Index> offsets,
+                           std::vector<Index> ids) :
+    types_(std::move(types)),
+    offsets_(std::move(offsets)),
+    ids_(std::move(ids))
+{
+    if (this->offsets_.size() != this->types_.size() + 1 || this->offsets_.front() != 0 ||
+        this->offsets_.back() != this->ids_.size())
+        throw Exception("Inconsistent connectivity: {} element(s), {} offset(s), {} vertex ID(s)",
+                        this->types_.size(),
+                        this->offsets_.size(),
+                        this->ids_.size());
+    this->check_size(this->ids_.size());
+}
+
+std::size_t
+Connectivity::size() const
+{
+    return this->types_.size();
+}
+
+bool
+Connectivity::empty() const
+{
+    return this->types_.empty();
+}
+
+void
+Connectivity::reserve(std::size_t n_elems, std::size_t n_ids)
+{
+    this->types_.reserve(n_elems);
+    this->offsets_.reserve(n_elems + 1);
+    this->ids_.reserve(n_ids);
+}
+
+void
+Connectivity::clear()
+{
+    this->types_.clear();
+    this->offsets_.assign(1, 0);
+    this->ids_.clear();
+}
+
+ElementView
+Connectivity::at(std::size_t idx) const
+{
+    if (idx >= this->size())
+        throw std::out_of_range(fmt::format("Element index {} out of range", idx));
+    return (*this)[idx];
+}
+
+void
+Connectivity::push_back(ElementView elem)
+{
+    auto ids = elem.indices();
+    this->check_size(this->ids_.size() + ids.size());
+    this->types_.push_back(elem.type());
+    this->ids_.insert(this->ids_.end(), ids.begin(), ids.end());
+    this->offsets_.push_back(this->ids_.size());
+}
+
+void
+Connectivity::push_back(const Element & elem)
+{
+    this->push_back(ElementView(elem));
+}
+
+void
+Connectivity::append(ElementsView elems, Index ofst)
+{
+    if (elems.empty())
+        return;
+
+    auto n_elems = this->size();
+    auto n_ids = this->ids_.size();
+    auto src_first = elems[0].indices().data();
+    auto src_last = elems[elems.size() - 1].indices();
+    std::size_t n_new_ids = src_last.data() + src_last.size() - src_first;
+    this->check_size(n_ids + n_new_ids);
+
+    this->types_.resize(n_elems + elems.size());
+    this->offsets_.resize(n_elems + elems.size() + 1);
+    this->ids_.resize(n_ids + n_new_ids);
+    parallel_for(elems.size(), [&](std::size_t i) {
+        auto el = elems[i];
+        auto first = el.indices().data() - src_first;
+        this->types_[n_elems + i] = el.type();
+        this->offsets_[n_elems + i + 1] = n_ids + first + el.indices().size();
+    });
+    parallel_for(n_new_ids, [&](std::size_t i) { this->ids_[n_ids + i] = src_first[i] + ofst; });
+}
+
+void
+Connectivity::shift(std::size_t first, std::size_t last, Index ofst)
+{
+    auto begin = this->offsets_[first];
+    parallel_for(this->offsets_[last] - begin, [&](std::size_t i) {
+        this->ids_[begin + i] += ofst;
+    });
+}
+
+void
+Connectivity::remap(Span<const Index> new_ids)
+{
+    parallel_for(this->ids_.size(), [&](std::size_t i) {
+        this->ids_[i] = new_ids[this->ids_[i]];
+    });
+}
+
+void
+Connectivity::permute(Span<const Index> new_ids)
+{
+    if (new_ids.size() != this->size())
+        throw Exception("Permutation has {} entries, but there are {} elements",
+                        new_ids.size(),
+                        this->size());
+
+    std::vector<ElementType> types(this->size());
+    std::vector<Index> offsets(this->size() + 1, 0);
+    parallel_for(this->size(), [&](std::size_t i) {
+        types[new_ids[i]] = this->types_[i];
+        offsets[new_ids[i] + 1] = this->offsets_[i + 1] - this->offsets_[i];
+    });
+    parallel_offsets(offsets);
+
+    std::vector<Index> ids(this->ids_.size());
+    parallel_for(this->size(), [&](std::size_t i) {
+        std::copy(this->ids_.begin() + this->offsets_[i],
+                  this->ids_.begin() + this->offsets_[i + 1],
+                  ids.begin() + offsets[new_ids[i]]);
+    });
+    this->types_.swap(types);
+    this->offsets_.swap(offsets);
+    this->ids_.swap(ids);
+}
+
+const std::vector<ElementType> &
+Connectivity::types() const
+{
+    return this->types_;
+}
+
+const std::vector<Index> &
+Connectivity::offsets() const
+{
+    return this->offsets_;
+}
+
+const std::vector<Index> &
+Connectivity::ids() const
+{
+    return this->ids_;
+}
+
+ElementsView
+Connectivity::view() const
+{
+    return { this->types_.data(), this->offsets_.data(), this->ids_.data(), this->size() };
+}
+
+std::size_t
+Connectivity::memory_usage() const
+{
+    return this->types_.capacity() * sizeof(ElementType) +
+           this->offsets_.capacity() * sizeof(Index) + this->ids_.capacity() * sizeof(Index);
+}
+
+void
+Connectivity::check_size(std::size_t n_ids) const
+{
+    if (n_ids > std::numeric_limits<Index>::max())
+        throw Exception("Connectivity is too large ({} vertex indices)", n_ids);
+}
+
+} // namespace krado
@@ -0,0 +1,223 @@
+// SPDX-FileCopyrightText: 2026 David Andrs <andrsd@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "krado/coordinates.h"
+#include "krado/bounding_box_3d.h"
+#include "krado/exception.h"
+#include "krado/parallel.h"
+#include "krado/transform.h"
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <stdexcept>
+
+namespace krado {
+
+Coordinates::Coordinates(const std::vector<Point> & points) :
+    x_(points.size()),
+    y_(points.size()),
+    z_(points.size())
+{
+    parallel_for(points.size(), [&](std::size_t i) { this->set(i, points[i]); });
+}
+
+Coordinates::Coordinates(std::vector<double> x, std::vector<double> y, std::vector<double> z) :
+    x_(std::move(x)),
+    y_(std::move(y)),
+    z_(std::move(z))
+{
+    if (this->x_.size() != this->y_.size() || this->x_.size() != this->z_.size())
+        throw Exception("Coordinate arrays have different sizes ({}, {}, {})",
+                        this->x_.size(),
+                        this->y_.size(),
+                        this->z_.size());
+}
+
+std::size_t
+Coordinates::size() const
+{
+    return this->x_.size();
+}
+
+bool
+Coordinates::empty() const
+{
+    return this->x_.empty();
+}
+
+void
+Coordinates::reserve(std::size_t n)
+{
+    this->x_.reserve(n);
+    this->y_.reserve(n);
+    this->z_.reserve(n);
+}
+
+void
+Coordinates::resize(std::size_t n)
+{
+    this->x_.resize(n);
+    this->y_.resize(n);
+    this->z_.resize(n);
+}
+
+void
+Coordinates::clear()
+{
+    this->x_.clear();
+    this->y_.clear();
+    this->z_.clear();
+}
+
+Point
+Coordinates::at(std::size_t idx) const
+{
+    if (idx >= this->size())
+        throw std::out_of_range(fmt::format("Point index {} out of range", idx));
+    return (*this)[idx];
+}
+
+void
+Coordinates::push_back(const Point & pt)
+{
+    this->x_.push_back(pt.x);
+    this->y_.push_back(pt.y);
+    this->z_.push_back(pt.z);
+}
+
+void
+Coordinates::append(PointsView points)
+{
+    this->x_.insert(this->x_.end(), points.x().begin(), points.x().end());
+    this->y_.insert(this->y_.end(), points.y().begin(), points.y().end());
+    this->z_.insert(this->z_.end(), points.z().begin(), points.z().end());
+}
+
+void
+Coordinates::permute(Span<const Index> new_ids)
+{
+    if (new_ids.size() != this->size())
+        throw Exception("Permutation has {} entries, but there are {} points",
+                        new_ids.size(),
+                        this->size());
+
+    std::vector<double> x(this->size()), y(this->size()), z(this->size());
+    parallel_for(this->size(), [&](std::size_t i) {
+        x[new_ids[i]] = this->x_[i];
+        y[new_ids[i]] = this->y_[i];
+        z[new_ids[i]] = this->z_[i];
+    });
+    this->x_.swap(x);
+    this->y_.swap(y);
+    this->z_.swap(z);
+}
+
+const std::vector<double> &
+Coordinates::x() const
+{
+    return this->x_;
+}
+
+const std::vector<double> &
+Coordinates::y() const
+{
+    return this->y_;
+}
+
+const std::vector<double> &
+Coordinates::z() const
+{
+    return this->z_;
+}
+
+PointsView
+Coordinates::view() const
+{
+    return { this->x_.data(), this->y_.data(), this->z_.data(), this->size() };
+}
+
+void
+Coordinates::transform(const Trsf & tr)
+{
+    const double a00 = tr(0, 0), a01 = tr(0, 1), a02 = tr(0, 2), a03 = tr(0, 3);
+    const double a10 = tr(1, 0), a11 = tr(1, 1), a12 = tr(1, 2), a13 = tr(1, 3);
+    const double a20 = tr(2, 0), a21 = tr(2, 1), a22 = tr(2, 2), a23 = tr(2, 3);
+    const double a30 = tr(3, 0), a31 = tr(3, 1), a32 = tr(3, 2), a33 = tr(3, 3);
+    // all transformations we build are affine, so the homogeneous divide can be skipped
+    const bool affine = a30 == 0. && a31 == 0. && a32 == 0. && a33 == 1.;
+
+    double * x = this->x_.data();
+    double * y = this->y_.data();
+    double * z = this->z_.data();
+    parallel_for_chunks(this->size(), 4096, [&](std::size_t begin, std::size_t end) {
+        if (affine) {
+            for (std::size_t i = begin; i < end; ++i) {
+                const double px = x[i], py = y[i], pz = z[i];
+                x[i] = a00 * px + a01 * py + a02 * pz + a03;
+                y[i] = a10 * px + a11 * py + a12 * pz + a13;
+                z[i] = a20 * px + a21 * py + a22 * pz + a23;
+            }
+        }
+        else {
+            for (std::size_t i = begin; i < end; ++i) {
+                const double px = x[i], py = y[i], pz = z[i];
+                const double w = a30 * px + a31 * py + a32 * pz + a33;
+                x[i] = (a00 * px + a01 * py + a02 * pz + a03) / w;
+                y[i] = (a10 * px + a11 * py + a12 * pz + a13) / w;
+                z[i] = (a20 * px + a21 * py + a22 * pz + a23) / w;
+            }
+        }
+    });
+}
+
+BoundingBox3D
+Coordinates::bounding_box() const
+{
+    if (this->empty())
+        return BoundingBox3D();
+
+    constexpr double INF = std::numeric_limits<double>::max();
+    using Extents = std::array<double, 6>;
+    const double * x = this->x_.data();
+    const double * y = this->y_.data();
+    const double * z = this->z_.data();
+    auto ext = parallel_reduce(
+        this->size(),
+        Extents { INF, INF, INF, -INF, -INF, -INF },
+        [&](std::size_t begin, std::size_t end) {
+            Extents e = { INF, INF, INF, -INF, -INF, -INF };
+            for (std::size_t i = begin; i < end; ++i) {
+                e[0] = std::min(e[0], x[i]);
+                e[1] = std::min(e[1], y[i]);
+                e[2] = std::min(e[2], z[i]);
+                e[3] = std::max(e[3], x[i]);
+                e[4] = std::max(e[4], y[i]);
+                e[5] = std::max(e[5], z[i]);
+            }
+            return e;
+        },
+        [](const Extents & a, const Extents & b) {
+            return Extents { std::min(a[0], b[0]), std::min(a[1], b[1]), std::min(a[2], b[2]),
+                             std::max(a[3], b[3]), std::max(a[4], b[4]), std::max(a[5], b[5]) };
+        },
+        1 << 14);
+    return BoundingBox3D(ext[0], ext[1], ext[2], ext[3], ext[4], ext[5]);
+}
+
+Point
+Coordinates::centroid(Span<const Index> ids) const
+{
+    if (ids.empty())
+        return Point(0., 0., 0.);
+
+    double cx = 0., cy = 0., cz = 0.;
+    for (auto id : ids) {
+        cx += this->x_[id];
+        cy += this->y_[id];
+        cz += this->z_[id];
+    }
+    const double n = static_cast<double>(ids.size());
+    return Point(cx / n, cy / n, cz / n);
+}
+
+} // namespace krado
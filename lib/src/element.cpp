@@ -7,6 +7,7 @@
 #include "krado/point.h"
 #include "krado/vector.h"
 #include "krado/numerics.h"
+#include <algorithm>
 #include <array>
 
 namespace krado {
@@ -39,7 +40,7 @@ const std::vector<std::array<u8, 2>> Pyramid5::EDGE_VERTICES = { { 0, 1 }, { 1,
                                                                  { 3, 0 }, { 0, 4 }, { 1, 4 },
                                                                  { 2, 4 }, { 3, 4 } };
 const std::vector<std::vector<u8>> Pyramid5::FACE_EDGES = { { 0, 1, 2, 3 },
-                                                            { 0, 3, 4 },
+                                                            { 0, 5, 4 },
                                                             { 1, 6, 5 },
                                                             { 2, 7, 6 },
                                                             { 3, 4, 7 } };
@@ -56,7 +57,7 @@ const std::vector<std::array<u8, 2>> Prism6::EDGE_VERTICES = { { 0, 1 }, { 1, 2
 const std::vector<std::vector<u8>> Prism6::FACE_EDGES = { { 2, 1, 0 },
                                                           { 0, 4, 6, 3 },
                                                           { 1, 5, 7, 4 },
-                                                          { 2, 3, 8, 6 },
+                                                          { 2, 3, 8, 5 },
                                                           { 6, 7, 8 } };
 const std::vector<std::vector<u8>> Prism6::FACE_VERTICES = { { 0, 2, 1 },
                                                              { 0, 1, 4, 3 },
@@ -78,6 +79,17 @@ const std::vector<std::vector<u8>> Hex8::FACE_VERTICES = { { 0, 1, 5, 4 }, { 2,
 
 //
 
+Index
+ElementView::index(u8 idx) const
+{
+    if (idx < this->vtx_ids_.size())
+        return this->vtx_ids_[idx];
+    else
+        throw Exception("Access out of range. `idx` can be 0..{}", this->vtx_ids_.size() - 1);
+}
+
+//
+
 Element::Element(ElementType type, const std::vector<Index> & vtx_ids) : elem_type_(type)
 {
     if (vtx_ids.size() <= MAX_INDICES) {
@@ -89,6 +101,19 @@ Element::Element(ElementType type, const std::vector<Index> & vtx_ids) : elem_ty
         throw Exception("Unable to handle more then {} indices", MAX_INDICES);
 }
 
+Element::Element(ElementView view) : elem_type_(view.type()), n_ids_(view.num_vertices())
+{
+    if (this->n_ids_ > MAX_INDICES)
+        throw Exception("Unable to handle more then {} indices", MAX_INDICES);
+    auto ids = view.indices();
+    std::copy(ids.begin(), ids.end(), this->vtx_id_.begin());
+}
+
+Element::operator ElementView() const &
+{
+    return { this->elem_type_, this->indices() };
+}
+
 ElementType
 Element::type() const
 {
@@ -123,6 +148,13 @@ Element::shift(Index ofst)
         this->vtx_id_[i] += ofst;
 }
 
+void
+Element::remap(Span<const Index> new_ids)
+{
+    for (int i = 0; i < this->n_ids_; i++)
+        this->vtx_id_[i] = new_ids[this->vtx_id_[i]];
+}
+
 Element
 Element::Line2(const std::array<Index, 2> & ids)
 {
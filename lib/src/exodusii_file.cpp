@@ -15,8 +15,12 @@
 #include "krado/mesh_surface_vertex.h"
 #include "krado/mesh_volume.h"
 #include "krado/timer.h"
+#include "krado/parallel.h"
 #include "fmt/format.h"
 #include "fmt/chrono.h"
+#include "exodusII.h"
+#include <algorithm>
+#include <limits>
 
 namespace krado {
 
@@ -132,7 +136,6 @@ struct SideSet {
 
 using NodeSet = std::vector<int>;
 
-using VertexIdMap = std::map<Ptr<MeshVertexAbstract>, Index>;
 using BlocksMap = std::map<Marker, std::vector<Element>>;
 using SideSetMap = std::map<Marker, SideSet>;
 using NodeSetMap = std::map<Marker, NodeSet>;
@@ -150,68 +153,50 @@ create_name(Marker id, const NamesMap & names)
 // Helpers for building things from `GeomModel`
 
 std::tuple<std::vector<double>, std::vector<double>, std::vector<double>>
-build_coords(const VertexIdMap & pnt_map, int dim)
+build_coords(const GeomModel & model, const VertexNumbering & numbering, int dim)
 {
+    auto n_nodes = numbering.n_vertices;
     std::vector<double> x, y, z;
-    int n_nodes = pnt_map.size();
     if (dim >= 1)
         x.resize(n_nodes);
     if (dim >= 2)
         y.resize(n_nodes);
     if (dim >= 3)
         z.resize(n_nodes);
-    for (const auto & [vtx, id] : pnt_map) {
-        auto pt = vtx->point();
+    auto store = [&](const MeshVertexAbstract & vtx) {
+        auto id = numbering.index(vtx);
+        auto pt = vtx.point();
         if (dim >= 1)
             x[id] = pt.x;
         if (dim >= 2)
             y[id] = pt.y;
         if (dim >= 3)
             z[id] = pt.z;
-    }
-    return { x, y, z };
-}
-
-VertexIdMap
-build_points(const GeomModel & model)
-{
-    VertexIdMap pnts;
-    Index gid = 0;
-
-    for (const auto & [id, v] : model.vertices()) {
-        auto [_, inserted] = pnts.try_emplace(v, gid);
-        if (inserted)
-            gid++;
-    }
+    };
+    for (const auto & [id, v] : model.vertices())
+        store(*v);
     for (const auto & [id, curve] : model.curves())
-        for (auto & v : curve->curve_vertices()) {
-            auto [_, inserted] = pnts.try_emplace(v, gid);
-            if (inserted)
-                gid++;
-        }
+        for (auto & v : curve->curve_vertices())
+            store(*v);
     for (const auto & [id, surface] : model.surfaces())
-        for (auto & v : surface->surface_vertices()) {
-            auto [_, inserted] = pnts.try_emplace(v, gid);
-            if (inserted)
-                gid++;
-        }
-    return pnts;
+        for (auto & v : surface->surface_vertices())
+            store(*v);
+    return { x, y, z };
 }
 
 template <int N>
 std::array<Index, N>
-elem2idxs(const MeshElement & mesh_elem, const VertexIdMap & pnt_map)
+elem2idxs(const MeshElement & mesh_elem, const VertexNumbering & numbering)
 {
     std::array<Index, N> idxs;
-    for (int i = 0; i < N; ++i) {
-        auto vtx = mesh_elem.vertex(i);
-        idxs[i] = pnt_map.at(vtx);
-    }
+    auto vtxs = mesh_elem.vertices();
+    for (int i = 0; i < N; ++i)
+        idxs[i] = numbering.index(*vtxs[i]);
     return idxs;
 }
 
 std::tuple<BlocksMap, NamesMap>
-build_1d_blocks(const GeomModel & model, const VertexIdMap & pnt_map)
+build_1d_blocks(const GeomModel & model, const VertexNumbering & numbering)
 {
     Log::debug("Building 1D elements");
 
@@ -220,7 +205,7 @@ build_1d_blocks(const GeomModel & model, const VertexIdMap & pnt_map)
     for (const auto & [id, curve] : model.curves()) {
         auto blk_id = curve->marker().value();
         for (const auto & mseg : curve->segments()) {
-            auto line = elem2idxs<Line2::N_VERTICES>(mseg, pnt_map);
+            auto line = elem2idxs<Line2::N_VERTICES>(mseg, numbering);
             blocks[blk_id].emplace_back(Element::Line2(line));
         }
         names[blk_id] = model.block_name(blk_id);
@@ -229,7 +214,7 @@ build_1d_blocks(const GeomModel & model, const VertexIdMap & pnt_map)
 }
 
 std::tuple<BlocksMap, NamesMap>
-build_2d_blocks(const GeomModel & model, const VertexIdMap & pnt_map)
+build_2d_blocks(const GeomModel & model, const VertexNumbering & numbering)
 {
     Log::debug("Building 2D elements");
 
@@ -241,14 +226,14 @@ build_2d_blocks(const GeomModel & model, const VertexIdMap & pnt_map)
         auto quads = surface->quadrangles();
         if (not tris.empty() and quads.empty()) {
             for (auto & mt : tris) {
-                auto tri = elem2idxs<Tri3::N_VERTICES>(mt, pnt_map);
+                auto tri = elem2idxs<Tri3::N_VERTICES>(mt, numbering);
                 blocks[blk_id].emplace_back(Element::Tri3(tri));
             }
             names[blk_id] = model.block_name(blk_id);
         }
         else if (not quads.empty() and tris.empty()) {
             for (auto & mq : quads) {
-                auto quad = elem2idxs<Quad4::N_VERTICES>(mq, pnt_map);
+                auto quad = elem2idxs<Quad4::N_VERTICES>(mq, numbering);
                 blocks[blk_id].emplace_back(Element::Quad4(quad));
             }
             names[blk_id] = model.block_name(blk_id);
@@ -261,7 +246,7 @@ build_2d_blocks(const GeomModel & model, const VertexIdMap & pnt_map)
 }
 
 std::tuple<BlocksMap, NamesMap>
-build_3d_blocks(const GeomModel & model, const VertexIdMap & pnt_map)
+build_3d_blocks(const GeomModel & model, const VertexNumbering & numbering)
 {
     Log::debug("Building 3D elements");
 
@@ -271,7 +256,7 @@ build_3d_blocks(const GeomModel & model, const VertexIdMap & pnt_map)
         auto blk_id = volume->marker().value();
         auto tets = volume->tetrahedra();
         for (const auto & mt : tets) {
-            auto tetra = elem2idxs<Tetra4::N_VERTICES>(mt, pnt_map);
+            auto tetra = elem2idxs<Tetra4::N_VERTICES>(mt, numbering);
             blocks[blk_id].emplace_back(Element::Tetra4(tetra));
         }
         names[blk_id] = model.block_name(blk_id);
@@ -280,20 +265,22 @@ build_3d_blocks(const GeomModel & model, const VertexIdMap & pnt_map)
 }
 
 std::tuple<BlocksMap, NamesMap>
-build_blocks(const GeomModel & model, const VertexIdMap & pnt_map, int dim)
+build_blocks(const GeomModel & model, const VertexNumbering & numbering, int dim)
 {
     if (dim == 1)
-        return build_1d_blocks(model, pnt_map);
+        return build_1d_blocks(model, numbering);
     else if (dim == 2)
-        return build_2d_blocks(model, pnt_map);
+        return build_2d_blocks(model, numbering);
     else if (dim == 3)
-        return build_3d_blocks(model, pnt_map);
+        return build_3d_blocks(model, numbering);
     else
         throw Exception("Unsupported dimension {}", dim);
 }
 
 std::tuple<SideSetMap, NamesMap>
-build_side_sets_1d(const GeomModel & model, const BlocksMap & blocks, const VertexIdMap & pnt_map)
+build_side_sets_1d(const GeomModel & model,
+                   const VertexNumbering & numbering,
+                   const BlocksMap & blocks)
 {
     SideSetMap side_sets;
     NamesMap names;
@@ -317,7 +304,7 @@ build_side_sets_1d(const GeomModel & model, const BlocksMap & blocks, const Vert
             Marker side_set_id = marker.value();
             names[side_set_id] = model.side_set_name(side_set_id);
 
-            Index vertex_gidx = pnt_map.at(vertex);
+            Index vertex_gidx = numbering.index(*vertex);
 
             const auto & a_elements = vertex_to_elements_map.find(vertex_gidx);
             if (a_elements != vertex_to_elements_map.end()) {
@@ -347,7 +334,9 @@ build_side_sets_1d(const GeomModel & model, const BlocksMap & blocks, const Vert
 }
 
 std::tuple<SideSetMap, NamesMap>
-build_side_sets_2d(const GeomModel & model, const BlocksMap & blocks, const VertexIdMap & pnt_map)
+build_side_sets_2d(const GeomModel & model,
+                   const VertexNumbering & numbering,
+                   const BlocksMap & blocks)
 {
     SideSetMap side_sets;
     NamesMap names;
@@ -380,11 +369,8 @@ build_side_sets_2d(const GeomModel & model, const BlocksMap & blocks, const Vert
         names[side_set_id] = model.side_set_name(side_set_id);
 
         for (const auto & mseg : curve->segments()) {
-            auto v0_ptr = mseg.vertex(0);
-            auto v1_ptr = mseg.vertex(1);
-
-            Index v0_id = pnt_map.at(v0_ptr);
-            Index v1_id = pnt_map.at(v1_ptr);
+            Index v0_id = numbering.index(*mseg.vertex(0));
+            Index v1_id = numbering.index(*mseg.vertex(1));
 
             const auto & elements_of_v0 = vertex_to_elements_map[v0_id];
 
@@ -445,20 +431,20 @@ build_side_sets_2d(const GeomModel & model, const BlocksMap & blocks, const Vert
 
 std::tuple<SideSetMap, NamesMap>
 build_side_sets(const GeomModel & model,
+                const VertexNumbering & numbering,
                 const BlocksMap & blocks,
-                const VertexIdMap & pnt_map,
                 int dim)
 {
     if (dim == 1)
-        return build_side_sets_1d(model, blocks, pnt_map);
+        return build_side_sets_1d(model, numbering, blocks);
     else if (dim == 2)
-        return build_side_sets_2d(model, blocks, pnt_map);
+        return build_side_sets_2d(model, numbering, blocks);
     else
         throw Exception("Building side sets in {}-D is not supported yet", dim);
 }
 
 std::tuple<NodeSetMap, NamesMap>
-build_node_sets(const GeomModel & model, const VertexIdMap & pnt_map)
+build_node_sets(const GeomModel & model, const VertexNumbering & numbering)
 {
     NodeSetMap node_sets;
     NamesMap names;
@@ -468,7 +454,7 @@ build_node_sets(const GeomModel & model, const VertexIdMap & pnt_map)
         if (marker.has_value()) {
             auto ns_id = marker.value();
             auto & node_set = node_sets[ns_id];
-            node_set.emplace_back(pnt_map.at(vertex) + 1);
+            node_set.emplace_back(numbering.index(*vertex) + 1);
 
             names[ns_id] = model.node_set_name(ns_id);
         }
@@ -507,21 +493,6 @@ element_type(const std::string & elem_type_name)
         throw std::runtime_error("Unsupported element type: " + elem_type_name);
 }
 
-/// Construct krado element connectivity from ExodusII element connectivity
-///
-/// @param connect Element connectivity (ExodusII)
-/// @param n_elem_nodes Number of nodes per element
-/// @return Element vertex indices (krado)
-std::vector<Index>
-build_element(const int * connect, int n_elem_nodes)
-{
-    std::vector<Index> elem_connect(n_elem_nodes);
-    // krado local vertex indices match ExodusII local vertex indices (they just start from 0)
-    for (int i = 0; i < n_elem_nodes; ++i, ++connect)
-        elem_connect[i] = *connect - 1;
-    return elem_connect;
-}
-
 /// Get krado local side index
 ///
 /// @param et Element type
@@ -553,151 +524,180 @@ local_side_index(ElementType et, int idx)
     }
 }
 
-// Helpers for building things from `Mesh`
+// Helpers for writing `Mesh`
 
-std::tuple<std::vector<double>, std::vector<double>, std::vector<double>>
-build_coords(const Mesh & mesh, int dim)
-{
-    std::vector<double> x, y, z;
-    auto n_nodes = mesh.points().size();
-    if (dim >= 1) {
-        x.reserve(n_nodes);
-        for (const auto & pt : mesh.points())
-            x.push_back(pt.x);
-    }
-    if (dim >= 2) {
-        y.reserve(n_nodes);
-        for (const auto & pt : mesh.points())
-            y.push_back(pt.y);
-    }
-    if (dim >= 3) {
-        z.reserve(n_nodes);
-        for (const auto & pt : mesh.points())
-            z.push_back(pt.z);
-    }
-    return { x, y, z };
-}
+/// Element block of a mesh
+struct MeshBlock {
+    /// Block ID
+    Marker id;
+    /// Cells in the block
+    Span<const Index> cells;
+};
 
-std::tuple<BlocksMap, NamesMap>
-build_blocks(const Mesh & mesh, std::map<Index, int> & exii_elem_ids)
+/// Collect element blocks of a mesh
+///
+/// Blocks refer to cell IDs stored in the mesh (or in `cells_by_type`), cells are not copied.
+///
+/// @param mesh Mesh object
+/// @param cells_by_type Cell IDs grouped by element type, used when the mesh has no cell sets
+/// @param exii_elem_ids [out] ExodusII element number of every cell (0 if the cell is not in any
+///        block)
+/// @return Element blocks in the order they are written into the file
+std::vector<MeshBlock>
+collect_blocks(const Mesh & mesh,
+               std::map<ElementType, std::vector<Index>> & cells_by_type,
+               std::vector<int> & exii_elem_ids)
 {
-    BlocksMap blocks;
-    NamesMap names;
-
+    std::vector<MeshBlock> blocks;
+    Index n_elems = mesh.num_elements();
     if (mesh.cell_set_ids().empty()) {
-        std::unordered_map<ElementType, std::size_t> elem_blks_size;
-        for (Index cell_id = 0; cell_id < mesh.elements().size(); ++cell_id) {
-            auto et = mesh.element(cell_id).type();
-            elem_blks_size[et]++;
-        }
-        std::map<ElementType, std::vector<Index>> elem_blks;
-        for (auto & [et, size] : elem_blks_size)
-            elem_blks[et].reserve(size);
-        int exii_idx = 1;
-        for (Index cell_id = 0; cell_id < mesh.elements().size(); ++cell_id) {
-            exii_elem_ids[cell_id] = exii_idx++;
-            const auto & cell = mesh.element(cell_id);
-            auto et = cell.type();
-            elem_blks[et].push_back(cell_id);
-        }
-
-        int blk_id = 1;
-        for (auto & [blk_type, elems] : elem_blks) {
-            if (!elems.empty()) {
-                auto & block = blocks[blk_id];
-                block.reserve(elems.size());
-                for (auto & cell_id : elems) {
-                    const auto & el = mesh.element(cell_id);
-                    block.push_back(el);
-                }
-                blk_id++;
-            }
-        }
+        std::map<ElementType, std::size_t> n_cells;
+        for (Index cell_id = 0; cell_id < n_elems; ++cell_id)
+            n_cells[mesh.element_type(cell_id)]++;
+        for (auto & [et, n] : n_cells)
+            cells_by_type[et].reserve(n);
+        for (Index cell_id = 0; cell_id < n_elems; ++cell_id)
+            cells_by_type[mesh.element_type(cell_id)].push_back(cell_id);
+
+        Marker blk_id = 1;
+        for (auto & [et, cells] : cells_by_type)
+            blocks.push_back({ blk_id++, Span<const Index>(cells) });
     }
     else {
         // NOTE: krado allows to have different cell types in a single cell set, but not
         // exodusII. So, we need to filter on both cell set id and cell type, i.e. put all cells
-        // of the same type in the same block. Currently, we just assume cell sets are
-        // homogeneous in terms of cell type.
-
-        int exii_idx = 1;
-        auto cell_set_ids = mesh.cell_set_ids();
-        for (auto & blk_id : cell_set_ids) {
-            auto elem_ids = mesh.cell_set(blk_id);
-            if (!elem_ids.empty()) {
-                auto & block = blocks[blk_id];
-                block.reserve(elem_ids.size());
-                for (const auto & id : elem_ids) {
-                    exii_elem_ids[id] = exii_idx++;
-                    const auto & el = mesh.element(id);
-                    block.push_back(el);
-                }
-                auto cs_name = mesh.cell_set_name(blk_id);
-                if (cs_name.has_value())
-                    names[blk_id] = cs_name.value();
-            }
+        // of the same type in the same block. Currently, we require cell sets to be homogeneous
+        // in terms of cell type.
+        for (auto & blk_id : mesh.cell_set_ids()) {
+            auto cells = mesh.cell_set(blk_id);
+            if (!cells.empty())
+                blocks.push_back({ blk_id, cells });
         }
     }
 
-    return { blocks, names };
+    // ExodusII numbers elements in the order they are written
+    exii_elem_ids.assign(n_elems, 0);
+    int exii_idx = 1;
+    for (auto & blk : blocks)
+        for (auto cell_id : blk.cells)
+            exii_elem_ids[cell_id] = exii_idx++;
+    return blocks;
 }
 
-/// Create side set
+/// Write element blocks of a mesh
+///
+/// Connectivity is built one block at a time into a single buffer that is reused between blocks.
 ///
+/// @param exo ExodusII file
 /// @param mesh Mesh object
-/// @param elem_ids Face or edge IDs
-/// @param exii_elem_ids Map that converts from krado cell IDs to exodus element numbers
-SideSet
-create_side_set(const Mesh & mesh,
-                Span<const SideEntry> side_entries,
-                const std::map<Index, int> & exii_elem_ids)
+/// @param blocks Element blocks
+void
+write_element_blocks(exodusIIcpp::File & exo,
+                     const Mesh & mesh,
+                     const std::vector<MeshBlock> & blocks)
 {
-    SideSet side_set;
-    auto n = side_entries.size();
-    side_set.elems.reserve(n);
-    side_set.sides.reserve(n);
-    for (const auto & [cell, side] : side_entries) {
-        side_set.elems.push_back(exii_elem_ids.at(cell));
-        auto et = mesh.element_type(cell);
-        side_set.sides.push_back(exII::local_side_index(et, side));
+    std::vector<std::string> blk_names;
+    std::vector<int> connect;
+    for (const auto & [blk_id, cells] : blocks) {
+        auto et = mesh.element_type(cells[0]);
+        std::size_t n_elem_nodes = mesh.element(cells[0]).num_vertices();
+        connect.resize(cells.size() * n_elem_nodes);
+        parallel_for(cells.size(), [&](std::size_t i) {
+            auto cell = mesh.element(cells[i]);
+            if (cell.type() != et)
+                throw Exception("Element block {} has elements of different types", blk_id);
+            for (std::size_t j = 0; j < n_elem_nodes; ++j)
+                connect[i * n_elem_nodes + j] = cell.index(j) + 1;
+        });
+        exo.write_block(blk_id, exII::element_name(et), cells.size(), connect);
+
+        auto name = mesh.cell_set_name(blk_id);
+        blk_names.push_back(name.has_value() ? name.value() : fmt::format("{}", blk_id));
     }
-    return side_set;
+
+    if (!blk_names.empty())
+        exo.write_block_names(blk_names);
 }
 
-std::tuple<SideSetMap, NamesMap>
-build_side_sets(const Mesh & mesh, const std::map<Index, int> & exii_elem_ids)
+/// Write side sets of a mesh
+///
+/// @param exo ExodusII file
+/// @param mesh Mesh object
+/// @param exii_elem_ids ExodusII element number of every cell
+void
+write_side_sets(exodusIIcpp::File & exo,
+                const Mesh & mesh,
+                const std::vector<int> & exii_elem_ids)
 {
-    SideSetMap side_sets;
-    NamesMap names;
+    std::vector<std::string> side_set_names;
+    std::vector<int> elems;
+    std::vector<int> sides;
     for (auto & id : mesh.side_set_ids()) {
-        side_sets[id] = create_side_set(mesh, mesh.side_set(id), exii_elem_ids);
         auto ss_name = mesh.side_set_name(id);
-        if (ss_name.has_value())
-            names[id] = ss_name.value();
+        auto name = ss_name.has_value() ? ss_name.value() : fmt::format("{}", id);
+        auto side_entries = mesh.side_set(id);
+        if (side_entries.empty()) {
+            Log::warn("Side set '{}' is empty", name);
+            continue;
+        }
+
+        elems.resize(side_entries.size());
+        sides.resize(side_entries.size());
+        parallel_for(side_entries.size(), [&](std::size_t i) {
+            auto [cell, side] = side_entries[i];
+            elems[i] = exii_elem_ids[cell];
+            if (elems[i] == 0)
+                throw Exception("Side set '{}' refers to element {} which is not in any block",
+                                name,
+                                cell);
+            sides[i] = exII::local_side_index(mesh.element_type(cell), side);
+        });
+        exo.write_side_set(id, elems, sides);
+        side_set_names.push_back(name);
     }
-    return { side_sets, names };
+
+    if (!side_set_names.empty())
+        exo.write_side_set_names(side_set_names);
 }
 
-std::tuple<NodeSetMap, NamesMap>
-build_node_sets(const Mesh & mesh)
+/// Write node sets of a mesh
+///
+/// @param exo ExodusII file
+/// @param mesh Mesh object
+void
+write_node_sets(exodusIIcpp::File & exo, const Mesh & mesh)
 {
-    NodeSetMap node_sets;
-    NamesMap names;
-
-    auto set_ids = mesh.node_set_ids();
-    for (auto & id : set_ids) {
-        auto vtx_ids = mesh.node_set(id);
-        auto n = vtx_ids.size();
-        auto & nodes = node_sets[id];
-        nodes.reserve(n);
-        for (const auto & v : vtx_ids)
-            nodes.push_back(v + 1);
+    std::vector<std::string> node_set_names;
+    std::vector<int> nodes;
+    for (auto & id : mesh.node_set_ids()) {
         auto ns_name = mesh.node_set_name(id);
-        if (ns_name.has_value())
-            names[id] = ns_name.value();
+        auto name = ns_name.has_value() ? ns_name.value() : fmt::format("{}", id);
+        auto vtx_ids = mesh.node_set(id);
+        if (vtx_ids.empty()) {
+            Log::warn("Node set '{}' is empty", name);
+            continue;
+        }
+
+        nodes.resize(vtx_ids.size());
+        parallel_for(vtx_ids.size(), [&](std::size_t i) { nodes[i] = vtx_ids[i] + 1; });
+        exo.write_node_set(id, nodes);
+        node_set_names.push_back(name);
     }
 
-    return { node_sets, names };
+    if (!node_set_names.empty())
+        exo.write_node_set_names(node_set_names);
+}
+
+/// Count non-empty sets
+///
+/// @param ids Set IDs
+/// @param set Function returning the set with a given ID
+/// @return Number of non-empty sets
+template <typename FN>
+int
+count_non_empty(const std::vector<Marker> & ids, FN set)
+{
+    return std::count_if(ids.begin(), ids.end(), [&](Marker id) { return !set(id).empty(); });
 }
 
 std::vector<SideEntry>
@@ -718,10 +718,8 @@ build_side_set(const Mesh & mesh, const SideSet & side_set)
 std::vector<Index>
 build_node_set(const NodeSet & ns)
 {
-    std::vector<Index> vertex_ids;
-    vertex_ids.reserve(ns.size());
-    for (const auto & id : ns)
-        vertex_ids.push_back(id - 1);
+    std::vector<Index> vertex_ids(ns.size());
+    parallel_for(ns.size(), [&](std::size_t i) { vertex_ids[i] = ns[i] - 1; });
     return vertex_ids;
 }
 
@@ -824,65 +822,69 @@ write_node_sets(exodusIIcpp::File & exo, const NodeSetMap & node_sets, const Nam
 
 /// Read nodes
 ///
-/// @return Vector of points
-std::vector<Point>
+/// @return Point coordinates
+Coordinates
 read_points(exodusIIcpp::File & exo)
 {
-    std::vector<Point> points;
-
     exo.read_coords();
     int dim = exo.get_dim();
-    int n_nodes = exo.get_num_nodes();
-    points.reserve(n_nodes);
-    if (dim == 1) {
-        auto x = exo.get_x_coords();
-        for (auto i = 0; i < n_nodes; i++)
-            points.emplace_back(x[i]);
-    }
-    else if (dim == 2) {
-        auto x = exo.get_x_coords();
-        auto y = exo.get_y_coords();
-        for (auto i = 0; i < n_nodes; i++)
-            points.emplace_back(x[i], y[i]);
-    }
-    else if (dim == 3) {
-        auto x = exo.get_x_coords();
-        auto y = exo.get_y_coords();
-        auto z = exo.get_z_coords();
-        for (auto i = 0; i < n_nodes; i++)
-            points.emplace_back(x[i], y[i], z[i]);
-    }
-    return points;
+    auto n_nodes = static_cast<std::size_t>(exo.get_num_nodes());
+    // coordinate arrays are taken over as they are, missing dimensions are zero
+    std::vector<double> x = dim >= 1 ? exo.get_x_coords() : std::vector<double>(n_nodes, 0.);
+    std::vector<double> y = dim >= 2 ? exo.get_y_coords() : std::vector<double>(n_nodes, 0.);
+    std::vector<double> z = dim >= 3 ? exo.get_z_coords() : std::vector<double>(n_nodes, 0.);
+    return Coordinates(std::move(x), std::move(y), std::move(z));
 }
 
 /// Read elements
 ///
-/// @return Vector of elements
-std::tuple<std::vector<Element>, std::map<int, std::vector<Index>>>
+/// Connectivity of every block is converted straight into the compressed row storage of the mesh
+///
+/// @return Element connectivity and a cell set per element block
+std::tuple<Connectivity, std::map<Marker, std::vector<Index>>>
 read_elements(exodusIIcpp::File & exo)
 {
     exo.read_blocks();
-
-    int n = 0;
-    for (const auto & eb : exo.get_element_blocks())
-        n += eb.get_num_elements();
-    std::vector<Element> elems;
-    elems.reserve(n);
-
-    std::map<int, std::vector<Index>> cell_sets;
-    for (const auto & eb : exo.get_element_blocks()) {
+    const auto & blocks = exo.get_element_blocks();
+
+    // where elements and vertex IDs of each block start
+    std::vector<std::size_t> elem_ofst(blocks.size() + 1, 0);
+    std::vector<std::size_t> id_ofst(blocks.size() + 1, 0);
+    for (std::size_t b = 0; b < blocks.size(); ++b) {
+        std::size_t n_elems = blocks[b].get_num_elements();
+        std::size_t n_elem_nodes = blocks[b].get_num_nodes_per_element();
+        elem_ofst[b + 1] = elem_ofst[b] + n_elems;
+        id_ofst[b + 1] = id_ofst[b] + n_elems * n_elem_nodes;
+    }
+    if (id_ofst.back() > std::numeric_limits<Index>::max())
+        throw Exception("Connectivity is too large ({} vertex indices)", id_ofst.back());
+
+    std::vector<ElementType> types(elem_ofst.back());
+    std::vector<Index> offsets(elem_ofst.back() + 1, 0);
+    std::vector<Index> ids(id_ofst.back());
+    std::map<Marker, std::vector<Index>> cell_sets;
+    for (std::size_t b = 0; b < blocks.size(); ++b) {
+        const auto & eb = blocks[b];
         auto et = element_type(eb.get_element_type());
         const auto & connect = eb.get_connectivity();
-        auto n_elem_nodes = eb.get_num_nodes_per_element();
-        auto blk_id = eb.get_id();
-        for (int i = 0; i < eb.get_num_elements(); i++) {
-            auto idx = i * n_elem_nodes;
-            cell_sets[blk_id].push_back(elems.size());
-            elems.emplace_back(et, build_element(connect.data() + idx, n_elem_nodes));
-        }
+        std::size_t n_elem_nodes = eb.get_num_nodes_per_element();
+        auto & cell_set = cell_sets[eb.get_id()];
+        auto first = cell_set.size();
+        cell_set.resize(first + eb.get_num_elements());
+        // krado local vertex indices match ExodusII local vertex indices (they just start from 0)
+        parallel_for(eb.get_num_elements(), [&](std::size_t i) {
+            auto e = elem_ofst[b] + i;
+            auto k = id_ofst[b] + i * n_elem_nodes;
+            types[e] = et;
+            offsets[e + 1] = k + n_elem_nodes;
+            for (std::size_t j = 0; j < n_elem_nodes; ++j)
+                ids[k + j] = connect[i * n_elem_nodes + j] - 1;
+            cell_set[first + i] = e;
+        });
     }
 
-    return { elems, cell_sets };
+    Connectivity elems(std::move(types), std::move(offsets), std::move(ids));
+    return { std::move(elems), std::move(cell_sets) };
 }
 
 /// Read side sets
@@ -928,7 +930,56 @@ read_node_sets(exodusIIcpp::File & exo)
 
 //
 
-ExodusIIFile::ExodusIIFile(const std::filesystem::path & file_name) : fn_(file_name.string()) {}
+ExodusIIFile::ExodusIIFile(const std::filesystem::path & file_name) :
+    ExodusIIFile(file_name, Options())
+{
+}
+
+ExodusIIFile::ExodusIIFile(const std::filesystem::path & file_name, const Options & opts) :
+    fn_(file_name.string()),
+    opts_(opts)
+{
+    if (this->opts_.format != Format::NETCDF4) {
+        if (this->opts_.compression != Compression::NONE)
+            throw Exception("Compression requires NetCDF-4 format");
+        if (this->opts_.int64)
+            throw Exception("64-bit integers require NetCDF-4 format");
+    }
+    auto level = this->opts_.compression_level;
+    if (this->opts_.compression == Compression::ZLIB && (level < 1 || level > 9))
+        throw Exception("Deflate compression level must be between 1 and 9, got {}", level);
+    if (this->opts_.compression == Compression::SZIP &&
+        (level < 4 || level > 32 || level % 2 != 0))
+        throw Exception("Szip pixels per block must be an even number between 4 and 32, got {}",
+                        level);
+}
+
+void
+ExodusIIFile::create()
+{
+#ifdef KRADO_WITH_EXODUSII_NETCDF4
+    int mode = EX_CLOBBER;
+    mode |= this->opts_.format == Format::NETCDF4 ? EX_NETCDF4 : EX_64BIT_OFFSET;
+    // only the storage is 64-bit, the API keeps using 32-bit integers and exodus converts them
+    if (this->opts_.int64)
+        mode |= EX_ALL_INT64_DB;
+    this->exo_.create(this->fn_, mode);
+
+    if (this->opts_.compression != Compression::NONE) {
+        auto exoid = this->exo_.get_exodus_id();
+        auto type = this->opts_.compression == Compression::ZLIB ? EX_COMPRESS_ZLIB
+                                                                   : EX_COMPRESS_SZIP;
+        ex_set_option(exoid, EX_OPT_COMPRESSION_TYPE, type);
+        ex_set_option(exoid, EX_OPT_COMPRESSION_LEVEL, this->opts_.compression_level);
+        ex_set_option(exoid, EX_OPT_COMPRESSION_SHUFFLE, this->opts_.shuffle ? 1 : 0);
+    }
+#else
+    // compression and 64-bit integers need NetCDF-4, which needs a file mode
+    if (this->opts_.format == Format::NETCDF4)
+        throw Exception("Writing NetCDF-4 ExodusII files is not supported by this build");
+    this->exo_.create(this->fn_);
+#endif
+}
 
 Ptr<Mesh>
 ExodusIIFile::read()
@@ -944,27 +995,23 @@ ExodusIIFile::read()
     auto [side_sets, side_set_names] = read_side_sets(this->exo_);
     auto [node_sets, node_set_names] = read_node_sets(this->exo_);
 
-    auto mesh = Ptr<Mesh>::alloc(pnts, elems);
+    auto mesh = Ptr<Mesh>::alloc(std::move(pnts), std::move(elems));
     for (auto & [id, cs] : cell_sets)
-        mesh->set_cell_set(id, cs);
+        mesh->set_cell_set(id, std::move(cs));
     for (auto & [id, name] : cell_set_names)
         if (!name.empty())
             mesh->set_cell_set_name(id, name);
 
     // side sets
-    for (auto & [id, sides] : side_sets) {
-        auto sset = build_side_set(*mesh, sides);
-        mesh->set_side_set(id, sset);
-    }
+    for (auto & [id, sides] : side_sets)
+        mesh->set_side_set(id, build_side_set(*mesh, sides));
     for (auto & [id, name] : side_set_names)
         if (!name.empty())
             mesh->set_side_set_name(id, name);
 
     // node sets
-    for (auto & [id, ns] : node_sets) {
-        auto node_ids = build_node_set(ns);
-        mesh->set_node_set(id, node_ids);
-    }
+    for (auto & [id, ns] : node_sets)
+        mesh->set_node_set(id, build_node_set(ns));
     for (auto & [id, name] : node_set_names)
         if (!name.empty())
             mesh->set_node_set_name(id, name);
@@ -978,28 +1025,42 @@ ExodusIIFile::write(Ptr<const Mesh> mesh)
     Log::info("Writing ExodusII file '{}'", this->fn_);
     LoggingTimer timer;
 
-    this->exo_.create(this->fn_);
+    // counts and IDs go through the 32-bit API, even if they are stored as 64-bit integers
+    const std::size_t max_size = std::numeric_limits<int>::max();
+    if (mesh->num_points() > max_size || mesh->num_elements() > max_size)
+        throw Exception("Mesh is too large for ExodusII ({} points, {} elements), at most {} of "
+                        "each can be written",
+                        mesh->num_points(),
+                        mesh->num_elements(),
+                        max_size);
+
+    this->create();
     auto bbox = compute_bounding_box(mesh);
     auto dim = determine_spatial_dim(bbox);
 
-    auto [x, y, z] = build_coords(*mesh, dim);
-    std::map<Index, int> exii_elem_ids;
-    auto [blocks, block_names] = build_blocks(*mesh, exii_elem_ids);
-    auto [side_sets, side_set_names] = build_side_sets(*mesh, exii_elem_ids);
-    auto [node_sets, node_set_names] = build_node_sets(*mesh);
+    // blocks only hold cell IDs, connectivity and sets are converted one at a time while writing
+    std::map<ElementType, std::vector<Index>> cells_by_type;
+    std::vector<int> exii_elem_ids;
+    auto blocks = collect_blocks(*mesh, cells_by_type, exii_elem_ids);
 
     auto n_nodes = static_cast<int>(mesh->points().size());
-    auto n_elems = static_cast<int>(mesh->elements().size());
+    int n_elems = 0;
+    for (auto & blk : blocks)
+        n_elems += blk.cells.size();
     int n_elem_blks = blocks.size();
-    int n_node_sets = node_sets.size();
-    int n_side_sets = side_sets.size();
+    int n_node_sets =
+        count_non_empty(mesh->node_set_ids(), [&](Marker id) { return mesh->node_set(id); });
+    int n_side_sets =
+        count_non_empty(mesh->side_set_ids(), [&](Marker id) { return mesh->side_set(id); });
     this->exo_.init("", dim, n_nodes, n_elems, n_elem_blks, n_node_sets, n_side_sets);
 
     write_info(this->exo_);
-    write_coords(this->exo_, dim, x, y, z);
-    write_element_blocks(this->exo_, blocks, block_names);
-    write_side_sets(this->exo_, side_sets, side_set_names);
-    write_node_sets(this->exo_, node_sets, node_set_names);
+    // coordinates are stored as separate arrays, so they are written without copying
+    const auto & coords = mesh->coordinates();
+    write_coords(this->exo_, dim, coords.x(), coords.y(), coords.z());
+    write_element_blocks(this->exo_, *mesh, blocks);
+    write_side_sets(this->exo_, *mesh, exii_elem_ids);
+    write_node_sets(this->exo_, *mesh);
 
     Log::info(
         "- {}D, {} node(s), {} element(s), {} element block(s), {} node set(s), {} side set(s)",
@@ -1017,18 +1078,17 @@ ExodusIIFile::write(const GeomModel & model)
     Log::info("Writing ExodusII file '{}'", this->fn_);
     LoggingTimer timer;
 
-    this->exo_.create(this->fn_);
+    this->create();
 
     auto bbox = compute_bounding_box(model);
     auto dim = determine_spatial_dim(bbox);
 
-    auto pnt_map = build_points(model);
-    auto [x, y, z] = build_coords(pnt_map, dim);
-    auto [blocks, block_names] = build_blocks(model, pnt_map, dim);
-    auto [side_sets, side_set_names] = build_side_sets(model, blocks, pnt_map, dim);
-    auto [node_sets, node_set_names] = build_node_sets(model, pnt_map);
-
-    int n_nodes = pnt_map.size();
+    auto numbering = number_vertices(model);
+    int n_nodes = numbering.n_vertices;
+    auto [x, y, z] = build_coords(model, numbering, dim);
+    auto [blocks, block_names] = build_blocks(model, numbering, dim);
+    auto [side_sets, side_set_names] = build_side_sets(model, numbering, blocks, dim);
+    auto [node_sets, node_set_names] = build_node_sets(model, numbering);
     int n_elems = 0;
     for (auto & [marker, blk] : blocks)
         n_elems += blk.size();
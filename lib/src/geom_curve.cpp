@@ -17,6 +17,8 @@
 #include "Geom_BezierCurve.hxx"
 #include "Geom_Line.hxx"
 #include "Geom_Circle.hxx"
+#include <algorithm>
+#include <cmath>
 
 namespace krado {
 namespace {
@@ -37,7 +39,8 @@ get_oriented_edge(const TopoDS_Edge & edge)
 GeomCurve::GeomCurve(const TopoDS_Edge & edge) :
     GeomShape(get_oriented_edge(edge)),
     umin_(0),
-    umax_(0)
+    umax_(0),
+    radius_(0)
 {
     const auto & edge1 = TopoDS::Edge(this->shape_);
     this->curve_ = BRep_Tool::Curve(edge1, this->umin_, this->umax_);
@@ -45,10 +48,21 @@ GeomCurve::GeomCurve(const TopoDS_Edge & edge) :
         this->crv_type_ = CurveType::BSpline;
     else if (this->curve_->DynamicType() == STANDARD_TYPE(Geom_BezierCurve))
         this->crv_type_ = CurveType::Bezier;
-    else if (this->curve_->DynamicType() == STANDARD_TYPE(Geom_Line))
+    else if (this->curve_->DynamicType() == STANDARD_TYPE(Geom_Line)) {
         this->crv_type_ = CurveType::Line;
-    else if (this->curve_->DynamicType() == STANDARD_TYPE(Geom_Circle))
+        const auto & line = Handle(Geom_Line)::DownCast(this->curve_)->Lin();
+        this->origin_ = Point::create(line.Location());
+        this->x_dir_ = Vector(line.Direction().X(), line.Direction().Y(), line.Direction().Z());
+    }
+    else if (this->curve_->DynamicType() == STANDARD_TYPE(Geom_Circle)) {
         this->crv_type_ = CurveType::Circle;
+        const auto & circ = Handle(Geom_Circle)::DownCast(this->curve_)->Circ();
+        const auto & ax = circ.Position();
+        this->origin_ = Point::create(ax.Location());
+        this->x_dir_ = Vector(ax.XDirection().X(), ax.XDirection().Y(), ax.XDirection().Z());
+        this->y_dir_ = Vector(ax.YDirection().X(), ax.YDirection().Y(), ax.YDirection().Z());
+        this->radius_ = circ.Radius();
+    }
     else
         this->crv_type_ = CurveType::Unknown;
 }
@@ -85,34 +99,110 @@ GeomCurve::is_degenerated() const
 Point
 GeomCurve::point(double u) const
 {
-    return Point::create(this->curve_->Value(u));
+    Point pt;
+    point(Span<const double>(&u, 1), Span<Point>(&pt, 1));
+    return pt;
 }
 
 Vector
 GeomCurve::d1(double u) const
 {
-    const auto & edge = TopoDS::Edge(this->shape_);
-    BRepAdaptor_Curve brepc(edge);
-    BRepLProp_CLProps prop(brepc, 1, 1e-10);
-    prop.SetParameter(u);
-    gp_Vec d1 = prop.D1();
-    return Vector(d1.X(), d1.Y(), d1.Z());
+    Vector der;
+    d1(Span<const double>(&u, 1), Span<Vector>(&der, 1));
+    return der;
 }
 
 double
 GeomCurve::curvature(double u) const
 {
-    if (is_degenerated())
-        return 0.;
+    double curv;
+    curvature(Span<const double>(&u, 1), Span<double>(&curv, 1));
+    return curv;
+}
 
-    const auto & edge = TopoDS::Edge(this->shape_);
-    BRepAdaptor_Curve brepc(edge);
-    BRepLProp_CLProps prop(brepc, 2, 1e-15);
-    prop.SetParameter(u);
-    if (!prop.IsTangentDefined())
-        return 0.;
-    else
-        return prop.Curvature();
+void
+GeomCurve::point(Span<const double> u, Span<Point> pts) const
+{
+    if (u.size() != pts.size())
+        throw Exception("Expected {} points, got {}", u.size(), pts.size());
+
+    const auto & o = this->origin_;
+    const auto & xd = this->x_dir_;
+    const auto & yd = this->y_dir_;
+    if (this->crv_type_ == CurveType::Line) {
+        for (std::size_t i = 0; i < u.size(); ++i)
+            pts[i] = Point(u[i] * xd.x + o.x, u[i] * xd.y + o.y, u[i] * xd.z + o.z);
+    }
+    else if (this->crv_type_ == CurveType::Circle) {
+        for (std::size_t i = 0; i < u.size(); ++i) {
+            const auto a1 = this->radius_ * std::cos(u[i]);
+            const auto a2 = this->radius_ * std::sin(u[i]);
+            pts[i] = Point(a1 * xd.x + a2 * yd.x + o.x,
+                           a1 * xd.y + a2 * yd.y + o.y,
+                           a1 * xd.z + a2 * yd.z + o.z);
+        }
+    }
+    else {
+        for (std::size_t i = 0; i < u.size(); ++i)
+            pts[i] = Point::create(this->curve_->Value(u[i]));
+    }
+}
+
+void
+GeomCurve::d1(Span<const double> u, Span<Vector> ders) const
+{
+    if (u.size() != ders.size())
+        throw Exception("Expected {} derivatives, got {}", u.size(), ders.size());
+
+    const auto & xd = this->x_dir_;
+    const auto & yd = this->y_dir_;
+    if (this->crv_type_ == CurveType::Line) {
+        for (std::size_t i = 0; i < u.size(); ++i)
+            ders[i] = xd;
+    }
+    else if (this->crv_type_ == CurveType::Circle) {
+        for (std::size_t i = 0; i < u.size(); ++i) {
+            const auto xc = this->radius_ * std::cos(u[i]);
+            const auto yc = this->radius_ * std::sin(u[i]);
+            ders[i] = Vector(xc * yd.x - yc * xd.x, xc * yd.y - yc * xd.y, xc * yd.z - yc * xd.z);
+        }
+    }
+    else {
+        const auto & edge = TopoDS::Edge(this->shape_);
+        BRepAdaptor_Curve brepc(edge);
+        BRepLProp_CLProps prop(brepc, 1, 1e-10);
+        for (std::size_t i = 0; i < u.size(); ++i) {
+            prop.SetParameter(u[i]);
+            const auto & d1 = prop.D1();
+            ders[i] = Vector(d1.X(), d1.Y(), d1.Z());
+        }
+    }
+}
+
+void
+GeomCurve::curvature(Span<const double> u, Span<double> curv) const
+{
+    if (u.size() != curv.size())
+        throw Exception("Expected {} curvatures, got {}", u.size(), curv.size());
+
+    if (is_degenerated())
+        std::fill(curv.begin(), curv.end(), 0.);
+    else if (this->crv_type_ == CurveType::Line)
+        std::fill(curv.begin(), curv.end(), 0.);
+    else if (this->crv_type_ == CurveType::Circle)
+        std::fill(curv.begin(), curv.end(), 1. / this->radius_);
+    else {
+        const auto & edge = TopoDS::Edge(this->shape_);
+        BRepAdaptor_Curve brepc(edge);
+        BRepLProp_CLProps prop(brepc, 2, 1e-15);
+        for (std::size_t i = 0; i < u.size(); ++i) {
+            prop.SetParameter(u[i]);
+            if (!prop.IsTangentDefined())
+                curv[i] = 0.;
+            else
+                curv[i] = prop.Curvature();
+        }
+    }
 }
 
 std::tuple<double, double>
@@ -227,8 +317,7 @@ get_circle_center(const GeomCurve & crv)
     if (crv.type() != GeomCurve::CurveType::Circle)
         throw Exception("Curve is not a circle");
 
-    const Handle(Geom_Circle) & circle = Handle(Geom_Circle)::DownCast(crv.curve_);
-    return Point::create(circle->Location());
+    return crv.origin_;
 }
 
 double
@@ -237,8 +326,7 @@ get_circle_radius(const GeomCurve & crv)
     if (crv.type() != GeomCurve::CurveType::Circle)
         throw Exception("Curve is not a circle");
 
-    const Handle(Geom_Circle) & circle = Handle(Geom_Circle)::DownCast(crv.curve_);
-    return circle->Radius();
+    return crv.radius_;
 }
 
 } // namespace krado
@@ -9,6 +9,7 @@
 #include "krado/scheme2d.h"
 #include "krado/scheme3d.h"
 #include "krado/mesh.h"
+#include "krado/mesh_cache.h"
 #include "krado/mesh_vertex.h"
 #include "krado/mesh_curve.h"
 #include "krado/mesh_curve_vertex.h"
@@ -16,6 +17,8 @@
 #include "krado/mesh_surface_vertex.h"
 #include "krado/mesh_volume.h"
 #include "krado/log.h"
+#include "krado/task_graph.h"
+#include "krado/thread_pool.h"
 #include "krado/timer.h"
 #include "krado/types.h"
 #include "TopExp_Explorer.hxx"
@@ -25,9 +28,77 @@
 #include "TopoDS_Face.hxx"
 #include "TopoDS_Shell.hxx"
 #include "TopoDS_Solid.hxx"
+#include <map>
+#include <set>
 
 namespace krado {
 
+namespace {
+
+/// Entity shared by several meshing tasks, given by its dimension and ID
+using Resource = std::pair<int, ShapeID>;
+
+/// Tracks which meshing tasks must not run at the same time
+///
+/// Tasks with a thread-unsafe scheme run one after another. A task and an earlier task sharing
+/// a resource are ordered if either of them is thread-unsafe, or always if `exclusive` is set.
+class ConflictTracker {
+public:
+    explicit ConflictTracker(bool exclusive) : exclusive_(exclusive) {}
+
+    /// Register a task
+    ///
+    /// @param task Task ID
+    /// @param resources Resources used by the task
+    /// @param thread_safe Is the scheme of the task thread-safe
+    /// @return Earlier tasks the task must wait for
+    std::vector<Index>
+    add(Index task, const std::vector<Resource> & resources, bool thread_safe)
+    {
+        std::vector<Index> deps;
+        if (!thread_safe) {
+            if (this->last_unsafe_.has_value())
+                deps.push_back(this->last_unsafe_.value());
+            this->last_unsafe_ = task;
+        }
+        auto exclusive = this->exclusive_ || !thread_safe;
+        for (auto & r : resources) {
+            auto & users = this->users_[r];
+            if (users.last_exclusive.has_value())
+                deps.push_back(users.last_exclusive.value());
+            if (exclusive) {
+                deps.insert(deps.end(), users.shared.begin(), users.shared.end());
+                users.shared.clear();
+                users.last_exclusive = task;
+            }
+            else
+                users.shared.push_back(task);
+        }
+        return deps;
+    }
+
+private:
+    struct Users {
+        /// Last task that used the resource exclusively
+        Optional<Index> last_exclusive;
+        /// Tasks that shared the resource since then
+        std::vector<Index> shared;
+    };
+
+    bool exclusive_;
+    Optional<Index> last_unsafe_;
+    std::map<Resource, Users> users_;
+};
+
+template <typename ENTITY>
+bool
+is_thread_safe(Ptr<ENTITY> entity)
+{
+    return dynamic_cast<Scheme &>(entity->scheme()).is_thread_safe();
+}
+
+} // namespace
+
 BoundingBox3D
 compute_bounding_box(const GeomModel & model)
 {
@@ -432,7 +503,13 @@ GeomModel::mesh_curve(Ptr<MeshCurve> curve)
                   s.name(),
                   pars_str.empty() ? "" : fmt::format(", {}", pars_str));
         LoggingTimer timer;
-        scheme.mesh_curve(curve);
+        if (this->mesh_cache_ && this->mesh_cache_->load(curve, s))
+            Log::info("- restored from cache");
+        else {
+            scheme.mesh_curve(curve);
+            if (this->mesh_cache_)
+                this->mesh_cache_->store(curve, s);
+        }
     }
     Log::info("- created {} segment(s)", utils::human_number(curve->segments().size()));
 
@@ -468,7 +545,13 @@ GeomModel::mesh_surface(Ptr<MeshSurface> surface)
                   s.name(),
                   pars_str.empty() ? "" : fmt::format(", {}", pars_str));
         LoggingTimer timer;
-        scheme.mesh_surface(surface);
+        if (this->mesh_cache_ && this->mesh_cache_->load(surface, s))
+            Log::info("- restored from cache");
+        else {
+            scheme.mesh_surface(surface);
+            if (this->mesh_cache_)
+                this->mesh_cache_->store(surface, s);
+        }
     }
     if (not surface->triangles().empty())
         Log::info("- created {} triangles(s)", utils::human_number(surface->triangles().size()));
@@ -513,6 +596,125 @@ GeomModel::mesh_volume(Ptr<MeshVolume> volume)
     volume->set_meshed();
 }
 
+void
+GeomModel::mesh_all(bool parallel)
+{
+    Log::info("Meshing model");
+    LoggingTimer timer;
+
+    // pick schemes up front, so that tasks never assign schemes to shared entities
+    std::vector<Ptr<MeshVolume>> volumes;
+    for (auto & [id, vol] : this->mvols_) {
+        if (!vol->has_scheme() || vol->is_meshed())
+            continue;
+        volumes.push_back(vol);
+        for (auto & srf : vol->surfaces())
+            vol->scheme().select_surface_scheme(srf);
+    }
+
+    std::vector<Ptr<MeshSurface>> surfaces;
+    std::set<ShapeID> surface_ids;
+    auto add_surface = [&](Ptr<MeshSurface> srf) {
+        if (srf->is_meshed() || !surface_ids.insert(srf->id()).second)
+            return;
+        surfaces.push_back(srf);
+        for (auto & crv : srf->curves())
+            srf->scheme().select_curve_scheme(crv);
+    };
+    for (auto & vol : volumes)
+        for (auto & srf : vol->surfaces())
+            add_surface(srf);
+    for (auto & [id, srf] : this->msurfs_)
+        if (srf->has_scheme())
+            add_surface(srf);
+
+    std::vector<Ptr<MeshCurve>> curves;
+    std::set<ShapeID> curve_ids;
+    auto add_curve = [&](Ptr<MeshCurve> crv) {
+        if (crv->is_meshed() || !curve_ids.insert(crv->id()).second)
+            return;
+        curves.push_back(crv);
+    };
+    for (auto & srf : surfaces)
+        for (auto & crv : srf->curves())
+            add_curve(crv);
+    for (auto & [id, crv] : this->mcrvs_)
+        if (crv->has_scheme())
+            add_curve(crv);
+
+    // vertices are shared by many curves
+    for (auto & crv : curves)
+        for (auto & vtx : crv->bounding_vertices())
+            mesh_vertex(vtx);
+
+    if (!parallel) {
+        for (auto & crv : curves)
+            mesh_curve(crv);
+        for (auto & srf : surfaces)
+            mesh_surface(srf);
+        for (auto & vol : volumes)
+            mesh_volume(vol);
+        return;
+    }
+
+    TaskGraph graph;
+    std::map<ShapeID, Index> curve_task;
+    for (auto & crv : curves)
+        curve_task[crv->id()] = graph.add([this, crv] { mesh_curve(crv); });
+
+    std::map<ShapeID, Index> surface_task;
+    // surface tasks using a curve
+    std::map<ShapeID, std::vector<Index>> curve_users;
+    ConflictTracker surface_conflicts(false);
+    for (auto & srf : surfaces) {
+        std::vector<Index> deps;
+        std::vector<Resource> shared;
+        for (auto & crv : srf->curves()) {
+            auto it = curve_task.find(crv->id());
+            if (it != curve_task.end())
+                deps.push_back(it->second);
+            shared.emplace_back(1, crv->id());
+        }
+        auto id = Index(graph.size());
+        auto conflicts = surface_conflicts.add(id, shared, is_thread_safe(srf));
+        deps.insert(deps.end(), conflicts.begin(), conflicts.end());
+        surface_task[srf->id()] = graph.add([this, srf] { mesh_surface(srf); }, deps);
+        for (auto & crv : srf->curves())
+            curve_users[crv->id()].push_back(id);
+    }
+
+    ConflictTracker volume_conflicts(true);
+    for (auto & vol : volumes) {
+        std::vector<Index> deps;
+        std::vector<Resource> shared;
+        for (auto & srf : vol->surfaces()) {
+            auto it = surface_task.find(srf->id());
+            if (it != surface_task.end())
+                deps.push_back(it->second);
+            shared.emplace_back(2, srf->id());
+            // volume schemes can add vertices to the curves of their surfaces
+            for (auto & crv : srf->curves()) {
+                shared.emplace_back(1, crv->id());
+                auto & users = curve_users[crv->id()];
+                deps.insert(deps.end(), users.begin(), users.end());
+            }
+        }
+        auto id = Index(graph.size());
+        auto conflicts = volume_conflicts.add(id, shared, is_thread_safe(vol));
+        deps.insert(deps.end(), conflicts.begin(), conflicts.end());
+        graph.add([this, vol] { mesh_volume(vol); }, deps);
+    }
+
+    Log::info(2, "Running {} meshing task(s) on {} thread(s)", graph.size(), num_threads());
+    graph.run();
+}
+
+void
+GeomModel::set_mesh_cache(const std::filesystem::path & dir)
+{
+    this->mesh_cache_ = std::make_unique<MeshCache>(dir);
+}
+
 void
 GeomModel::set_block_name(Marker marker, const std::string & name)
 {
@@ -11,6 +11,7 @@
 #include "krado/exception.h"
 #include "krado/log.h"
 #include "krado/consts.h"
+#include "krado/parallel.h"
 #include "TopoDS.hxx"
 #include "BRep_Tool.hxx"
 #include "BRepLProp_SLProps.hxx"
@@ -20,24 +21,84 @@
 #include "ShapeAnalysis.hxx"
 #include "BRepClass_FaceClassifier.hxx"
 #include "Geom_Circle.hxx"
+#include "Geom_Plane.hxx"
+#include "GeomAdaptor_Surface.hxx"
+#include "GeomAPI_ProjectPointOnSurf.hxx"
+#include "Extrema_GenLocateExtPS.hxx"
+#include "Precision.hxx"
+#include <algorithm>
 #include <set>
 
 namespace krado {
 
-GeomSurface::GeomSurface(const TopoDS_Face & face) : GeomShape(face)
+struct GeomSurface::Projector {
+    Projector(const Handle(Geom_Surface) & surface,
+              double umin,
+              double umax,
+              double vmin,
+              double vmax) :
+        adaptor(surface, umin, umax, vmin, vmax),
+        local(adaptor)
+    {
+        this->global.Init(surface, umin, umax, vmin, vmax);
+    }
+
+    /// Search over the whole surface
+    GeomAPI_ProjectPointOnSurf global;
+    /// Surface for `local`
+    GeomAdaptor_Surface adaptor;
+    /// Search starting from an initial guess
+    Extrema_GenLocateExtPS local;
+};
+
+template <typename FN>
+auto
+GeomSurface::with_projector(FN && fn) const
+{
+    std::unique_ptr<Projector> proj;
+    {
+        std::lock_guard<std::mutex> lock(this->projectors_mutex_);
+        if (!this->projectors_.empty()) {
+            proj = std::move(this->projectors_.back());
+            this->projectors_.pop_back();
+        }
+    }
+    if (proj == nullptr)
+        proj = std::make_unique<Projector>(this->surface_,
+                                           this->umin_,
+                                           this->umax_,
+                                           this->vmin_,
+                                           this->vmax_);
+
+    // hand the projector back even if `fn` throws
+    struct Lease {
+        ~Lease()
+        {
+            std::lock_guard<std::mutex> lock(this->surface.projectors_mutex_);
+            this->surface.projectors_.push_back(std::move(this->proj));
+        }
+
+        const GeomSurface & surface;
+        std::unique_ptr<Projector> proj;
+    } lease { *this, std::move(proj) };
+    return fn(*lease.proj);
+}
+
+GeomSurface::GeomSurface(const TopoDS_Face & face) : GeomShape(face), is_plane_(false)
 
 {
     auto face1 = TopoDS::Face(this->shape_);
 
     this->surface_ = BRep_Tool::Surface(face1);
+    if (this->surface_->DynamicType() == STANDARD_TYPE(Geom_Plane)) {
+        const auto & ax = Handle(Geom_Plane)::DownCast(this->surface_)->Position();
+        this->is_plane_ = true;
+        this->origin_ = Point::create(ax.Location());
+        this->x_dir_ = Vector(ax.XDirection().X(), ax.XDirection().Y(), ax.XDirection().Z());
+        this->y_dir_ = Vector(ax.YDirection().X(), ax.YDirection().Y(), ax.YDirection().Z());
+    }
 
     ShapeAnalysis::GetFaceUVBounds(face1, this->umin_, this->umax_, this->vmin_, this->vmax_);
-
-    this->proj_pt_on_surface_.Init(this->surface_,
-                                   this->umin_,
-                                   this->umax_,
-                                   this->vmin_,
-                                   this->vmax_);
 }
 
 GeomSurface::GeomSurface(const GeomSurface & other) :
@@ -46,13 +107,12 @@ GeomSurface::GeomSurface(const GeomSurface & other) :
     umin_(other.umin_),
     umax_(other.umax_),
     vmin_(other.vmin_),
-    vmax_(other.vmax_)
+    vmax_(other.vmax_),
+    is_plane_(other.is_plane_),
+    origin_(other.origin_),
+    x_dir_(other.x_dir_),
+    y_dir_(other.y_dir_)
 {
-    this->proj_pt_on_surface_.Init(this->surface_,
-                                   this->umin_,
-                                   this->umax_,
-                                   this->vmin_,
-                                   this->vmax_);
 }
 
 GeomSurface::GeomSurface(GeomSurface && other) :
@@ -61,15 +121,16 @@ GeomSurface::GeomSurface(GeomSurface && other) :
     umin_(other.umin_),
     umax_(other.umax_),
     vmin_(other.vmin_),
-    vmax_(other.vmax_)
+    vmax_(other.vmax_),
+    is_plane_(other.is_plane_),
+    origin_(other.origin_),
+    x_dir_(other.x_dir_),
+    y_dir_(other.y_dir_)
 {
-    this->proj_pt_on_surface_.Init(this->surface_,
-                                   this->umin_,
-                                   this->umax_,
-                                   this->vmin_,
-                                   this->vmax_);
 }
 
+GeomSurface::~GeomSurface() = default;
+
 int
 GeomSurface::dim() const
 {
@@ -79,18 +140,63 @@ GeomSurface::dim() const
 Point
 GeomSurface::point(UVParam param) const
 {
-    return Point::create(this->surface_->Value(param.u, param.v));
+    Point pt;
+    point(Span<const UVParam>(&param, 1), Span<Point>(&pt, 1));
+    return pt;
 }
 
 Vector
 GeomSurface::normal(UVParam param) const
 {
-    const auto & face = TopoDS::Face(this->shape_);
-    BRepAdaptor_Surface breps(face);
-    BRepLProp_SLProps prop(breps, 1, 1e-10);
-    prop.SetParameters(param.u, param.v);
-    auto n = prop.Normal();
-    return Vector(n.X(), n.Y(), n.Z());
+    Vector n;
+    normal(Span<const UVParam>(&param, 1), Span<Vector>(&n, 1));
+    return n;
+}
+
+void
+GeomSurface::point(Span<const UVParam> uv, Span<Point> pts) const
+{
+    if (uv.size() != pts.size())
+        throw Exception("Expected {} points, got {}", uv.size(), pts.size());
+
+    if (this->is_plane_) {
+        const auto & o = this->origin_;
+        const auto & xd = this->x_dir_;
+        const auto & yd = this->y_dir_;
+        for (std::size_t i = 0; i < uv.size(); ++i) {
+            const auto u = uv[i].u;
+            const auto v = uv[i].v;
+            pts[i] = Point(u * xd.x + v * yd.x + o.x,
+                           u * xd.y + v * yd.y + o.y,
+                           u * xd.z + v * yd.z + o.z);
+        }
+    }
+    else {
+        for (std::size_t i = 0; i < uv.size(); ++i)
+            pts[i] = Point::create(this->surface_->Value(uv[i].u, uv[i].v));
+    }
+}
+
+void
+GeomSurface::normal(Span<const UVParam> uv, Span<Vector> normals) const
+{
+    if (uv.size() != normals.size())
+        throw Exception("Expected {} normals, got {}", uv.size(), normals.size());
+
+    if (this->is_plane_) {
+        // x- and y-axis are orthonormal, so no need to normalize
+        std::fill(normals.begin(), normals.end(), cross_product(this->x_dir_, this->y_dir_));
+    }
+    else {
+        const auto & face = TopoDS::Face(this->shape_);
+        BRepAdaptor_Surface breps(face);
+        BRepLProp_SLProps prop(breps, 1, 1e-10);
+        for (std::size_t i = 0; i < uv.size(); ++i) {
+            prop.SetParameters(uv[i].u, uv[i].v);
+            const auto & n = prop.Normal();
+            normals[i] = Vector(n.X(), n.Y(), n.Z());
+        }
+    }
 }
 
 std::tuple<Vector, Vector>
@@ -133,47 +239,122 @@ GeomSurface::curves() const
 UVParam
 GeomSurface::parameter_from_point(Point pt) const
 {
-    auto [found, uv] = project(pt);
+    auto [found, uv] = with_projector([&](Projector & proj) { return project(proj, pt); });
+    if (found)
+        return uv;
+    else
+        throw Exception("Projection of point failed to find parameter");
+}
+
+UVParam
+GeomSurface::parameter_from_point(Point pt, UVParam guess) const
+{
+    auto [found, uv] =
+        with_projector([&](Projector & proj) { return project(proj, pt, guess); });
     if (found)
         return uv;
     else
         throw Exception("Projection of point failed to find parameter");
 }
 
+void
+GeomSurface::parameter_from_point(Span<const Point> pts, Span<UVParam> uv) const
+{
+    if (pts.size() != uv.size())
+        throw Exception("Expected {} parameters, got {}", pts.size(), uv.size());
+
+    parallel_for_chunks(pts.size(), 16, [&](std::size_t begin, std::size_t end) {
+        with_projector([&](Projector & proj) {
+            for (std::size_t i = begin; i < end; ++i) {
+                auto [found, par] = project(proj, pts[i]);
+                if (!found)
+                    throw Exception("Projection of point failed to find parameter");
+                uv[i] = par;
+            }
+        });
+    });
+}
+
+void
+GeomSurface::parameter_from_point(Span<const Point> pts,
+                                  Span<const UVParam> guess,
+                                  Span<UVParam> uv) const
+{
+    if (pts.size() != guess.size())
+        throw Exception("Expected {} initial guesses, got {}", pts.size(), guess.size());
+    if (pts.size() != uv.size())
+        throw Exception("Expected {} parameters, got {}", pts.size(), uv.size());
+
+    parallel_for_chunks(pts.size(), 16, [&](std::size_t begin, std::size_t end) {
+        with_projector([&](Projector & proj) {
+            for (std::size_t i = begin; i < end; ++i) {
+                auto [found, par] = project(proj, pts[i], guess[i]);
+                if (!found)
+                    throw Exception("Projection of point failed to find parameter");
+                uv[i] = par;
+            }
+        });
+    });
+}
+
 GeomSurface::operator const TopoDS_Face &() const
 {
     return TopoDS::Face(this->shape_);
 }
 
 std::tuple<bool, UVParam>
-GeomSurface::project(Point pt) const
+GeomSurface::project(Projector & proj, Point pt) const
 {
-    this->proj_pt_on_surface_.Perform(pt);
+    proj.global.Perform(pt);
 
-    if (this->proj_pt_on_surface_.NbPoints() > 0) {
+    if (proj.global.NbPoints() > 0) {
         double u, v;
-        this->proj_pt_on_surface_.LowerDistanceParameters(u, v);
+        proj.global.LowerDistanceParameters(u, v);
         return { true, { u, v } };
     }
     else
         return { false, { 0., 0. } };
 }
 
+std::tuple<bool, UVParam>
+GeomSurface::project(Projector & proj, Point pt, UVParam guess) const
+{
+    proj.local.Perform(pt, guess.u, guess.v, Standard_True);
+    if (proj.local.IsDone()) {
+        double u, v;
+        proj.local.Point().Parameter(u, v);
+        // the local search stops at the parameter bounds, so it can miss the nearest point on
+        // periodic surfaces. Let the global search sort it out.
+        const auto tol = Precision::PConfusion();
+        if (u > this->umin_ + tol && u < this->umax_ - tol && v > this->vmin_ + tol &&
+            v < this->vmax_ - tol)
+            return { true, { u, v } };
+    }
+    return project(proj, pt);
+}
+
 Point
 GeomSurface::nearest_point(Point pt) const
 {
-    this->proj_pt_on_surface_.Perform(pt);
-    if (this->proj_pt_on_surface_.NbPoints())
-        return Point::create(this->proj_pt_on_surface_.NearestPoint());
-    else
-        throw Exception("Projection of point failed to find parameter");
+    return with_projector([&](Projector & proj) {
+        proj.global.Perform(pt);
+        if (proj.global.NbPoints())
+            return Point::create(proj.global.NearestPoint());
+        else
+            throw Exception("Projection of point failed to find parameter");
+    });
 }
 
 std::tuple<Point, UVParam>
 GeomSurface::closest_point(Point qp, UVParam uv) const
 {
-    auto pt = nearest_point(qp);
-    this->proj_pt_on_surface_.LowerDistanceParameters(uv.u, uv.v);
+    auto pt = with_projector([&](Projector & proj) {
+        proj.global.Perform(qp);
+        if (proj.global.NbPoints() == 0)
+            throw Exception("Projection of point failed to find parameter");
+        proj.global.LowerDistanceParameters(uv.u, uv.v);
+        return Point::create(proj.global.NearestPoint());
+    });
 
     if (uv.u < this->umin_ || uv.u > this->umax_ || uv.v < this->vmin_ || uv.v > this->vmax_)
         Log::debug("Point projection is out of surface parameter bounds");
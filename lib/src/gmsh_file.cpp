@@ -0,0 +1,933 @@
+// SPDX-FileCopyrightText: 2026 David Andrs <andrsd@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "krado/gmsh_file.h"
+#include "krado/exception.h"
+#include "krado/log.h"
+#include "krado/parallel.h"
+#include "krado/range.h"
+#include "krado/timer.h"
+#include "krado/utils.h"
+#include "fmt/format.h"
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <set>
+#include <sstream>
+#include <tuple>
+#include <vector>
+
+namespace krado {
+
+namespace {
+
+/// Gmsh element types
+enum GmshElementType : int {
+    MSH_LIN_2 = 1,
+    MSH_TRI_3 = 2,
+    MSH_QUA_4 = 3,
+    MSH_TET_4 = 4,
+    MSH_HEX_8 = 5,
+    MSH_PRI_6 = 6,
+    MSH_PYR_5 = 7,
+    MSH_PNT = 15
+};
+
+/// Number of krado element types
+constexpr std::size_t N_ELEMENT_TYPES = static_cast<std::size_t>(ElementType::INVALID);
+
+/// Size of the output buffer that triggers writing into the file
+constexpr std::size_t BUFFER_SIZE = 1 << 20;
+
+ElementType
+element_type(int gmsh_type)
+{
+    switch (gmsh_type) {
+    case MSH_PNT:
+        return ElementType::POINT;
+    case MSH_LIN_2:
+        return ElementType::LINE2;
+    case MSH_TRI_3:
+        return ElementType::TRI3;
+    case MSH_QUA_4:
+        return ElementType::QUAD4;
+    case MSH_TET_4:
+        return ElementType::TETRA4;
+    case MSH_PYR_5:
+        return ElementType::PYRAMID5;
+    case MSH_PRI_6:
+        return ElementType::PRISM6;
+    case MSH_HEX_8:
+        return ElementType::HEX8;
+    default:
+        throw Exception("Unsupported Gmsh element type {}", gmsh_type);
+    }
+}
+
+int
+gmsh_element_type(ElementType et)
+{
+    switch (et) {
+    case ElementType::POINT:
+        return MSH_PNT;
+    case ElementType::LINE2:
+        return MSH_LIN_2;
+    case ElementType::TRI3:
+        return MSH_TRI_3;
+    case ElementType::QUAD4:
+        return MSH_QUA_4;
+    case ElementType::TETRA4:
+        return MSH_TET_4;
+    case ElementType::PYRAMID5:
+        return MSH_PYR_5;
+    case ElementType::PRISM6:
+        return MSH_PRI_6;
+    case ElementType::HEX8:
+        return MSH_HEX_8;
+    default:
+        throw Exception("Unsupported element type {}", Element::type(et));
+    }
+}
+
+/// Get number of vertices of an element type
+std::size_t
+num_vertices(ElementType et)
+{
+    switch (et) {
+    case ElementType::POINT:
+        return 1;
+    case ElementType::LINE2:
+        return Line2::N_VERTICES;
+    case ElementType::TRI3:
+        return Tri3::N_VERTICES;
+    case ElementType::QUAD4:
+        return Quad4::N_VERTICES;
+    case ElementType::TETRA4:
+        return Tetra4::N_VERTICES;
+    case ElementType::PYRAMID5:
+        return Pyramid5::N_VERTICES;
+    case ElementType::PRISM6:
+        return Prism6::N_VERTICES;
+    case ElementType::HEX8:
+        return Hex8::N_VERTICES;
+    default:
+        return 0;
+    }
+}
+
+/// Get topological dimension of an element type
+int
+element_dim(ElementType et)
+{
+    switch (et) {
+    case ElementType::POINT:
+        return 0;
+    case ElementType::LINE2:
+        return 1;
+    case ElementType::TRI3:
+    case ElementType::QUAD4:
+        return 2;
+    default:
+        return 3;
+    }
+}
+
+/// Get element type of a facet from its number of vertices
+ElementType
+facet_type(std::size_t n_vertices)
+{
+    switch (n_vertices) {
+    case 1:
+        return ElementType::POINT;
+    case 2:
+        return ElementType::LINE2;
+    case 3:
+        return ElementType::TRI3;
+    default:
+        return ElementType::QUAD4;
+    }
+}
+
+// Reading
+
+/// Reads a MSH file that is either ASCII or binary (sections are always separated by text lines)
+class Reader {
+public:
+    explicit Reader(const std::string & file_name) :
+        in_(file_name, std::ios::binary),
+        fn_(file_name)
+    {
+        if (!this->in_.good())
+            throw Exception("Failed to open '{}'.", file_name);
+    }
+
+    [[nodiscard]] const std::string &
+    file_name() const
+    {
+        return this->fn_;
+    }
+
+    void
+    set_binary(bool binary)
+    {
+        this->binary_ = binary;
+    }
+
+    /// Read a text line without trailing white space
+    ///
+    /// @return `false` at the end of the file
+    bool
+    line(std::string & str)
+    {
+        if (!std::getline(this->in_, str))
+            return false;
+        while (!str.empty() && std::isspace(static_cast<unsigned char>(str.back())))
+            str.pop_back();
+        return true;
+    }
+
+    /// Read `n` values
+    template <typename T>
+    void
+    read(T * data, std::size_t n)
+    {
+        if (this->binary_)
+            this->in_.read(reinterpret_cast<char *>(data), n * sizeof(T));
+        else
+            for (std::size_t i = 0; i < n; ++i)
+                this->in_ >> data[i];
+        if (!this->in_)
+            throw Exception("Unexpected end of file '{}'", this->fn_);
+    }
+
+    template <typename T>
+    T
+    read()
+    {
+        T val;
+        read(&val, 1);
+        return val;
+    }
+
+    template <typename T>
+    std::vector<T>
+    read_vector(std::size_t n)
+    {
+        std::vector<T> vals(n);
+        read(vals.data(), n);
+        return vals;
+    }
+
+    /// Skip everything up to (and including) the end of a section
+    ///
+    /// @param name Section name (without `$`)
+    void
+    skip_section(const std::string & name)
+    {
+        std::string end = "$End" + name;
+        std::string str;
+        while (line(str))
+            if (str == end)
+                return;
+        throw Exception("Unexpected end of file '{}'", this->fn_);
+    }
+
+private:
+    std::ifstream in_;
+    std::string fn_;
+    bool binary_ = false;
+};
+
+/// Elements of one dimension in compressed row storage
+struct ElementBlocks {
+    std::vector<ElementType> types;
+    std::vector<Index> offsets = { 0 };
+    std::vector<Index> ids;
+    /// Entity tag, first element and number of elements of every block
+    std::vector<std::tuple<int, std::size_t, std::size_t>> blocks;
+};
+
+/// Physical groups and names of a MSH file
+struct Physicals {
+    /// Physical tags of every (dimension, entity tag)
+    std::map<std::pair<int, int>, std::vector<int>> entity_tags;
+    /// Names of physical groups keyed by (dimension, physical tag)
+    std::map<std::pair<int, int>, std::string> names;
+
+    [[nodiscard]] const std::vector<int> &
+    tags(int dim, int entity) const
+    {
+        static const std::vector<int> none;
+        auto it = this->entity_tags.find({ dim, entity });
+        return it != this->entity_tags.end() ? it->second : none;
+    }
+};
+
+void
+read_format(Reader & in)
+{
+    std::string str;
+    in.line(str);
+    std::istringstream iss(str);
+    std::string version;
+    int file_type = 0;
+    int data_size = 0;
+    iss >> version >> file_type >> data_size;
+    if (!iss || (version != "4.1" && version.rfind("4.1.", 0) != 0))
+        throw Exception("Unsupported MSH version '{}' in '{}'", version, in.file_name());
+    if (data_size != sizeof(std::size_t))
+        throw Exception("Unsupported data size {} in '{}'", data_size, in.file_name());
+    in.set_binary(file_type == 1);
+    if (file_type == 1 && in.read<int>() != 1)
+        throw Exception("'{}' was written on a machine with a different byte order",
+                        in.file_name());
+    in.skip_section("MeshFormat");
+}
+
+void
+read_physical_names(Reader & in, Physicals & physicals)
+{
+    // this section is in ASCII even in binary files
+    std::string str;
+    in.line(str);
+    auto n = std::stoul(str);
+    for (std::size_t i = 0; i < n; ++i) {
+        in.line(str);
+        std::istringstream iss(str);
+        int dim, tag;
+        iss >> dim >> tag;
+        auto first = str.find('"');
+        auto last = str.rfind('"');
+        if (!iss || first == std::string::npos || last == first)
+            throw Exception("Invalid physical name '{}' in '{}'", str, in.file_name());
+        physicals.names[{ dim, tag }] = str.substr(first + 1, last - first - 1);
+    }
+    in.skip_section("PhysicalNames");
+}
+
+void
+read_entities(Reader & in, Physicals & physicals)
+{
+    std::array<std::size_t, 4> n_entities;
+    in.read(n_entities.data(), n_entities.size());
+    for (int dim = 0; dim < 4; ++dim) {
+        for (std::size_t i = 0; i < n_entities[dim]; ++i) {
+            auto tag = in.read<int>();
+            // points have coordinates, other entities have a bounding box
+            in.read_vector<double>(dim == 0 ? 3 : 6);
+            auto n_phys = in.read<std::size_t>();
+            auto phys = in.read_vector<int>(n_phys);
+            if (!phys.empty())
+                physicals.entity_tags[{ dim, tag }] = std::move(phys);
+            if (dim > 0) {
+                auto n_bounding = in.read<std::size_t>();
+                in.read_vector<int>(n_bounding);
+            }
+        }
+    }
+    in.skip_section("Entities");
+}
+
+/// Read nodes
+///
+/// @param in Reader
+/// @param node_index [out] Index of a node with tag `t` is stored at `t - min_tag`
+/// @param min_tag [out] Smallest node tag
+/// @return Node coordinates
+Coordinates
+read_nodes(Reader & in, std::vector<Index> & node_index, std::size_t & min_tag)
+{
+    std::array<std::size_t, 4> hdr;
+    in.read(hdr.data(), hdr.size());
+    auto [n_blocks, n_nodes, min_node_tag, max_node_tag] = hdr;
+    if (n_nodes > std::numeric_limits<Index>::max())
+        throw Exception("Too many nodes ({}) in '{}'", n_nodes, in.file_name());
+
+    min_tag = min_node_tag;
+    node_index.assign(n_nodes > 0 ? max_node_tag - min_node_tag + 1 : 0,
+                      std::numeric_limits<Index>::max());
+    std::vector<double> x(n_nodes);
+    std::vector<double> y(n_nodes);
+    std::vector<double> z(n_nodes);
+    std::size_t next = 0;
+    for (std::size_t b = 0; b < n_blocks; ++b) {
+        auto dim = in.read<int>();
+        in.read<int>();
+        auto parametric = in.read<int>();
+        auto n = in.read<std::size_t>();
+        if (n > n_nodes - next)
+            throw Exception("Inconsistent number of nodes in '{}'", in.file_name());
+        auto tags = in.read_vector<std::size_t>(n);
+        // parametric coordinates follow x, y and z of every node
+        std::size_t stride = 3 + (parametric ? dim : 0);
+        auto coords = in.read_vector<double>(n * stride);
+        parallel_for(n, [&](std::size_t i) {
+            if (tags[i] < min_node_tag || tags[i] > max_node_tag)
+                throw Exception("Node tag {} is out of range in '{}'", tags[i], in.file_name());
+            node_index[tags[i] - min_node_tag] = next + i;
+            x[next + i] = coords[i * stride];
+            y[next + i] = coords[i * stride + 1];
+            z[next + i] = coords[i * stride + 2];
+        });
+        next += n;
+    }
+    in.skip_section("Nodes");
+    return Coordinates(std::move(x), std::move(y), std::move(z));
+}
+
+/// Read elements
+///
+/// @param in Reader
+/// @param node_index Index of every node tag (see `read_nodes`)
+/// @param min_tag Smallest node tag
+/// @return Elements of dimension 0, 1, 2 and 3
+std::array<ElementBlocks, 4>
+read_elements(Reader & in, const std::vector<Index> & node_index, std::size_t min_tag)
+{
+    std::array<std::size_t, 4> hdr;
+    in.read(hdr.data(), hdr.size());
+    auto n_blocks = hdr[0];
+
+    std::array<ElementBlocks, 4> elems;
+    for (std::size_t b = 0; b < n_blocks; ++b) {
+        auto dim = in.read<int>();
+        auto tag = in.read<int>();
+        auto et = element_type(in.read<int>());
+        auto n = in.read<std::size_t>();
+        if (dim != element_dim(et))
+            throw Exception("Invalid element block dimension {} in '{}'", dim, in.file_name());
+        auto nn = num_vertices(et);
+        // element tag followed by its node tags
+        auto data = in.read_vector<std::size_t>(n * (1 + nn));
+
+        auto & blk = elems[dim];
+        auto first = blk.types.size();
+        auto first_id = blk.ids.size();
+        blk.types.resize(first + n, et);
+        blk.offsets.resize(first + n + 1);
+        blk.ids.resize(first_id + n * nn);
+        parallel_for(n, [&](std::size_t i) {
+            blk.offsets[first + i + 1] = first_id + (i + 1) * nn;
+            for (std::size_t j = 0; j < nn; ++j) {
+                auto node_tag = data[i * (1 + nn) + 1 + j];
+                auto idx = node_tag >= min_tag && node_tag - min_tag < node_index.size()
+                               ? node_index[node_tag - min_tag]
+                               : std::numeric_limits<Index>::max();
+                if (idx == std::numeric_limits<Index>::max())
+                    throw Exception("Unknown node tag {} in '{}'", node_tag, in.file_name());
+                blk.ids[first_id + i * nn + j] = idx;
+            }
+        });
+        blk.blocks.emplace_back(tag, first, n);
+    }
+    in.skip_section("Elements");
+    return elems;
+}
+
+// Writing
+
+/// Writes a MSH file either in ASCII or binary
+///
+/// Values are collected in a buffer that is written into the file once it is large enough
+class Writer {
+public:
+    Writer(const std::string & file_name, bool binary) :
+        out_(file_name, std::ios::binary | std::ios::trunc),
+        fn_(file_name),
+        binary_(binary)
+    {
+        if (!this->out_.good())
+            throw Exception("Failed to write '{}'.", file_name);
+    }
+
+    /// Write a text line
+    void
+    line(const std::string & str)
+    {
+        this->buf_ += str;
+        this->buf_ += '\n';
+    }
+
+    /// Write a value (separated by a space from the previous one on the line in ASCII files)
+    template <typename T>
+    void
+    put(T val)
+    {
+        if (this->binary_)
+            this->buf_.append(reinterpret_cast<const char *>(&val), sizeof(T));
+        else {
+            if (!this->line_start_)
+                this->buf_ += ' ';
+            fmt::format_to(std::back_inserter(this->buf_), "{}", val);
+            this->line_start_ = false;
+        }
+        if (this->buf_.size() > BUFFER_SIZE)
+            flush();
+    }
+
+    /// End a line of values (ASCII files only)
+    void
+    end_line()
+    {
+        if (!this->binary_) {
+            this->buf_ += '\n';
+            this->line_start_ = true;
+        }
+    }
+
+    /// Start a section
+    void
+    begin_section(const std::string & name)
+    {
+        line("$" + name);
+    }
+
+    /// End a section
+    void
+    end_section(const std::string & name)
+    {
+        if (this->binary_)
+            this->buf_ += '\n';
+        line("$End" + name);
+    }
+
+    void
+    close()
+    {
+        flush();
+        if (!this->out_.good())
+            throw Exception("Failed to write '{}'.", this->fn_);
+    }
+
+private:
+    void
+    flush()
+    {
+        this->out_.write(this->buf_.data(), this->buf_.size());
+        this->buf_.clear();
+    }
+
+    std::ofstream out_;
+    std::string fn_;
+    bool binary_;
+    std::string buf_;
+    bool line_start_ = true;
+};
+
+/// Entity of a written file
+struct Entity {
+    int dim;
+    int tag;
+    /// Physical groups
+    std::vector<Marker> physicals;
+    /// Cells (for entities of cells)
+    std::vector<Index> cells;
+    /// Sides (for entities of a side set)
+    Span<const SideEntry> sides;
+    /// Number of elements of every type
+    std::array<std::size_t, N_ELEMENT_TYPES> counts {};
+};
+
+/// Get the dimension of a mesh
+int
+mesh_dim(const Mesh & mesh)
+{
+    const auto & types = mesh.connectivity().types();
+    return parallel_reduce(
+        types.size(),
+        0,
+        [&](std::size_t begin, std::size_t end) {
+            int dim = 0;
+            for (auto i = begin; i < end; ++i)
+                dim = std::max(dim, element_dim(types[i]));
+            return dim;
+        },
+        [](int a, int b) { return std::max(a, b); });
+}
+
+/// Split mesh into entities
+///
+/// Cells are grouped by the cell sets they belong to, so that overlapping cell sets are kept: the
+/// entity of the cells that are in sets 1 and 2 has both physical groups. Every side set is an
+/// entity of its own.
+///
+/// @param mesh Mesh
+/// @param dim Mesh dimension
+/// @return Entities
+std::vector<Entity>
+build_entities(const Mesh & mesh, int dim)
+{
+    std::vector<Entity> entities;
+    auto elems = mesh.elements();
+
+    // cell set IDs of every cell (in CSR format, IDs are sorted since sets are visited in order)
+    auto set_ids = mesh.cell_set_ids();
+    std::vector<std::size_t> ofst(elems.size() + 1, 0);
+    for (auto id : set_ids)
+        for (auto c : mesh.cell_set(id))
+            ofst[c + 1]++;
+    for (std::size_t i = 0; i < elems.size(); ++i)
+        ofst[i + 1] += ofst[i];
+    std::vector<Marker> membership(ofst.back());
+    auto pos = ofst;
+    for (auto id : set_ids)
+        for (auto c : mesh.cell_set(id))
+            // a cell listed twice in the same set is in it only once
+            if (pos[c] == ofst[c] || membership[pos[c] - 1] != id)
+                membership[pos[c]++] = id;
+
+    // one entity per combination of cell sets, cells outside any set come last
+    std::map<std::vector<Marker>, std::vector<Index>> groups;
+    std::vector<Index> orphans;
+    std::vector<Marker> key;
+    for (Index c = 0; c < elems.size(); ++c) {
+        key.assign(membership.begin() + ofst[c], membership.begin() + pos[c]);
+        if (key.empty())
+            orphans.push_back(c);
+        else
+            groups[key].push_back(c);
+    }
+    int tag = 1;
+    auto add_cell_entity = [&](std::vector<Marker> physicals, std::vector<Index> cells) {
+        if (cells.empty())
+            return;
+        Entity ent { dim, tag++, std::move(physicals), std::move(cells), {}, {} };
+        for (auto c : ent.cells)
+            ent.counts[static_cast<std::size_t>(elems[c].type())]++;
+        entities.push_back(std::move(ent));
+    };
+    for (auto & [physicals, cells] : groups)
+        add_cell_entity(physicals, std::move(cells));
+    add_cell_entity({}, std::move(orphans));
+
+    if (dim > 0) {
+        tag = 1;
+        for (auto id : mesh.side_set_ids()) {
+            auto sides = mesh.side_set(id);
+            if (sides.empty())
+                continue;
+            Entity ent { dim - 1, tag++, { id }, {}, sides, {} };
+            std::array<Index, 4> vtx;
+            for (auto & s : sides) {
+                auto n = facet_vertices(elems[s.elem], s.side, vtx);
+                ent.counts[static_cast<std::size_t>(facet_type(n))]++;
+            }
+            entities.push_back(std::move(ent));
+        }
+    }
+    return entities;
+}
+
+void
+write_format(Writer & out, bool binary)
+{
+    out.begin_section("MeshFormat");
+    out.line(fmt::format("4.1 {} {}", binary ? 1 : 0, sizeof(std::size_t)));
+    if (binary)
+        out.put<int>(1);
+    out.end_section("MeshFormat");
+}
+
+void
+write_physical_names(Writer & out, const Mesh & mesh, const std::vector<Entity> & entities)
+{
+    std::vector<std::string> names;
+    // a cell set can be a physical group of several entities, but it is named only once
+    std::set<std::tuple<int, Marker>> named;
+    for (const auto & ent : entities) {
+        for (auto id : ent.physicals) {
+            if (!named.insert({ ent.dim, id }).second)
+                continue;
+            auto name = ent.sides.empty() ? mesh.cell_set_name(id) : mesh.side_set_name(id);
+            if (name.has_value())
+                names.push_back(fmt::format("{} {} \"{}\"", ent.dim, id, name.value()));
+        }
+    }
+    if (names.empty())
+        return;
+
+    // this section is in ASCII even in binary files
+    out.begin_section("PhysicalNames");
+    out.line(fmt::format("{}", names.size()));
+    for (auto & name : names)
+        out.line(name);
+    out.line("$EndPhysicalNames");
+}
+
+void
+write_entities(Writer & out, const Mesh & mesh, const std::vector<Entity> & entities)
+{
+    std::array<double, 3> lo = { 0., 0., 0. };
+    std::array<double, 3> hi = { 0., 0., 0. };
+    const auto & coords = mesh.coordinates();
+    const std::vector<double> * xyz[] = { &coords.x(), &coords.y(), &coords.z() };
+    for (int d = 0; d < 3; ++d) {
+        if (!xyz[d]->empty()) {
+            auto [mn, mx] = std::minmax_element(xyz[d]->begin(), xyz[d]->end());
+            lo[d] = *mn;
+            hi[d] = *mx;
+        }
+    }
+
+    out.begin_section("Entities");
+    for (int d = 0; d < 4; ++d)
+        out.put<std::size_t>(std::count_if(entities.begin(), entities.end(), [d](const Entity & e) {
+            return e.dim == d;
+        }));
+    out.end_line();
+    for (int d = 0; d < 4; ++d) {
+        for (const auto & ent : entities) {
+            if (ent.dim != d)
+                continue;
+            out.put<int>(ent.tag);
+            for (int k = 0; k < 3; ++k)
+                out.put<double>(lo[k]);
+            if (d > 0)
+                for (int k = 0; k < 3; ++k)
+                    out.put<double>(hi[k]);
+            out.put<std::size_t>(ent.physicals.size());
+            for (auto id : ent.physicals)
+                out.put<int>(id);
+            if (d > 0)
+                out.put<std::size_t>(0);
+            out.end_line();
+        }
+    }
+    out.end_section("Entities");
+}
+
+void
+write_nodes(Writer & out, const Mesh & mesh, int dim, int entity_tag)
+{
+    const auto & coords = mesh.coordinates();
+    std::size_t n = coords.size();
+
+    out.begin_section("Nodes");
+    // all nodes are stored in a single block
+    out.put<std::size_t>(1);
+    out.put<std::size_t>(n);
+    out.put<std::size_t>(1);
+    out.put<std::size_t>(n);
+    out.end_line();
+    out.put<int>(dim);
+    out.put<int>(entity_tag);
+    out.put<int>(0);
+    out.put<std::size_t>(n);
+    out.end_line();
+    for (std::size_t i = 0; i < n; ++i) {
+        out.put<std::size_t>(i + 1);
+        out.end_line();
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        out.put<double>(coords.x()[i]);
+        out.put<double>(coords.y()[i]);
+        out.put<double>(coords.z()[i]);
+        out.end_line();
+    }
+    out.end_section("Nodes");
+}
+
+void
+write_elements(Writer & out, const Mesh & mesh, const std::vector<Entity> & entities)
+{
+    std::size_t n_blocks = 0;
+    std::size_t n_elems = 0;
+    for (const auto & ent : entities)
+        for (auto cnt : ent.counts)
+            if (cnt > 0) {
+                ++n_blocks;
+                n_elems += cnt;
+            }
+
+    out.begin_section("Elements");
+    out.put<std::size_t>(n_blocks);
+    out.put<std::size_t>(n_elems);
+    out.put<std::size_t>(1);
+    out.put<std::size_t>(n_elems);
+    out.end_line();
+
+    auto elems = mesh.elements();
+    std::size_t elem_tag = 1;
+    for (const auto & ent : entities) {
+        for (std::size_t t = 0; t < N_ELEMENT_TYPES; ++t) {
+            if (ent.counts[t] == 0)
+                continue;
+            auto et = static_cast<ElementType>(t);
+            out.put<int>(ent.dim);
+            out.put<int>(ent.tag);
+            out.put<int>(gmsh_element_type(et));
+            out.put<std::size_t>(ent.counts[t]);
+            out.end_line();
+            for (auto c : ent.cells) {
+                auto elem = elems[c];
+                if (elem.type() != et)
+                    continue;
+                out.put<std::size_t>(elem_tag++);
+                for (auto v : elem.indices())
+                    out.put<std::size_t>(v + 1);
+                out.end_line();
+            }
+            std::array<Index, 4> vtx;
+            for (const auto & s : ent.sides) {
+                auto n = facet_vertices(elems[s.elem], s.side, vtx);
+                if (facet_type(n) != et)
+                    continue;
+                out.put<std::size_t>(elem_tag++);
+                for (std::size_t j = 0; j < n; ++j)
+                    out.put<std::size_t>(vtx[j] + 1);
+                out.end_line();
+            }
+        }
+    }
+    out.end_section("Elements");
+}
+
+} // namespace
+
+GmshFile::GmshFile(const std::filesystem::path & file_name) : GmshFile(file_name, Options()) {}
+
+GmshFile::GmshFile(const std::filesystem::path & file_name, const Options & opts) :
+    fn_(file_name.string()),
+    opts_(opts)
+{
+}
+
+Ptr<Mesh>
+GmshFile::read()
+{
+    Log::info("Reading Gmsh file '{}'", this->fn_);
+    LoggingTimer timer;
+
+    Reader in(this->fn_);
+    Physicals physicals;
+    Coordinates coords;
+    std::vector<Index> node_index;
+    std::size_t min_node_tag = 0;
+    std::array<ElementBlocks, 4> elems;
+    bool has_format = false;
+    std::string str;
+    while (in.line(str)) {
+        if (str.empty())
+            continue;
+        if (str == "$MeshFormat") {
+            read_format(in);
+            has_format = true;
+        }
+        else if (!has_format)
+            throw Exception("'{}' is not a Gmsh MSH file", this->fn_);
+        else if (str == "$PhysicalNames")
+            read_physical_names(in, physicals);
+        else if (str == "$Entities")
+            read_entities(in, physicals);
+        else if (str == "$Nodes")
+            coords = read_nodes(in, node_index, min_node_tag);
+        else if (str == "$Elements")
+            elems = read_elements(in, node_index, min_node_tag);
+        else if (str[0] == '$')
+            in.skip_section(str.substr(1));
+    }
+    if (!has_format)
+        throw Exception("'{}' is not a Gmsh MSH file", this->fn_);
+
+    // cells are the elements of the highest dimension
+    int dim = 3;
+    while (dim > 0 && elems[dim].types.empty())
+        --dim;
+    auto & cells = elems[dim];
+    auto mesh = Ptr<Mesh>::alloc(std::move(coords),
+                                 Connectivity(std::move(cells.types),
+                                              std::move(cells.offsets),
+                                              std::move(cells.ids)));
+
+    std::map<Marker, std::vector<Index>> cell_sets;
+    for (auto & [tag, first, n] : cells.blocks)
+        for (auto phys : physicals.tags(dim, tag)) {
+            auto & cell_set = cell_sets[phys];
+            for (std::size_t i = 0; i < n; ++i)
+                cell_set.push_back(first + i);
+        }
+    for (auto & [id, cell_set] : cell_sets) {
+        mesh->set_cell_set(id, std::move(cell_set));
+        auto it = physicals.names.find({ dim, id });
+        if (it != physicals.names.end())
+            mesh->set_cell_set_name(id, it->second);
+    }
+
+    // side sets from physical groups of elements one dimension lower
+    if (dim > 0) {
+        auto & facets = elems[dim - 1];
+        bool has_physicals = std::any_of(facets.blocks.begin(), facets.blocks.end(), [&](auto & b) {
+            return !physicals.tags(dim - 1, std::get<0>(b)).empty();
+        });
+        if (has_physicals) {
+            Connectivity facet_connect(std::move(facets.types),
+                                       std::move(facets.offsets),
+                                       std::move(facets.ids));
+            auto sides = match_sides(*mesh, facet_connect);
+            std::map<Marker, std::vector<SideEntry>> side_sets;
+            std::map<Marker, std::size_t> n_unmatched;
+            for (auto & [tag, first, n] : facets.blocks)
+                for (auto phys : physicals.tags(dim - 1, tag)) {
+                    auto & side_set = side_sets[phys];
+                    for (std::size_t i = 0; i < n; ++i) {
+                        if (sides[first + i].has_value())
+                            side_set.push_back(sides[first + i].value());
+                        else
+                            n_unmatched[phys]++;
+                    }
+                }
+            for (auto & [id, side_set] : side_sets) {
+                if (n_unmatched[id] > 0)
+                    Log::warn("{} element(s) of physical group {} are not element sides",
+                              n_unmatched[id],
+                              id);
+                mesh->set_side_set(id, std::move(side_set));
+                auto it = physicals.names.find({ dim - 1, id });
+                if (it != physicals.names.end())
+                    mesh->set_side_set_name(id, it->second);
+            }
+        }
+    }
+
+    Log::info("- {}D, {} node(s), {} element(s), {} cell set(s), {} side set(s)",
+              dim,
+              utils::human_number(mesh->num_points()),
+              utils::human_number(mesh->num_elements()),
+              utils::human_number(mesh->cell_set_ids().size()),
+              utils::human_number(mesh->side_set_ids().size()));
+    return mesh;
+}
+
+void
+GmshFile::write(Ptr<const Mesh> mesh)
+{
+    Log::info("Writing Gmsh file '{}'", this->fn_);
+    LoggingTimer timer;
+
+    if (!mesh->node_set_ids().empty())
+        Log::warn("Node sets are not written into Gmsh files");
+
+    auto dim = mesh_dim(*mesh);
+    auto entities = build_entities(*mesh, dim);
+    auto node_entity = entities.empty() ? 1 : entities.front().tag;
+
+    Writer out(this->fn_, this->opts_.binary);
+    write_format(out, this->opts_.binary);
+    write_physical_names(out, *mesh, entities);
+    write_entities(out, *mesh, entities);
+    write_nodes(out, *mesh, dim, node_entity);
+    write_elements(out, *mesh, entities);
+    out.close();
+
+    Log::info("- {}D, {} node(s), {} element(s), {} entities",
+              dim,
+              utils::human_number(mesh->num_points()),
+              utils::human_number(mesh->num_elements()),
+              utils::human_number(entities.size()));
+}
+
+} // namespace krado
@@ -5,11 +5,282 @@
 #include "krado/mesh.h"
 #include "krado/log.h"
 #include "krado/timer.h"
+#include "krado/exception.h"
+#include "krado/parallel.h"
+#include "krado/utils.h"
+#include <atomic>
 #include <iostream>
 
 namespace krado {
 
-HasseDiagram::HasseDiagram(const Mesh & mesh)
+namespace {
+
+/// Size of the fixed buffer `children()` fills with the child nodes of one Hasse node: the faces
+/// of a 3D cell (at most 6, hexahedron), the edges of a 2D cell or a face (at most 4) or the 2
+/// vertices of an edge or a 1D cell
+constexpr std::size_t MAX_CHILDREN = 8;
+
+/// Face of an element identified by its sorted vertex tuple
+struct FaceRecord {
+    /// Sorted vertex indices (unused slots are set to max value)
+    std::array<Index, 4> vtx;
+    /// Element that owns this face
+    Index elem;
+    /// Local face number
+    u8 local;
+};
+
+/// Edge of an element identified by its sorted vertex tuple
+struct EdgeRecord {
+    /// Sorted vertex indices
+    std::array<Index, 2> vtx;
+    /// Element that owns this edge
+    Index elem;
+    /// Local edge number
+    u8 local;
+};
+
+template <typename RECORD>
+bool
+record_less(const RECORD & a, const RECORD & b)
+{
+    if (a.vtx != b.vtx)
+        return a.vtx < b.vtx;
+    if (a.elem != b.elem)
+        return a.elem < b.elem;
+    return a.local < b.local;
+}
+
+/// Topological description of an element type used while building the diagram
+struct ElementTopology {
+    /// Number of faces (zero for 0D, 1D and 2D elements)
+    u8 n_faces = 0;
+    /// Number of edges (zero for 0D and 1D elements)
+    u8 n_edges = 0;
+    /// Local vertices of faces
+    const std::vector<std::vector<u8>> * face_vertices = nullptr;
+    /// Local edges of faces
+    const std::vector<std::vector<u8>> * face_edges = nullptr;
+    /// Local vertices of edges
+    const std::vector<std::array<u8, 2>> * edge_vertices = nullptr;
+    /// Position of a local edge in the order edges are discovered (for numbering)
+    std::array<u8, 12> edge_order = {};
+};
+
+template <class ELEMENT_TYPE>
+ElementTopology
+build_topology_2d()
+{
+    ElementTopology topo;
+    topo.n_edges = ELEMENT_TYPE::N_EDGES;
+    topo.edge_vertices = &ELEMENT_TYPE::EDGE_VERTICES;
+    for (auto j : make_range(ELEMENT_TYPE::N_EDGES))
+        topo.edge_order[j] = j;
+    return topo;
+}
+
+template <class ELEMENT_TYPE>
+ElementTopology
+build_topology_3d()
+{
+    ElementTopology topo;
+    topo.n_faces = ELEMENT_TYPE::N_FACES;
+    topo.n_edges = ELEMENT_TYPE::N_EDGES;
+    topo.face_vertices = &ELEMENT_TYPE::FACE_VERTICES;
+    topo.face_edges = &ELEMENT_TYPE::FACE_EDGES;
+    topo.edge_vertices = &ELEMENT_TYPE::EDGE_VERTICES;
+    // edges of 3D elements are discovered by walking over the edges of their faces
+    std::array<bool, 12> seen = {};
+    u8 pos = 0;
+    for (const auto & fe : ELEMENT_TYPE::FACE_EDGES)
+        for (auto edge : fe)
+            if (!seen[edge]) {
+                seen[edge] = true;
+                topo.edge_order[edge] = pos++;
+            }
+    return topo;
+}
+
+const ElementTopology &
+topology(ElementType type)
+{
+    static const ElementTopology none;
+    static const ElementTopology tri3 = build_topology_2d<Tri3>();
+    static const ElementTopology quad4 = build_topology_2d<Quad4>();
+    static const ElementTopology tetra4 = build_topology_3d<Tetra4>();
+    static const ElementTopology pyramid5 = build_topology_3d<Pyramid5>();
+    static const ElementTopology prism6 = build_topology_3d<Prism6>();
+    static const ElementTopology hex8 = build_topology_3d<Hex8>();
+
+    switch (type) {
+    case ElementType::TRI3:
+        return tri3;
+    case ElementType::QUAD4:
+        return quad4;
+    case ElementType::TETRA4:
+        return tetra4;
+    case ElementType::PYRAMID5:
+        return pyramid5;
+    case ElementType::PRISM6:
+        return prism6;
+    case ElementType::HEX8:
+        return hex8;
+    default:
+        return none;
+    }
+}
+
+/// Sorted and deduplicated entities (faces or edges) of a mesh
+template <typename RECORD>
+struct EntityTable {
+    /// Hasse index of the first entity
+    u64 base = 0;
+    /// Number of unique entities
+    u64 count = 0;
+    /// Per-element offsets into `ids`
+    std::vector<u64> elem_ofst;
+    /// Hasse index of every (element, local entity) pair
+    std::vector<Index> ids;
+    /// Element where a unique entity was seen for the first time
+    std::vector<Index> first_elem;
+    /// Local number of a unique entity in its first element
+    std::vector<u8> first_local;
+};
+
+/// Deduplicate element entities and number them in the order of their first appearance
+///
+/// @param records Entity records sorted by `record_less`
+/// @param table Entity table with `elem_ofst` and `base` filled in
+/// @param slot Function mapping a record to its position in the global discovery order
+template <typename RECORD, typename SLOT>
+void
+number_entities(const std::vector<RECORD> & records, EntityTable<RECORD> & table, SLOT slot)
+{
+    const std::size_t n = records.size();
+    auto n_slots = table.elem_ofst.back();
+    // process groups of equal vertex tuples that start within [begin, end)
+    auto for_each_group = [&](auto fn) {
+        parallel_for_chunks(n, 4096, [&](std::size_t begin, std::size_t end) {
+            auto i = begin;
+            while (i > 0 && i < end && records[i].vtx == records[i - 1].vtx)
+                ++i;
+            while (i < end) {
+                auto j = i + 1;
+                auto first = slot(records[i]);
+                auto rep = i;
+                for (; j < n && records[j].vtx == records[i].vtx; ++j) {
+                    auto s = slot(records[j]);
+                    if (s < first) {
+                        first = s;
+                        rep = j;
+                    }
+                }
+                fn(i, j, rep, first);
+                i = j;
+            }
+        });
+    };
+
+    // rank the first occurrences, this gives the entity numbering
+    std::vector<u64> rank(n_slots + 1, 0);
+    for_each_group([&](std::size_t, std::size_t, std::size_t, u64 first) { rank[first + 1] = 1; });
+    table.count = parallel_offsets(rank);
+
+    table.ids.resize(n_slots);
+    table.first_elem.resize(table.count);
+    table.first_local.resize(table.count);
+    for_each_group([&](std::size_t i, std::size_t j, std::size_t rep, u64 first) {
+        auto idx = rank[first];
+        table.first_elem[idx] = records[rep].elem;
+        table.first_local[idx] = records[rep].local;
+        auto id = static_cast<Index>(table.base + idx);
+        for (auto k = i; k < j; ++k)
+            table.ids[table.elem_ofst[records[k].elem] + records[k].local] = id;
+    });
+}
+
+std::vector<u64>
+element_offsets(ElementsView elems, u8 ElementTopology::*n_entities)
+{
+    std::vector<u64> ofst(elems.size() + 1, 0);
+    parallel_for(elems.size(), [&](std::size_t i) {
+        ofst[i + 1] = topology(elems[i].type()).*n_entities;
+    });
+    parallel_offsets(ofst);
+    return ofst;
+}
+
+EntityTable<FaceRecord>
+build_faces(ElementsView elems, u64 base)
+{
+    EntityTable<FaceRecord> table;
+    table.base = base;
+    table.elem_ofst = element_offsets(elems, &ElementTopology::n_faces);
+
+    std::vector<FaceRecord> records(table.elem_ofst.back());
+    parallel_for(elems.size(), [&](std::size_t i) {
+        const auto & topo = topology(elems[i].type());
+        auto connect = elems[i].indices();
+        for (auto j : make_range(topo.n_faces)) {
+            auto & rec = records[table.elem_ofst[i] + j];
+            rec.vtx.fill(std::numeric_limits<Index>::max());
+            const auto & lv = (*topo.face_vertices)[j];
+            for (auto k : make_range(lv.size()))
+                rec.vtx[k] = connect[lv[k]];
+            std::sort(rec.vtx.begin(), rec.vtx.begin() + lv.size());
+            rec.elem = i;
+            rec.local = j;
+        }
+    });
+    parallel_sort(records, record_less<FaceRecord>);
+
+    number_entities(records, table, [&](const FaceRecord & rec) {
+        return table.elem_ofst[rec.elem] + rec.local;
+    });
+    return table;
+}
+
+EntityTable<EdgeRecord>
+build_edges(ElementsView elems, u64 base)
+{
+    EntityTable<EdgeRecord> table;
+    table.base = base;
+    table.elem_ofst = element_offsets(elems, &ElementTopology::n_edges);
+
+    std::vector<EdgeRecord> records(table.elem_ofst.back());
+    parallel_for(elems.size(), [&](std::size_t i) {
+        const auto & topo = topology(elems[i].type());
+        auto connect = elems[i].indices();
+        for (auto j : make_range(topo.n_edges)) {
+            auto & rec = records[table.elem_ofst[i] + j];
+            auto ec = utils::edge_connect(connect, (*topo.edge_vertices)[j]);
+            rec.vtx = { std::min(ec[0], ec[1]), std::max(ec[0], ec[1]) };
+            rec.elem = i;
+            rec.local = j;
+        }
+    });
+    parallel_sort(records, record_less<EdgeRecord>);
+
+    number_entities(records, table, [&](const EdgeRecord & rec) {
+        const auto & topo = topology(elems[rec.elem].type());
+        return table.elem_ofst[rec.elem] + topo.edge_order[rec.local];
+    });
+    return table;
+}
+
+/// Append `v` into `children` unless it is already there
+void
+add_child(std::array<HasseIndex, MAX_CHILDREN> & children, std::size_t & n, HasseIndex v)
+{
+    for (auto i : make_range(n))
+        if (children[i] == v)
+            return;
+    children[n++] = v;
+}
+
+} // namespace
+
+HasseDiagram::HasseDiagram(const Mesh & mesh, Flags<Relation> relations)
 {
     Log::info(2, "Building Hasse diagram");
     LoggingTimer timer;
@@ -17,180 +288,127 @@ HasseDiagram::HasseDiagram(const Mesh & mesh)
     auto elems = mesh.elements();
     auto pnts = mesh.points();
 
-    std::unordered_map<HasseKey, HasseIndex> key_map;
-    HasseKey n_entries(elems.size() + pnts.size());
-    for (const auto & cell : elems) {
-        if (cell.type() == ElementType::TRI3) {
-            n_entries += Tri3::N_EDGES;
-        }
-        else if (cell.type() == ElementType::QUAD4) {
-            n_entries += Quad4::N_EDGES;
-        }
-        else if (cell.type() == ElementType::TETRA4) {
-            n_entries += Tetra4::N_EDGES;
-            n_entries += Tetra4::N_FACES;
-        }
-        else if (cell.type() == ElementType::PYRAMID5) {
-            n_entries += Pyramid5::N_EDGES;
-            n_entries += Pyramid5::N_FACES;
-        }
-        else if (cell.type() == ElementType::PRISM6) {
-            n_entries += Prism6::N_EDGES;
-            n_entries += Prism6::N_FACES;
-        }
-        else if (cell.type() == ElementType::HEX8) {
-            n_entries += Hex8::N_EDGES;
-            n_entries += Hex8::N_FACES;
-        }
-        else if (cell.type() == ElementType::LINE2) {
-            // do nothing
-        }
-    }
-    key_map.reserve(n_entries.value());
-
-    // Count number of nodes
-    HasseKey n_rows(0);
-    for (Index i : make_range(elems.size())) {
-        auto id = key(-(HasseIndex(i) + 1));
-        HasseIndex elem_node_id(n_rows++);
-        key_map[id] = elem_node_id;
-    }
-    this->cell_rng_ = make_range(HasseIndex(0), HasseIndex(elems.size()));
-    for (Index i : make_range(pnts.size())) {
-        auto vtx_id = key(HasseIndex(i));
-        HasseIndex vtx_node_id(n_rows++);
-        key_map[vtx_id] = vtx_node_id;
-    }
-    this->vertex_rng_ = make_range(HasseIndex(elems.size()), HasseIndex(key_map.size()));
-    u64 a = key_map.size();
-    for (Index i : make_range(elems.size())) {
-        const auto & cell = elems[i];
-        if (cell.type() == ElementType::TETRA4)
-            add_faces_nd<Tetra4>(key_map, n_rows, cell);
-        else if (cell.type() == ElementType::PYRAMID5)
-            add_faces_nd<Pyramid5>(key_map, n_rows, cell);
-        else if (cell.type() == ElementType::PRISM6)
-            add_faces_nd<Prism6>(key_map, n_rows, cell);
-        else if (cell.type() == ElementType::HEX8)
-            add_faces_nd<Hex8>(key_map, n_rows, cell);
-    }
-    this->face_rng_ = make_range(HasseIndex(a), HasseIndex(key_map.size()));
-    a = key_map.size();
-    for (Index i : make_range(elems.size())) {
-        const auto & cell = elems[i];
-        if (cell.type() == ElementType::TRI3)
-            add_edges_nd<Tri3>(key_map, n_rows, cell);
-        else if (cell.type() == ElementType::QUAD4)
-            add_edges_nd<Quad4>(key_map, n_rows, cell);
-        else if (cell.type() == ElementType::TETRA4)
-            add_face_edges_nd<Tetra4>(key_map, n_rows, cell);
-        else if (cell.type() == ElementType::PYRAMID5)
-            add_face_edges_nd<Pyramid5>(key_map, n_rows, cell);
-        else if (cell.type() == ElementType::PRISM6)
-            add_face_edges_nd<Prism6>(key_map, n_rows, cell);
-        else if (cell.type() == ElementType::HEX8)
-            add_face_edges_nd<Hex8>(key_map, n_rows, cell);
-        else if (cell.type() == ElementType::LINE2) {
-            // do nothing
-        }
-    }
-    this->edge_rng_ = make_range(HasseIndex(a), HasseIndex(key_map.size()));
-    this->out_offsets_.resize(n_rows.value() + 1, 0);
-    this->in_offsets_.resize(n_rows.value() + 1, 0);
-    this->out_inc_.resize(n_rows.value(), 0);
-    this->in_inc_.resize(n_rows.value(), 0);
-
-    // Count number of edges
-    std::unordered_map<HasseKey, HasseIndex> edge_key_map;
-    edge_key_map.reserve(2 * n_entries.value());
-    for (Index i : make_range(elems.size())) {
-        const auto & cell = elems[i];
-        if (cell.type() == ElementType::TRI3) {
-            add_edges_ed<Tri3>(edge_key_map, key_map, HasseIndex(i), cell);
-            add_edge_vertices_ed<Tri3>(edge_key_map, key_map, HasseIndex(i), cell);
-        }
-        else if (cell.type() == ElementType::QUAD4) {
-            add_edges_ed<Quad4>(edge_key_map, key_map, HasseIndex(i), cell);
-            add_edge_vertices_ed<Quad4>(edge_key_map, key_map, HasseIndex(i), cell);
-        }
-        else if (cell.type() == ElementType::TETRA4) {
-            add_faces_ed<Tetra4>(edge_key_map, key_map, HasseIndex(i), cell);
-            add_face_edges_ed<Tetra4>(edge_key_map, key_map, HasseIndex(i), cell);
-            add_edge_vertices_ed<Tetra4>(edge_key_map, key_map, HasseIndex(i), cell);
+    const u64 n_cells = elems.size();
+    const u64 n_vertices = pnts.size();
+    auto faces = build_faces(elems, n_cells + n_vertices);
+    auto edges = build_edges(elems, faces.base + faces.count);
+    const u64 n_nodes = edges.base + edges.count;
+    if (n_nodes > std::numeric_limits<Index>::max())
+        throw Exception("Mesh is too large for the Hasse diagram ({} nodes)", n_nodes);
+
+    this->cell_rng_ = make_range(HasseIndex(0), HasseIndex(n_cells));
+    this->vertex_rng_ = make_range(HasseIndex(n_cells), HasseIndex(faces.base));
+    this->face_rng_ = make_range(HasseIndex(faces.base), HasseIndex(edges.base));
+    this->edge_rng_ = make_range(HasseIndex(edges.base), HasseIndex(n_nodes));
+
+    // Children of a node in the order they are connected to it: cells point to their faces (3D),
+    // edges (2D) or vertices (1D), faces point to their edges and edges to their vertices. Faces
+    // and edges take the orientation of the element they were first seen in.
+    auto children = [&](u64 node, std::array<HasseIndex, MAX_CHILDREN> & ch) {
+        std::size_t n = 0;
+        if (node < n_cells) {
+            const auto & elem = elems[node];
+            const auto & topo = topology(elem.type());
+            if (topo.n_faces > 0) {
+                for (auto j : make_range(topo.n_faces))
+                    add_child(ch, n, HasseIndex(faces.ids[faces.elem_ofst[node] + j]));
+            }
+            else if (topo.n_edges > 0) {
+                for (auto j : make_range(topo.n_edges))
+                    add_child(ch, n, HasseIndex(edges.ids[edges.elem_ofst[node] + j]));
+            }
+            else if (elem.type() == ElementType::LINE2) {
+                for (auto j : make_range(Line2::N_VERTICES))
+                    add_child(ch, n, HasseIndex(n_cells + elem.index(Line2::EDGE_VERTICES[j])));
+            }
         }
-        else if (cell.type() == ElementType::PYRAMID5) {
-            add_faces_ed<Pyramid5>(edge_key_map, key_map, HasseIndex(i), cell);
-            add_face_edges_ed<Pyramid5>(edge_key_map, key_map, HasseIndex(i), cell);
-            add_edge_vertices_ed<Pyramid5>(edge_key_map, key_map, HasseIndex(i), cell);
+        else if (this->face_rng_.contains(HasseIndex(node))) {
+            auto idx = node - faces.base;
+            auto elem_id = faces.first_elem[idx];
+            const auto & topo = topology(elems[elem_id].type());
+            for (auto edge : (*topo.face_edges)[faces.first_local[idx]])
+                add_child(ch, n, HasseIndex(edges.ids[edges.elem_ofst[elem_id] + edge]));
         }
-        else if (cell.type() == ElementType::PRISM6) {
-            add_faces_ed<Prism6>(edge_key_map, key_map, HasseIndex(i), cell);
-            add_face_edges_ed<Prism6>(edge_key_map, key_map, HasseIndex(i), cell);
-            add_edge_vertices_ed<Prism6>(edge_key_map, key_map, HasseIndex(i), cell);
+        else if (this->edge_rng_.contains(HasseIndex(node))) {
+            auto idx = node - edges.base;
+            const auto & elem = elems[edges.first_elem[idx]];
+            const auto & topo = topology(elem.type());
+            for (auto lv : (*topo.edge_vertices)[edges.first_local[idx]])
+                add_child(ch, n, HasseIndex(n_cells + elem.index(lv)));
         }
-        else if (cell.type() == ElementType::HEX8) {
-            add_faces_ed<Hex8>(edge_key_map, key_map, HasseIndex(i), cell);
-            add_face_edges_ed<Hex8>(edge_key_map, key_map, HasseIndex(i), cell);
-            add_edge_vertices_ed<Hex8>(edge_key_map, key_map, HasseIndex(i), cell);
+        return n;
+    };
+
+    // Order of parents in the in-edges: the position where the (parent, child) connection was
+    // first made while walking the elements
+    auto parent_key = [&](HasseIndex parent) -> u64 {
+        auto node = parent.value();
+        if (node < n_cells)
+            return node << 8;
+        else if (this->face_rng_.contains(parent)) {
+            auto idx = node - faces.base;
+            return (u64(faces.first_elem[idx]) << 8) | faces.first_local[idx];
         }
-        else if (cell.type() == ElementType::LINE2) {
-            add_vertices_ed(edge_key_map, key_map, HasseIndex(i), cell);
+        else {
+            auto idx = node - edges.base;
+            return (u64(edges.first_elem[idx]) << 8) | edges.first_local[idx];
         }
-    }
-    u64 ofst = 0;
-    for (auto i : make_range(this->out_offsets_.size() - 1)) {
-        ofst += this->out_offsets_[i + 1];
-        this->out_offsets_[i + 1] = ofst;
-    }
+    };
 
-    ofst = 0;
-    for (auto i : make_range(this->in_offsets_.size() - 1)) {
-        ofst += this->in_offsets_[i + 1];
-        this->in_offsets_[i + 1] = ofst;
+    // out-edges
+    if (relations & DOWNWARD) {
+        auto & offsets = this->out_.offsets64;
+        offsets.assign(n_nodes + 1, 0);
+        parallel_for(n_nodes, [&](std::size_t node) {
+            std::array<HasseIndex, MAX_CHILDREN> ch;
+            offsets[node + 1] = children(node, ch);
+        });
+        auto n_edges = parallel_offsets(offsets);
+        this->out_.adjacency.resize(n_edges);
+        parallel_for(n_nodes, [&](std::size_t node) {
+            std::array<HasseIndex, MAX_CHILDREN> ch;
+            auto n = children(node, ch);
+            std::copy_n(ch.begin(), n, this->out_.adjacency.begin() + offsets[node]);
+        });
+        this->out_.compact();
     }
 
-    // Fill in the values
-    u64 n_edges = edge_key_map.size();
-    this->out_adjacency_.resize(n_edges);
-    this->in_adjacency_.resize(n_edges);
-
-    for (Index i : make_range(elems.size())) {
-        const auto & cell = elems[i];
-        if (cell.type() == ElementType::TRI3) {
-            add_edges<Tri3>(key_map, HasseIndex(i), cell);
-            add_edge_vertices<Tri3>(key_map, HasseIndex(i), cell);
-        }
-        else if (cell.type() == ElementType::QUAD4) {
-            add_edges<Quad4>(key_map, HasseIndex(i), cell);
-            add_edge_vertices<Quad4>(key_map, HasseIndex(i), cell);
-        }
-        else if (cell.type() == ElementType::TETRA4) {
-            add_faces<Tetra4>(key_map, HasseIndex(i), cell);
-            add_face_edges<Tetra4>(key_map, HasseIndex(i), cell);
-            add_edge_vertices<Tetra4>(key_map, HasseIndex(i), cell);
-        }
-        else if (cell.type() == ElementType::PYRAMID5) {
-            add_faces<Pyramid5>(key_map, HasseIndex(i), cell);
-            add_face_edges<Pyramid5>(key_map, HasseIndex(i), cell);
-            add_edge_vertices<Pyramid5>(key_map, HasseIndex(i), cell);
-        }
-        else if (cell.type() == ElementType::PRISM6) {
-            add_faces<Prism6>(key_map, HasseIndex(i), cell);
-            add_face_edges<Prism6>(key_map, HasseIndex(i), cell);
-            add_edge_vertices<Prism6>(key_map, HasseIndex(i), cell);
-        }
-        else if (cell.type() == ElementType::HEX8) {
-            add_faces<Hex8>(key_map, HasseIndex(i), cell);
-            add_face_edges<Hex8>(key_map, HasseIndex(i), cell);
-            add_edge_vertices<Hex8>(key_map, HasseIndex(i), cell);
-        }
-        else if (cell.type() == ElementType::LINE2) {
-            add_vertices(key_map, HasseIndex(i), cell);
-        }
+    // in-edges (built from `children` directly, so they do not need the out-edges)
+    if (relations & UPWARD) {
+        auto & offsets = this->in_.offsets64;
+        offsets.assign(n_nodes + 1, 0);
+        parallel_for(n_nodes, [&](std::size_t node) {
+            std::array<HasseIndex, MAX_CHILDREN> ch;
+            auto n = children(node, ch);
+            for (auto i : make_range(n))
+                std::atomic_ref<u64>(offsets[ch[i].value() + 1]).fetch_add(1);
+        });
+        auto n_edges = parallel_offsets(offsets);
+        this->in_.adjacency.resize(n_edges);
+        std::vector<u64> in_inc(offsets.begin(), offsets.end() - 1);
+        parallel_for(n_nodes, [&](std::size_t node) {
+            std::array<HasseIndex, MAX_CHILDREN> ch;
+            auto n = children(node, ch);
+            for (auto i : make_range(n)) {
+                auto pos = std::atomic_ref<u64>(in_inc[ch[i].value()]).fetch_add(1);
+                this->in_.adjacency[pos] = HasseIndex(node);
+            }
+        });
+        std::vector<u64>().swap(in_inc);
+        parallel_for(n_nodes, [&](std::size_t node) {
+            auto first = this->in_.adjacency.begin() + offsets[node];
+            auto last = this->in_.adjacency.begin() + offsets[node + 1];
+            std::sort(first, last, [&](HasseIndex a, HasseIndex b) {
+                return parent_key(a) < parent_key(b);
+            });
+        });
+        this->in_.compact();
     }
 
-    this->out_inc_.clear();
-    this->in_inc_.clear();
+    Log::info(2,
+              "Hasse diagram: {} nodes, memory {}",
+              utils::human_number(n_nodes),
+              utils::human_bytes(memory_usage()));
 }
 
 TRange<HasseIndex>
@@ -220,17 +438,35 @@ HasseDiagram::cells() const
 Span<const HasseIndex>
 HasseDiagram::out_vertices(HasseIndex entity_id) const
 {
-    auto start = this->out_offsets_[entity_id.value()];
-    auto end = this->out_offsets_[entity_id.value() + 1];
-    return { this->out_adjacency_.data() + start, static_cast<size_t>(end - start) };
+    if (this->out_.empty())
+        throw Exception("Downward relation was not built for this Hasse diagram");
+    return this->out_.row(entity_id.value());
 }
 
 Span<const HasseIndex>
 HasseDiagram::in_vertices(HasseIndex entity_id) const
 {
-    auto start = this->in_offsets_[entity_id.value()];
-    auto end = this->in_offsets_[entity_id.value() + 1];
-    return { this->in_adjacency_.data() + start, static_cast<size_t>(end - start) };
+    if (this->in_.empty())
+        throw Exception("Upward relation was not built for this Hasse diagram");
+    return this->in_.row(entity_id.value());
+}
+
+bool
+HasseDiagram::has_downward() const
+{
+    return !this->out_.empty();
+}
+
+bool
+HasseDiagram::has_upward() const
+{
+    return !this->in_.empty();
+}
+
+std::size_t
+HasseDiagram::memory_usage() const
+{
+    return this->out_.memory_usage() + this->in_.memory_usage();
 }
 
 void
@@ -240,27 +476,71 @@ HasseDiagram::print() const
     std::cerr << "elm: " << this->cell_rng_ << std::endl;
     std::cerr << "fac: " << this->face_rng_ << std::endl;
     std::cerr << "edg: " << this->edge_rng_ << std::endl;
-    for (auto i : make_range(this->out_offsets_.size() - 1)) {
-        auto start = this->out_offsets_[i];
-        auto end = this->out_offsets_[i + 1];
-
-        std::cerr << i << ":";
-        for (auto j : make_range(start, end)) {
-            std::cerr << " " << this->out_adjacency_[j].value();
+    auto print_adjacency = [](const Adjacency & adj) {
+        for (auto i : make_range(adj.size())) {
+            std::cerr << i << ":";
+            for (auto & v : adj.row(i))
+                std::cerr << " " << v.value();
+            std::cerr << std::endl;
         }
-        std::cerr << std::endl;
-    }
+    };
+    print_adjacency(this->out_);
     std::cerr << "--" << std::endl;
-    for (auto i : make_range(this->in_offsets_.size() - 1)) {
-        auto start = this->in_offsets_[i];
-        auto end = this->in_offsets_[i + 1];
+    print_adjacency(this->in_);
+}
 
-        std::cerr << i << ":";
-        for (auto j : make_range(start, end)) {
-            std::cerr << " " << this->in_adjacency_[j].value();
-        }
-        std::cerr << std::endl;
+// Adjacency
+
+std::size_t
+HasseDiagram::Adjacency::size() const
+{
+    if (!this->offsets32.empty())
+        return this->offsets32.size() - 1;
+    else if (!this->offsets64.empty())
+        return this->offsets64.size() - 1;
+    else
+        return 0;
+}
+
+bool
+HasseDiagram::Adjacency::empty() const
+{
+    return this->offsets32.empty() && this->offsets64.empty();
+}
+
+Span<const HasseIndex>
+HasseDiagram::Adjacency::row(std::size_t i) const
+{
+    u64 start, end;
+    if (!this->offsets32.empty()) {
+        start = this->offsets32[i];
+        end = this->offsets32[i + 1];
     }
+    else {
+        start = this->offsets64[i];
+        end = this->offsets64[i + 1];
+    }
+    return { this->adjacency.data() + start, static_cast<size_t>(end - start) };
+}
+
+void
+HasseDiagram::Adjacency::compact()
+{
+    if (this->offsets64.empty() || this->offsets64.back() > std::numeric_limits<u32>::max())
+        return;
+
+    this->offsets32.resize(this->offsets64.size());
+    parallel_for(this->offsets64.size(), [&](std::size_t i) {
+        this->offsets32[i] = static_cast<u32>(this->offsets64[i]);
+    });
+    std::vector<u64>().swap(this->offsets64);
+}
+
+std::size_t
+HasseDiagram::Adjacency::memory_usage() const
+{
+    return this->offsets64.capacity() * sizeof(u64) + this->offsets32.capacity() * sizeof(u32) +
+           this->adjacency.capacity() * sizeof(HasseIndex);
 }
 
 } // namespace krado
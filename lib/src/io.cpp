@@ -3,6 +3,8 @@
 
 #include "krado/io.h"
 #include "krado/exodusii_file.h"
+#include "krado/gmsh_file.h"
+#include "krado/kmesh_file.h"
 #include "krado/step_file.h"
 #include "krado/iges_file.h"
 #include "krado/utils.h"
@@ -13,8 +15,30 @@ namespace krado {
 void
 IO::export_mesh(Ptr<const Mesh> mesh, const std::filesystem::path & file_name)
 {
+    auto ext = utils::to_lower(file_name.extension());
+    if (ext == ".kmesh") {
+        KMeshFile file(file_name);
+        file.write(mesh);
+    }
+    else if (ext == ".msh") {
+        GmshFile file(file_name);
+        file.write(mesh);
+    }
+    else
+        export_mesh(mesh, file_name, ExodusIIFile::Options());
+}
+
+void
+IO::export_mesh(Ptr<const Mesh> mesh,
+                const std::filesystem::path & file_name,
+                const ExodusIIFile::Options & opts)
+{
+    auto ext = utils::to_lower(file_name.extension());
+    if (ext == ".kmesh" || ext == ".msh")
+        throw Exception("ExodusII options cannot be used for '{}' files.", ext);
+
     try {
-        ExodusIIFile file(file_name);
+        ExodusIIFile file(file_name, opts);
         file.write(mesh);
     }
     catch (exodusIIcpp::Exception & e) {
@@ -25,6 +49,16 @@ IO::export_mesh(Ptr<const Mesh> mesh, const std::filesystem::path & file_name)
 Ptr<Mesh>
 IO::import_mesh(const std::filesystem::path & file_name)
 {
+    auto ext = utils::to_lower(file_name.extension());
+    if (ext == ".kmesh") {
+        KMeshFile file(file_name);
+        return file.read();
+    }
+    else if (ext == ".msh") {
+        GmshFile file(file_name);
+        return file.read();
+    }
+
     try {
         ExodusIIFile file(file_name);
         return file.read();
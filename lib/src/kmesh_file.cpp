@@ -0,0 +1,529 @@
+// SPDX-FileCopyrightText: 2026 David Andrs <andrsd@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "krado/kmesh_file.h"
+#include "krado/exception.h"
+#include "krado/log.h"
+#include "krado/timer.h"
+#include "krado/utils.h"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <type_traits>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace krado {
+
+namespace {
+
+const char MAGIC[8] = { 'K', 'R', 'A', 'D', 'O', 'M', 'S', 'H' };
+const u32 VERSION = 1;
+/// Written in the byte order of the machine, used to detect files from other architectures
+const u32 BYTE_ORDER_MARK = 0x01020304;
+/// Alignment of sections in the file
+const std::size_t ALIGNMENT = 64;
+
+/// Kinds of sections
+enum SectionKind : u32 {
+    X = 1,
+    Y,
+    Z,
+    ELEM_TYPES,
+    ELEM_OFFSETS,
+    ELEM_IDS,
+    /// `SetRecord` for every cell, side and node set
+    SETS,
+    /// `SetRecord` for every set name (`first` and `count` point into `NAMES`)
+    SET_NAMES,
+    CELL_SET_IDS,
+    SIDE_SET_ELEMS,
+    SIDE_SET_SIDES,
+    NODE_SET_IDS,
+    NAMES,
+    /// `HasseRecord`
+    HASSE,
+    HASSE_OUT_OFFSETS,
+    HASSE_OUT_ADJACENCY,
+    HASSE_IN_OFFSETS,
+    HASSE_IN_ADJACENCY
+};
+
+/// Kinds of sets
+enum SetKind : u32 { CELL_SET = 0, SIDE_SET = 1, NODE_SET = 2 };
+
+struct Header {
+    char magic[8];
+    u32 version;
+    u32 byte_order;
+    u64 n_sections;
+    u64 n_points;
+    u64 n_elements;
+    u8 reserved[24];
+};
+static_assert(sizeof(Header) == 64);
+
+struct SectionEntry {
+    u32 kind;
+    /// Size of one item in bytes
+    u32 item_size;
+    /// Offset from the beginning of the file
+    u64 offset;
+    /// Number of items
+    u64 count;
+    u64 reserved;
+};
+static_assert(sizeof(SectionEntry) == 32);
+
+/// Set (or set name) stored in a section
+struct SetRecord {
+    u32 kind;
+    Marker id;
+    /// First item of the set in the data section
+    u64 first;
+    /// Number of items
+    u64 count;
+};
+
+/// Ranges and offset widths of a Hasse diagram
+struct HasseRecord {
+    /// First and last index of vertices, edges, faces and cells
+    u32 ranges[8];
+    /// Size of the downward and upward offsets in bytes (0 if the relation is not stored)
+    u32 out_offset_size;
+    u32 in_offset_size;
+};
+
+/// Section to be written
+struct Section {
+    u32 kind;
+    u32 item_size;
+    const void * data;
+    u64 count;
+};
+
+template <typename T>
+Section
+make_section(u32 kind, const T * data, std::size_t count)
+{
+    static_assert(std::is_trivially_copyable_v<T>);
+    return { kind, static_cast<u32>(sizeof(T)), data, count };
+}
+
+template <typename T>
+Section
+make_section(u32 kind, const std::vector<T> & data)
+{
+    return make_section(kind, data.data(), data.size());
+}
+
+std::size_t
+align(std::size_t n)
+{
+    return (n + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+}
+
+/// Read-only memory mapping of a file
+class MappedFile {
+public:
+    explicit MappedFile(const std::string & file_name)
+    {
+        int fd = ::open(file_name.c_str(), O_RDONLY);
+        if (fd < 0)
+            throw Exception("Failed to open '{}'.", file_name);
+        struct stat st;
+        if (::fstat(fd, &st) != 0) {
+            ::close(fd);
+            throw Exception("Failed to open '{}'.", file_name);
+        }
+        this->size_ = st.st_size;
+        if (this->size_ > 0) {
+            this->data_ = ::mmap(nullptr, this->size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (this->data_ == MAP_FAILED)
+                this->data_ = nullptr;
+        }
+        // the mapping stays valid after the file is closed
+        ::close(fd);
+        if (this->data_ == nullptr)
+            throw Exception("Failed to map '{}' into memory.", file_name);
+    }
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile & operator=(const MappedFile &) = delete;
+
+    ~MappedFile() { ::munmap(this->data_, this->size_); }
+
+    [[nodiscard]] const char *
+    data() const
+    {
+        return static_cast<const char *>(this->data_);
+    }
+
+    [[nodiscard]] std::size_t
+    size() const
+    {
+        return this->size_;
+    }
+
+private:
+    void * data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+/// Sections of a mapped `.kmesh` file
+class Sections {
+public:
+    Sections(const MappedFile & file, const std::string & file_name) :
+        file_(file),
+        fn_(file_name)
+    {
+        if (file.size() < sizeof(Header))
+            throw Exception("'{}' is not a .kmesh file", file_name);
+        std::memcpy(&this->header_, file.data(), sizeof(Header));
+        if (std::memcmp(this->header_.magic, MAGIC, sizeof(MAGIC)) != 0)
+            throw Exception("'{}' is not a .kmesh file", file_name);
+        if (this->header_.version != VERSION)
+            throw Exception("Unsupported .kmesh version {} in '{}'",
+                            this->header_.version,
+                            file_name);
+        if (this->header_.byte_order != BYTE_ORDER_MARK)
+            throw Exception("'{}' was written on a machine with a different byte order", file_name);
+
+        auto n = this->header_.n_sections;
+        if (n > (file.size() - sizeof(Header)) / sizeof(SectionEntry))
+            throw Exception("Corrupted .kmesh file '{}'", file_name);
+        this->entries_.resize(n);
+        std::memcpy(this->entries_.data(),
+                    file.data() + sizeof(Header),
+                    n * sizeof(SectionEntry));
+        for (auto & e : this->entries_)
+            if (e.offset % ALIGNMENT != 0 || e.offset > file.size() ||
+                e.count > (file.size() - e.offset) / std::max<u32>(e.item_size, 1))
+                throw Exception("Corrupted .kmesh file '{}'", file_name);
+    }
+
+    [[nodiscard]] const Header &
+    header() const
+    {
+        return this->header_;
+    }
+
+    /// Copy section into a vector (empty if the file does not have the section)
+    template <typename T>
+    [[nodiscard]] std::vector<T>
+    get(u32 kind) const
+    {
+        std::vector<T> vec;
+        auto * e = find(kind);
+        if (e != nullptr) {
+            if (e->item_size != sizeof(T))
+                throw Exception("Corrupted .kmesh file '{}'", this->fn_);
+            vec.resize(e->count);
+            std::memcpy(vec.data(), this->file_.data() + e->offset, e->count * sizeof(T));
+        }
+        return vec;
+    }
+
+private:
+    [[nodiscard]] const SectionEntry *
+    find(u32 kind) const
+    {
+        for (auto & e : this->entries_)
+            if (e.kind == kind)
+                return &e;
+        return nullptr;
+    }
+
+    const MappedFile & file_;
+    std::string fn_;
+    Header header_;
+    std::vector<SectionEntry> entries_;
+};
+
+/// Check that sets lie inside their data section
+void
+check_sets(const std::vector<SetRecord> & sets,
+           const std::array<std::size_t, 3> & n_items,
+           const std::string & file_name)
+{
+    for (auto & s : sets)
+        if (s.kind > NODE_SET || s.first > n_items[s.kind] || s.count > n_items[s.kind] - s.first)
+            throw Exception("Corrupted .kmesh file '{}'", file_name);
+}
+
+/// Check that offsets start at zero, do not decrease and end at the number of items
+template <typename T>
+bool
+valid_offsets(const std::vector<T> & offsets, std::size_t n_items)
+{
+    return !offsets.empty() && offsets.front() == 0 && offsets.back() == n_items &&
+           std::is_sorted(offsets.begin(), offsets.end());
+}
+
+/// Check that all values are smaller than `n`
+template <typename T>
+bool
+all_less(const std::vector<T> & values, std::size_t n)
+{
+    return std::all_of(values.begin(), values.end(), [n](T v) { return v < n; });
+}
+
+} // namespace
+
+KMeshFile::KMeshFile(const std::filesystem::path & file_name) : fn_(file_name.string()) {}
+
+Ptr<Mesh>
+KMeshFile::read()
+{
+    Log::info("Reading krado mesh file '{}'", this->fn_);
+    LoggingTimer timer;
+
+    MappedFile file(this->fn_);
+    Sections sections(file, this->fn_);
+    const auto & hdr = sections.header();
+
+    auto x = sections.get<double>(X);
+    auto y = sections.get<double>(Y);
+    auto z = sections.get<double>(Z);
+    if (x.size() != hdr.n_points || y.size() != hdr.n_points || z.size() != hdr.n_points)
+        throw Exception("Corrupted .kmesh file '{}'", this->fn_);
+    auto types = sections.get<ElementType>(ELEM_TYPES);
+    auto offsets = sections.get<Index>(ELEM_OFFSETS);
+    auto ids = sections.get<Index>(ELEM_IDS);
+    if (types.size() != hdr.n_elements || offsets.size() != types.size() + 1 ||
+        !valid_offsets(offsets, ids.size()) || !all_less(ids, hdr.n_points) ||
+        !std::all_of(types.begin(), types.end(), [](ElementType t) {
+            return t < ElementType::INVALID;
+        }))
+        throw Exception("Corrupted .kmesh file '{}'", this->fn_);
+    Connectivity elems(std::move(types), std::move(offsets), std::move(ids));
+    auto mesh =
+        Ptr<Mesh>::alloc(Coordinates(std::move(x), std::move(y), std::move(z)), std::move(elems));
+
+    // sets
+    auto cell_ids = sections.get<Index>(CELL_SET_IDS);
+    auto side_elems = sections.get<Index>(SIDE_SET_ELEMS);
+    auto side_sides = sections.get<u8>(SIDE_SET_SIDES);
+    auto node_ids = sections.get<Index>(NODE_SET_IDS);
+    auto names = sections.get<char>(NAMES);
+    if (side_elems.size() != side_sides.size() || !all_less(cell_ids, hdr.n_elements) ||
+        !all_less(side_elems, hdr.n_elements) || !all_less(node_ids, hdr.n_points))
+        throw Exception("Corrupted .kmesh file '{}'", this->fn_);
+    for (std::size_t i = 0; i < side_elems.size(); ++i)
+        if (side_sides[i] >= facet_count(mesh->element_type(side_elems[i])))
+            throw Exception("Corrupted .kmesh file '{}'", this->fn_);
+    auto sets = sections.get<SetRecord>(SETS);
+    check_sets(sets, { cell_ids.size(), side_elems.size(), node_ids.size() }, this->fn_);
+    for (auto & s : sets) {
+        if (s.kind == CELL_SET)
+            mesh->cell_sets_[s.id].assign(cell_ids.begin() + s.first,
+                                          cell_ids.begin() + s.first + s.count);
+        else if (s.kind == SIDE_SET) {
+            auto & side_set = mesh->side_sets_[s.id];
+            side_set.reserve(s.count);
+            for (auto i = s.first; i < s.first + s.count; ++i)
+                side_set.emplace_back(side_elems[i], side_sides[i]);
+        }
+        else
+            mesh->node_sets_[s.id].assign(node_ids.begin() + s.first,
+                                          node_ids.begin() + s.first + s.count);
+    }
+    auto set_names = sections.get<SetRecord>(SET_NAMES);
+    check_sets(set_names, { names.size(), names.size(), names.size() }, this->fn_);
+    for (auto & s : set_names) {
+        std::string name(names.data() + s.first, s.count);
+        if (s.kind == CELL_SET)
+            mesh->cell_set_names_[s.id] = name;
+        else if (s.kind == SIDE_SET)
+            mesh->side_set_names_[s.id] = name;
+        else
+            mesh->node_set_names_[s.id] = name;
+    }
+
+    // Hasse diagram
+    auto hasse_rec = sections.get<HasseRecord>(HASSE);
+    if (hasse_rec.size() == 1) {
+        const auto & rec = hasse_rec[0];
+        auto & hasse = mesh->hasse_;
+        hasse.vertex_rng_ = { HasseIndex(rec.ranges[0]), HasseIndex(rec.ranges[1]) };
+        hasse.edge_rng_ = { HasseIndex(rec.ranges[2]), HasseIndex(rec.ranges[3]) };
+        hasse.face_rng_ = { HasseIndex(rec.ranges[4]), HasseIndex(rec.ranges[5]) };
+        hasse.cell_rng_ = { HasseIndex(rec.ranges[6]), HasseIndex(rec.ranges[7]) };
+        // nodes are numbered consecutively: cells, vertices, faces and edges, with one cell per
+        // element and one vertex per point
+        const auto & cells = hasse.cell_rng_;
+        const auto & vertices = hasse.vertex_rng_;
+        const auto & faces = hasse.face_rng_;
+        const auto & edges = hasse.edge_rng_;
+        if (cells.first().value() != 0 || cells.last().value() != hdr.n_elements ||
+            vertices.first() != cells.last() ||
+            u64(vertices.last().value()) != u64(hdr.n_elements) + hdr.n_points ||
+            faces.first() != vertices.last() || faces.last() < faces.first() ||
+            edges.first() != faces.last() || edges.last() < edges.first())
+            throw Exception("Corrupted .kmesh file '{}'", this->fn_);
+        const u64 n_nodes = edges.last().value();
+        auto read_adjacency = [&](HasseDiagram::Adjacency & adj,
+                                  u32 offset_size,
+                                  u32 offsets_kind,
+                                  u32 adjacency_kind) {
+            if (offset_size == sizeof(u32))
+                adj.offsets32 = sections.get<u32>(offsets_kind);
+            else if (offset_size == sizeof(u64))
+                adj.offsets64 = sections.get<u64>(offsets_kind);
+            adj.adjacency = sections.get<HasseIndex>(adjacency_kind);
+            if (!adj.empty()) {
+                // one row per node, rows stay inside the adjacency array and point to nodes
+                auto n_adj = adj.adjacency.size();
+                bool valid = adj.offsets32.empty() ? valid_offsets(adj.offsets64, n_adj)
+                                                   : valid_offsets(adj.offsets32, n_adj);
+                if (!valid || adj.size() != n_nodes ||
+                    !std::all_of(adj.adjacency.begin(),
+                                 adj.adjacency.end(),
+                                 [&](HasseIndex i) { return i.value() < n_nodes; }))
+                    throw Exception("Corrupted .kmesh file '{}'", this->fn_);
+            }
+        };
+        read_adjacency(hasse.out_, rec.out_offset_size, HASSE_OUT_OFFSETS, HASSE_OUT_ADJACENCY);
+        read_adjacency(hasse.in_, rec.in_offset_size, HASSE_IN_OFFSETS, HASSE_IN_ADJACENCY);
+    }
+
+    Log::info("- {} point(s), {} element(s)",
+              utils::human_number(mesh->num_points()),
+              utils::human_number(mesh->num_elements()));
+    return mesh;
+}
+
+void
+KMeshFile::write(Ptr<const Mesh> mesh)
+{
+    Log::info("Writing krado mesh file '{}'", this->fn_);
+    LoggingTimer timer;
+
+    const auto & coords = mesh->coordinates();
+    const auto & connect = mesh->connectivity();
+    std::vector<Section> sections = { make_section(X, coords.x()),
+                                      make_section(Y, coords.y()),
+                                      make_section(Z, coords.z()),
+                                      make_section(ELEM_TYPES, connect.types()),
+                                      make_section(ELEM_OFFSETS, connect.offsets()),
+                                      make_section(ELEM_IDS, connect.ids()) };
+
+    // sets are concatenated into one array per kind
+    std::vector<SetRecord> sets;
+    std::vector<SetRecord> set_names;
+    std::vector<Index> cell_ids;
+    std::vector<Index> side_elems;
+    std::vector<u8> side_sides;
+    std::vector<Index> node_ids;
+    std::string names;
+    for (auto & [id, cells] : mesh->cell_sets_) {
+        sets.push_back({ CELL_SET, id, cell_ids.size(), cells.size() });
+        cell_ids.insert(cell_ids.end(), cells.begin(), cells.end());
+    }
+    for (auto & [id, sides] : mesh->side_sets_) {
+        sets.push_back({ SIDE_SET, id, side_elems.size(), sides.size() });
+        for (auto & [elem, side] : sides) {
+            side_elems.push_back(elem);
+            side_sides.push_back(side);
+        }
+    }
+    for (auto & [id, nodes] : mesh->node_sets_) {
+        sets.push_back({ NODE_SET, id, node_ids.size(), nodes.size() });
+        node_ids.insert(node_ids.end(), nodes.begin(), nodes.end());
+    }
+    auto add_names = [&](SetKind kind, const std::map<Marker, std::string> & set_name_map) {
+        for (auto & [id, name] : set_name_map) {
+            set_names.push_back({ kind, id, names.size(), name.size() });
+            names += name;
+        }
+    };
+    add_names(CELL_SET, mesh->cell_set_names_);
+    add_names(SIDE_SET, mesh->side_set_names_);
+    add_names(NODE_SET, mesh->node_set_names_);
+    sections.push_back(make_section(SETS, sets));
+    sections.push_back(make_section(SET_NAMES, set_names));
+    sections.push_back(make_section(CELL_SET_IDS, cell_ids));
+    sections.push_back(make_section(SIDE_SET_ELEMS, side_elems));
+    sections.push_back(make_section(SIDE_SET_SIDES, side_sides));
+    sections.push_back(make_section(NODE_SET_IDS, node_ids));
+    sections.push_back(make_section(NAMES, names.data(), names.size()));
+
+    // Hasse diagram (only if the mesh was set up)
+    const auto & hasse = mesh->hasse_;
+    HasseRecord hasse_rec {};
+    if (hasse.has_downward() || hasse.has_upward()) {
+        const TRange<HasseIndex> * ranges[] = {
+            &hasse.vertex_rng_, &hasse.edge_rng_, &hasse.face_rng_, &hasse.cell_rng_
+        };
+        for (std::size_t i = 0; i < 4; ++i) {
+            hasse_rec.ranges[2 * i] = ranges[i]->first().value();
+            hasse_rec.ranges[2 * i + 1] = ranges[i]->last().value();
+        }
+        auto add_adjacency = [&](const HasseDiagram::Adjacency & adj,
+                                 u32 & offset_size,
+                                 u32 offsets_kind,
+                                 u32 adjacency_kind) {
+            if (!adj.offsets32.empty()) {
+                offset_size = sizeof(u32);
+                sections.push_back(make_section(offsets_kind, adj.offsets32));
+            }
+            else if (!adj.offsets64.empty()) {
+                offset_size = sizeof(u64);
+                sections.push_back(make_section(offsets_kind, adj.offsets64));
+            }
+            sections.push_back(make_section(adjacency_kind, adj.adjacency));
+        };
+        add_adjacency(hasse.out_,
+                      hasse_rec.out_offset_size,
+                      HASSE_OUT_OFFSETS,
+                      HASSE_OUT_ADJACENCY);
+        add_adjacency(hasse.in_, hasse_rec.in_offset_size, HASSE_IN_OFFSETS, HASSE_IN_ADJACENCY);
+        sections.push_back(make_section(HASSE, &hasse_rec, 1));
+    }
+
+    // layout: header, section table, sections (each aligned to `ALIGNMENT` bytes)
+    std::vector<SectionEntry> entries(sections.size());
+    std::size_t offset = align(sizeof(Header) + sections.size() * sizeof(SectionEntry));
+    for (std::size_t i = 0; i < sections.size(); ++i) {
+        const auto & s = sections[i];
+        entries[i] = { s.kind, s.item_size, offset, s.count, 0 };
+        offset = align(offset + s.count * s.item_size);
+    }
+
+    Header hdr {};
+    std::memcpy(hdr.magic, MAGIC, sizeof(MAGIC));
+    hdr.version = VERSION;
+    hdr.byte_order = BYTE_ORDER_MARK;
+    hdr.n_sections = sections.size();
+    hdr.n_points = mesh->num_points();
+    hdr.n_elements = mesh->num_elements();
+
+    std::ofstream out(this->fn_, std::ios::binary | std::ios::trunc);
+    if (!out.good())
+        throw Exception("Failed to write '{}'.", this->fn_);
+    const char zeros[ALIGNMENT] = {};
+    auto pad = [&]() {
+        auto pos = static_cast<std::size_t>(out.tellp());
+        out.write(zeros, align(pos) - pos);
+    };
+    out.write(reinterpret_cast<const char *>(&hdr), sizeof(hdr));
+    out.write(reinterpret_cast<const char *>(entries.data()),
+              entries.size() * sizeof(SectionEntry));
+    for (const auto & s : sections) {
+        pad();
+        out.write(static_cast<const char *>(s.data), s.count * s.item_size);
+    }
+    pad();
+    if (!out.good())
+        throw Exception("Failed to write '{}'.", this->fn_);
+
+    Log::info("- {} point(s), {} element(s)",
+              utils::human_number(mesh->num_points()),
+              utils::human_number(mesh->num_elements()));
+}
+
+} // namespace krado
@@ -17,51 +17,173 @@
 #include "krado/mesh_surface_vertex.h"
 #include "krado/mesh_volume.h"
 #include "krado/timer.h"
-#include "nanoflann/nanoflann.hpp"
+#include "krado/parallel.h"
 #include <array>
 #include <unordered_map>
 #include <algorithm>
 #include <list>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <numeric>
 
 namespace krado {
 
 namespace {
 
-struct PointCloud {
-    PointCloud(const Mesh & mesh) : points(mesh.points()) {}
+/// Squared distance between two points
+inline double
+distance2(const Point & a, const Point & b)
+{
+    const double dx = a.x - b.x;
+    const double dy = a.y - b.y;
+    const double dz = a.z - b.z;
+    return dx * dx + dy * dy + dz * dz;
+}
 
-    Span<const Point> points;
+/// Uniform grid over mesh points used to find points that are closer than a given distance
+///
+/// Points are sorted by the cell they fall into and the occupied cells are stored in an open
+/// addressing hash table, so looking up neighboring points is O(1).
+class PointGrid {
+public:
+    using Cell = std::array<i64, 3>;
+
+    PointGrid(PointsView points, double cell_size) : inv_h_(1. / cell_size)
+    {
+        const auto n = points.size();
+        std::vector<std::pair<Cell, Index>> recs(n);
+        parallel_for(n, [&](std::size_t i) { recs[i] = { cell_of(points[i]), Index(i) }; });
+        parallel_sort(recs, [](const auto & a, const auto & b) { return a < b; });
+
+        // ranks of the occupied cells
+        std::vector<u64> rank(n + 1, 0);
+        parallel_for(n, [&](std::size_t i) {
+            rank[i + 1] = (i == 0 || recs[i - 1].first != recs[i].first) ? 1 : 0;
+        });
+        auto n_cells = parallel_offsets(rank);
+
+        this->sorted_.resize(n);
+        this->cells_.resize(n_cells);
+        this->cell_ofst_.resize(n_cells + 1);
+        this->cell_ofst_[n_cells] = n;
+        parallel_for(n, [&](std::size_t i) {
+            this->sorted_[i] = recs[i].second;
+            if (rank[i + 1] != rank[i]) {
+                this->cells_[rank[i]] = recs[i].first;
+                this->cell_ofst_[rank[i]] = i;
+            }
+        });
+
+        std::size_t table_size = 1;
+        while (table_size < 2 * n_cells)
+            table_size <<= 1;
+        this->mask_ = table_size - 1;
+        this->table_.assign(table_size, 0);
+        parallel_for(n_cells, [&](std::size_t c) {
+            auto slot = hash(this->cells_[c]) & this->mask_;
+            for (;; slot = (slot + 1) & this->mask_) {
+                u32 empty = 0;
+                if (std::atomic_ref<u32>(this->table_[slot]).compare_exchange_strong(empty, c + 1))
+                    break;
+            }
+        });
+    }
 
-    [[nodiscard]] inline std::size_t
-    kdtree_get_point_count() const
+    /// Get point indices sorted by their cells
+    ///
+    /// @return Point indices (consecutive points are close to each other)
+    [[nodiscard]] Span<const Index>
+    sorted() const
     {
-        return this->points.size();
+        return this->sorted_;
     }
 
-    // Returns the distance between the vector "p1[0:size-1]" and the mesh point with index "idx_p2"
-    inline double
-    kdtree_distance(const double * p1, const std::size_t idx_p2, std::size_t /*size*/) const
+    /// Call `fn(j)` for every point `j` that can be closer than half of the cell size to `pt`
+    ///
+    /// Only the cell containing `pt` and its neighbors towards `pt` are visited (8 cells)
+    template <typename FN>
+    void
+    for_each_neighbor(const Point & pt, FN && fn) const
     {
-        const double d0 = p1[0] - this->points[idx_p2].x;
-        const double d1 = p1[1] - this->points[idx_p2].y;
-        const double d2 = p1[2] - this->points[idx_p2].z;
-        return d0 * d0 + d1 * d1 + d2 * d2;
+        const std::array<double, 3> xyz = { pt.x * this->inv_h_,
+                                            pt.y * this->inv_h_,
+                                            pt.z * this->inv_h_ };
+        Cell c;
+        std::array<i64, 3> dir;
+        for (auto d : make_range(3)) {
+            auto f = std::floor(xyz[d]);
+            c[d] = clamp(f);
+            dir[d] = xyz[d] - f < 0.5 ? -1 : 1;
+        }
+        for (auto dx : { i64(0), dir[0] })
+            for (auto dy : { i64(0), dir[1] })
+                for (auto dz : { i64(0), dir[2] }) {
+                    auto idx = find({ c[0] + dx, c[1] + dy, c[2] + dz });
+                    if (!idx.has_value())
+                        continue;
+                    for (auto k : make_range(this->cell_ofst_[*idx], this->cell_ofst_[*idx + 1]))
+                        fn(this->sorted_[k]);
+                }
     }
 
-    // Returns the dim'th component of the idx'th point in the class
-    [[nodiscard]] inline double
-    kdtree_get_pt(const std::size_t idx, int dim) const
+private:
+    [[nodiscard]] static i64
+    clamp(double x)
     {
-        return this->points[idx](dim);
+        // keep away from the limits, so that neighbor cells do not overflow
+        constexpr double LIMIT = 4.6e18;
+        return static_cast<i64>(std::clamp(x, -LIMIT, LIMIT));
     }
 
-    // Optional bounding-box computation
-    template <class BBOX>
-    bool
-    kdtree_get_bbox(BBOX & /*bb*/) const
+    [[nodiscard]] Cell
+    cell_of(const Point & pt) const
     {
-        return false;
+        return { clamp(std::floor(pt.x * this->inv_h_)),
+                 clamp(std::floor(pt.y * this->inv_h_)),
+                 clamp(std::floor(pt.z * this->inv_h_)) };
     }
+
+    [[nodiscard]] static u64
+    hash(const Cell & c)
+    {
+        // combine the coordinates and mix the bits (splitmix64 finalizer), so that regularly
+        // spaced cells do not end up in the same slots
+        u64 h = u64(c[0]) * 0x9E3779B97F4A7C15ULL;
+        h ^= u64(c[1]) + 0x9E3779B97F4A7C15ULL + (h << 6) + (h >> 2);
+        h ^= u64(c[2]) + 0x9E3779B97F4A7C15ULL + (h << 6) + (h >> 2);
+        h ^= h >> 30;
+        h *= 0xBF58476D1CE4E5B9ULL;
+        h ^= h >> 27;
+        h *= 0x94D049BB133111EBULL;
+        h ^= h >> 31;
+        return h;
+    }
+
+    [[nodiscard]] Optional<std::size_t>
+    find(const Cell & c) const
+    {
+        for (auto slot = hash(c) & this->mask_; this->table_[slot] != 0;
+             slot = (slot + 1) & this->mask_) {
+            auto idx = this->table_[slot] - 1;
+            if (this->cells_[idx] == c)
+                return idx;
+        }
+        return std::nullopt;
+    }
+
+    /// Inverse of the cell size
+    double inv_h_;
+    /// Point indices sorted by their cells
+    std::vector<Index> sorted_;
+    /// Occupied cells
+    std::vector<Cell> cells_;
+    /// Offsets of the cells into `sorted_`
+    std::vector<u64> cell_ofst_;
+    /// Hash table with cell indices (+1, zero means empty slot)
+    std::vector<u32> table_;
+    /// Hash table size - 1
+    u64 mask_ = 0;
 };
 
 template <int N>
@@ -93,75 +215,27 @@ print_histogram(const std::array<std::size_t, N> & histogram)
     }
 }
 
-/// Find dupllicate points (i.e. points that are closer than a threshold distance)
+/// Remove duplicate points (i.e. points that are closer than a threshold distance)
 ///
-/// @return Tuple where the first element is a vector of unique points and the second element is a
-///         map that maps the index of the original point to the index of the unique point.
-std::tuple<std::vector<Point>, std::map<std::size_t, std::size_t>>
-remove_duplicates(const PointCloud & cloud, double threshold)
-{
-    constexpr int32_t DIM3 = 3;
-    using namespace nanoflann;
-    using KDTree = KDTreeSingleIndexAdaptor<L2_Simple_Adaptor<double, PointCloud>,
-                                            PointCloud,
-                                            DIM3,
-                                            std::size_t>;
-
-    // Construct a kd-tree index
-    // 30 is the maxium number of neighboring nodes we can have per any node
-    KDTree tree(DIM3, cloud, KDTreeSingleIndexAdaptorParams(30));
-    tree.buildIndex();
-
-    std::vector<Point> unique_points;
-    std::map<std::size_t, std::size_t> point_remap;
-    std::vector<bool> processed(cloud.points.size(), false);
-    nanoflann::SearchParameters params;
-    std::size_t close_pairs_count = 0;
-    double min_dist2 = std::numeric_limits<double>::max();
-    const int BINS = 10;
-    std::array<std::size_t, BINS> histogram {};
-
-    for (auto i : make_range(cloud.points.size())) {
-        if (!processed[i]) {
-            processed[i] = true;
-
-            const double query_point[DIM3] = { cloud.points[i].x,
-                                               cloud.points[i].y,
-                                               cloud.points[i].z };
-            std::vector<ResultItem<std::size_t, double>> matches;
-            const auto search_radius = threshold * threshold;
-            // Search for points within the threshold distance
-            tree.radiusSearch(query_point, search_radius, matches, params);
-
-            for (const auto & match : matches) {
-                // skip self
-                if (match.first == i)
-                    continue;
-                ++close_pairs_count;
-                min_dist2 = std::min(min_dist2, match.second);
-
-                // optional: histogram by fraction of tolerance
-                double dist = std::sqrt(match.second);
-                int bin =
-                    std::min<int>((dist / threshold) * histogram.size(), histogram.size() - 1);
-                histogram[bin]++;
-            }
-
-            for (const auto & match : matches) {
-                processed[match.first] = true;
-                point_remap[match.first] = unique_points.size();
-            }
-            unique_points.push_back(cloud.points[i]);
-        }
-    }
-
-    Log::info(2, "Diagnostics:");
-    Log::info(2, "  Total close pairs: {} ", utils::human_number(close_pairs_count));
-    Log::info(2, "  Histogram (0.0 = identical, 1.0 = exactly at tolerance)");
-    print_histogram<BINS>(histogram);
-    if (close_pairs_count > 0)
-        Log::info(2, "  Smallest separation: {:.6g}", std::sqrt(min_dist2));
-
+/// @return Tuple where the first element is a vector of unique points and the second element maps
+///         the index of the original point to the index of the unique point.
+std::tuple<Coordinates, std::vector<Index>>
+remove_duplicates(PointsView points, double threshold)
+{
+    auto target = find_coincident_points(points, threshold);
+
+    std::vector<u64> rank(points.size() + 1, 0);
+    parallel_for(points.size(), [&](std::size_t i) { rank[i + 1] = target[i] == i ? 1 : 0; });
+    auto n_unique = parallel_offsets(rank);
+
+    Coordinates unique_points;
+    unique_points.resize(n_unique);
+    std::vector<Index> point_remap(points.size());
+    parallel_for(points.size(), [&](std::size_t i) {
+        point_remap[i] = rank[target[i]];
+        if (target[i] == i)
+            unique_points.set(rank[i], points[i]);
+    });
     return { unique_points, point_remap };
 }
 
@@ -182,32 +256,75 @@ boundary_entities(const Mesh & mesh, TRange<HasseIndex> range)
     return bnd_ents;
 }
 
-template <typename T>
-void
-expand_size(std::unordered_map<Marker, std::size_t> & sizes,
-            const std::map<Marker, std::vector<T>> & sets)
+/// Facet (face in 3D, edge in 2D, vertex in 1D) of an element identified by its sorted vertices
+struct FacetRecord {
+    /// Sorted vertex indices (unused slots are set to max value)
+    std::array<Index, 4> vtx;
+    /// Element that owns this facet
+    Index elem;
+    /// Local side number
+    u8 side;
+};
+
+} // namespace
+
+u8
+facet_count(ElementType type)
 {
-    for (const auto & [id, fs] : sets) {
-        auto it = sizes.find(id);
-        if (it == sizes.end())
-            sizes[id] = fs.size();
-        else
-            sizes[id] += fs.size();
+    switch (type) {
+    case ElementType::LINE2:
+        return Line2::N_VERTICES;
+    case ElementType::TRI3:
+        return Tri3::N_EDGES;
+    case ElementType::QUAD4:
+        return Quad4::N_EDGES;
+    case ElementType::TETRA4:
+        return Tetra4::N_FACES;
+    case ElementType::PYRAMID5:
+        return Pyramid5::N_FACES;
+    case ElementType::PRISM6:
+        return Prism6::N_FACES;
+    case ElementType::HEX8:
+        return Hex8::N_FACES;
+    default:
+        return 0;
     }
 }
 
-void
-append(std::vector<SideEntry> & dest, const std::vector<SideEntry> & src)
+std::size_t
+facet_vertices(ElementView elem, u8 side, std::array<Index, 4> & vtx)
 {
-    dest.insert(dest.end(), src.begin(), src.end());
-}
+    auto connect = elem.indices();
+    auto copy = [&](const auto & local) {
+        std::size_t n = 0;
+        for (auto lv : local)
+            vtx[n++] = connect[lv];
+        return n;
+    };
 
-void
-append(std::vector<Index> & dest, const std::vector<Index> & src)
-{
-    dest.insert(dest.end(), src.begin(), src.end());
+    switch (elem.type()) {
+    case ElementType::LINE2:
+        vtx[0] = connect[side];
+        return 1;
+    case ElementType::TRI3:
+        return copy(Tri3::EDGE_VERTICES[side]);
+    case ElementType::QUAD4:
+        return copy(Quad4::EDGE_VERTICES[side]);
+    case ElementType::TETRA4:
+        return copy(Tetra4::FACE_VERTICES[side]);
+    case ElementType::PYRAMID5:
+        return copy(Pyramid5::FACE_VERTICES[side]);
+    case ElementType::PRISM6:
+        return copy(Prism6::FACE_VERTICES[side]);
+    case ElementType::HEX8:
+        return copy(Hex8::FACE_VERTICES[side]);
+    default:
+        return 0;
+    }
 }
 
+namespace {
+
 // Element reversal
 
 // this defines how to "reverse"/permutate an element that was mirrored
@@ -322,13 +439,325 @@ mirror_local_side(ElementType et, u8 side)
     }
 }
 
+
+/// Marks a node that has not been numbered/visited yet
+constexpr Index NO_INDEX = std::numeric_limits<Index>::max();
+
+/// Number of bits per coordinate used by space filling curve keys (keys fit into 63 bits)
+constexpr int
+bits_per_axis(int dim)
+{
+    return dim == 1 ? 31 : 63 / dim;
+}
+
+/// Interleave bits of quantized coordinates (Morton or Z-order key)
+///
+/// @param x Quantized coordinates (`bits_per_axis(dim)` bits each)
+/// @param dim Number of coordinates to interleave
+u64
+morton_key(const std::array<u32, 3> & x, int dim)
+{
+    u64 key = 0;
+    for (int b = bits_per_axis(dim) - 1; b >= 0; --b)
+        for (int i = 0; i < dim; ++i)
+            key = (key << 1) | ((x[i] >> b) & 1u);
+    return key;
+}
+
+/// Position along the Hilbert curve
+///
+/// Coordinates are converted into the "transposed" Hilbert index (J. Skilling, Programming the
+/// Hilbert curve, AIP Conf. Proc. 707, 2004), whose interleaved bits are the curve position.
+///
+/// @param x Quantized coordinates (`bits_per_axis(dim)` bits each)
+/// @param dim Number of coordinates
+u64
+hilbert_key(std::array<u32, 3> x, int dim)
+{
+    const u32 m = 1u << (bits_per_axis(dim) - 1);
+    for (u32 q = m; q > 1; q >>= 1) {
+        const u32 p = q - 1;
+        for (int i = 0; i < dim; ++i) {
+            if (x[i] & q)
+                x[0] ^= p;
+            else {
+                const u32 t = (x[0] ^ x[i]) & p;
+                x[0] ^= t;
+                x[i] ^= t;
+            }
+        }
+    }
+    // Gray encode
+    for (int i = 1; i < dim; ++i)
+        x[i] ^= x[i - 1];
+    u32 t = 0;
+    for (u32 q = m; q > 1; q >>= 1)
+        if (x[dim - 1] & q)
+            t ^= q - 1;
+    for (int i = 0; i < dim; ++i)
+        x[i] ^= t;
+    return morton_key(x, dim);
+}
+
+/// New element IDs sorting elements along a space filling curve through their centroids
+std::vector<Index>
+space_filling_curve_order(const Mesh & mesh, Ordering ordering)
+{
+    const auto & coords = mesh.coordinates();
+    auto bbox = coords.bounding_box();
+    // flat directions do not take part in the curve (2D meshes get a 2D curve)
+    std::array<int, 3> axes = { 0, 0, 0 };
+    std::array<double, 3> lo = { 0., 0., 0. };
+    std::array<double, 3> scale = { 0., 0., 0. };
+    int n_axes = 0;
+    for (int d = 0; d < 3 && !bbox.empty(); ++d) {
+        if (bbox.size(d) > 0.) {
+            axes[n_axes] = d;
+            n_axes++;
+        }
+    }
+    const int dim = std::max(n_axes, 1);
+    const double n_cells = static_cast<double>((u64(1) << bits_per_axis(dim)) - 1);
+    auto bmin = bbox.empty() ? Point(0., 0., 0.) : bbox.min();
+    const std::array<double, 3> bmin_xyz = { bmin.x, bmin.y, bmin.z };
+    for (int i = 0; i < n_axes; ++i) {
+        auto d = axes[i];
+        lo[i] = bmin_xyz[d];
+        scale[i] = n_cells / bbox.size(d);
+    }
+
+    auto elems = mesh.elements();
+    std::vector<std::pair<u64, Index>> recs(elems.size());
+    parallel_for(elems.size(), [&](std::size_t e) {
+        auto ctr = coords.centroid(elems[e].indices());
+        const std::array<double, 3> c = { ctr.x, ctr.y, ctr.z };
+        std::array<u32, 3> q = { 0, 0, 0 };
+        for (int i = 0; i < dim; ++i)
+            q[i] = static_cast<u32>(std::clamp((c[axes[i]] - lo[i]) * scale[i], 0., n_cells));
+        auto key = ordering == Ordering::HILBERT ? hilbert_key(q, dim) : morton_key(q, dim);
+        recs[e] = { key, Index(e) };
+    });
+    parallel_sort(recs, [](const auto & a, const auto & b) { return a < b; });
+
+    std::vector<Index> elem_ids(elems.size());
+    parallel_for(recs.size(), [&](std::size_t k) { elem_ids[recs[k].second] = k; });
+    return elem_ids;
+}
+
+/// New node IDs in the order nodes are first used by elements (in their new order)
+std::vector<Index>
+first_touch_order(const Mesh & mesh, Span<const Index> elem_ids)
+{
+    auto elems = mesh.elements();
+    std::vector<Index> order(elems.size());
+    parallel_for(elems.size(), [&](std::size_t e) { order[elem_ids[e]] = e; });
+
+    std::vector<Index> node_ids(mesh.num_points(), NO_INDEX);
+    Index next = 0;
+    for (auto e : order)
+        for (auto id : elems[e].indices())
+            if (node_ids[id] == NO_INDEX)
+                node_ids[id] = next++;
+    // points not used by any element go last
+    for (auto & id : node_ids)
+        if (id == NO_INDEX)
+            id = next++;
+    return node_ids;
+}
+
+/// Adjacency of mesh nodes in compressed row storage (nodes are adjacent if they share an element)
+///
+/// @return Tuple with offsets and sorted neighbor lists
+std::tuple<std::vector<Index>, std::vector<Index>>
+node_graph(const Mesh & mesh)
+{
+    const auto & connect = mesh.connectivity();
+    const auto & elem_ofst = connect.offsets();
+    const auto & elem_ids = connect.ids();
+    const auto n_nodes = mesh.num_points();
+
+    // node -> elements
+    std::vector<Index> n2e_ofst(n_nodes + 1, 0);
+    for (auto id : elem_ids)
+        n2e_ofst[id + 1]++;
+    parallel_offsets(n2e_ofst);
+    std::vector<Index> n2e(elem_ids.size());
+    {
+        std::vector<Index> pos(n2e_ofst.begin(), n2e_ofst.end() - 1);
+        for (std::size_t e = 0; e < connect.size(); ++e)
+            for (auto k = elem_ofst[e]; k < elem_ofst[e + 1]; ++k)
+                n2e[pos[elem_ids[k]]++] = e;
+    }
+
+    // neighbors are collected twice: first to count them and then to store them
+    auto collect = [&](std::size_t node, std::vector<Index> & nbrs) {
+        nbrs.clear();
+        for (auto k = n2e_ofst[node]; k < n2e_ofst[node + 1]; ++k) {
+            auto e = n2e[k];
+            for (auto j = elem_ofst[e]; j < elem_ofst[e + 1]; ++j)
+                if (elem_ids[j] != node)
+                    nbrs.push_back(elem_ids[j]);
+        }
+        std::sort(nbrs.begin(), nbrs.end());
+        nbrs.erase(std::unique(nbrs.begin(), nbrs.end()), nbrs.end());
+    };
+
+    std::vector<Index> ofst(n_nodes + 1, 0);
+    parallel_for_chunks(n_nodes, 1024, [&](std::size_t begin, std::size_t end) {
+        std::vector<Index> nbrs;
+        for (auto i = begin; i < end; ++i) {
+            collect(i, nbrs);
+            ofst[i + 1] = nbrs.size();
+        }
+    });
+    auto n_adj = parallel_offsets(ofst);
+    std::vector<Index> adj(n_adj);
+    parallel_for_chunks(n_nodes, 1024, [&](std::size_t begin, std::size_t end) {
+        std::vector<Index> nbrs;
+        for (auto i = begin; i < end; ++i) {
+            collect(i, nbrs);
+            std::copy(nbrs.begin(), nbrs.end(), adj.begin() + ofst[i]);
+        }
+    });
+    return { ofst, adj };
+}
+
+/// Breadth-first search from `root` recording the level of every reached node
+///
+/// @param queue Reached nodes in the order of their discovery
+/// @return Level of the last reached node (i.e. eccentricity of `root`)
+Index
+bfs_levels(const std::vector<Index> & ofst,
+           const std::vector<Index> & adj,
+           Index root,
+           std::vector<Index> & level,
+           std::vector<Index> & queue)
+{
+    queue.clear();
+    queue.push_back(root);
+    level[root] = 0;
+    for (std::size_t h = 0; h < queue.size(); ++h) {
+        auto v = queue[h];
+        for (auto k = ofst[v]; k < ofst[v + 1]; ++k)
+            if (level[adj[k]] == NO_INDEX) {
+                level[adj[k]] = level[v] + 1;
+                queue.push_back(adj[k]);
+            }
+    }
+    return level[queue.back()];
+}
+
+/// Find a pseudo-peripheral node in the component of `start` (George-Liu algorithm)
+Index
+pseudo_peripheral_node(const std::vector<Index> & ofst,
+                       const std::vector<Index> & adj,
+                       Index start,
+                       std::vector<Index> & level,
+                       std::vector<Index> & queue)
+{
+    auto degree = [&](Index v) { return ofst[v + 1] - ofst[v]; };
+
+    auto root = start;
+    auto ecc = bfs_levels(ofst, adj, root, level, queue);
+    while (true) {
+        // lowest degree node on the last level
+        auto cand = queue.back();
+        for (auto v : queue)
+            if (level[v] == ecc && degree(v) < degree(cand))
+                cand = v;
+        for (auto v : queue)
+            level[v] = NO_INDEX;
+
+        auto cand_ecc = bfs_levels(ofst, adj, cand, level, queue);
+        if (cand_ecc <= ecc)
+            break;
+        root = cand;
+        ecc = cand_ecc;
+    }
+    for (auto v : queue)
+        level[v] = NO_INDEX;
+    return root;
+}
+
+/// New node IDs given by the reverse Cuthill-McKee ordering
+std::vector<Index>
+rcm_order(const Mesh & mesh)
+{
+    auto [ofst, adj] = node_graph(mesh);
+    const auto n_nodes = mesh.num_points();
+    auto degree = [&](Index v) { return ofst[v + 1] - ofst[v]; };
+
+    // components are started from their lowest degree node
+    std::vector<Index> by_degree(n_nodes);
+    std::iota(by_degree.begin(), by_degree.end(), 0);
+    std::stable_sort(by_degree.begin(), by_degree.end(), [&](Index a, Index b) {
+        return degree(a) < degree(b);
+    });
+
+    std::vector<Index> order;
+    order.reserve(n_nodes);
+    std::vector<u8> visited(n_nodes, 0);
+    std::vector<Index> level(n_nodes, NO_INDEX);
+    std::vector<Index> queue;
+    std::vector<Index> nbrs;
+    for (auto s : by_degree) {
+        if (visited[s])
+            continue;
+        auto root = pseudo_peripheral_node(ofst, adj, s, level, queue);
+        visited[root] = 1;
+        order.push_back(root);
+        for (std::size_t h = order.size() - 1; h < order.size(); ++h) {
+            auto v = order[h];
+            nbrs.clear();
+            for (auto k = ofst[v]; k < ofst[v + 1]; ++k)
+                if (!visited[adj[k]]) {
+                    visited[adj[k]] = 1;
+                    nbrs.push_back(adj[k]);
+                }
+            std::stable_sort(nbrs.begin(), nbrs.end(), [&](Index a, Index b) {
+                return degree(a) < degree(b);
+            });
+            order.insert(order.end(), nbrs.begin(), nbrs.end());
+        }
+    }
+
+    std::vector<Index> node_ids(n_nodes);
+    parallel_for(n_nodes, [&](std::size_t k) { node_ids[order[k]] = n_nodes - 1 - k; });
+    return node_ids;
+}
+
+/// New element IDs sorting elements by their lowest (new) node ID
+std::vector<Index>
+lowest_node_order(const Mesh & mesh, Span<const Index> node_ids)
+{
+    auto elems = mesh.elements();
+    std::vector<std::pair<Index, Index>> recs(elems.size());
+    parallel_for(elems.size(), [&](std::size_t e) {
+        Index lowest = NO_INDEX;
+        for (auto id : elems[e].indices())
+            lowest = std::min(lowest, node_ids[id]);
+        recs[e] = { lowest, Index(e) };
+    });
+    parallel_sort(recs, [](const auto & a, const auto & b) { return a < b; });
+
+    std::vector<Index> elem_ids(elems.size());
+    parallel_for(recs.size(), [&](std::size_t k) { elem_ids[recs[k].second] = k; });
+    return elem_ids;
+}
+
 } // namespace
 
 Mesh::Mesh() = default;
 
 Mesh::Mesh(std::vector<Point> points, std::vector<Element> elems) :
-    pnts_(std::move(points)),
-    elems_(std::move(elems))
+    pnts_(points),
+    elems_(elems)
+{
+}
+
+Mesh::Mesh(Coordinates coords, Connectivity connect) :
+    pnts_(std::move(coords)),
+    elems_(std::move(connect))
 {
 }
 
@@ -344,30 +773,42 @@ Mesh::num_elements() const
     return this->elems_.size();
 }
 
-Span<const Point>
+PointsView
 Mesh::points() const
 {
-    return this->pnts_;
+    return this->pnts_.view();
 }
 
-const Point &
+Point
 Mesh::point(Index idx) const
 {
     return this->pnts_.at(idx);
 }
 
-Span<const Element>
+const Coordinates &
+Mesh::coordinates() const
+{
+    return this->pnts_;
+}
+
+ElementsView
 Mesh::elements() const
 {
-    return this->elems_;
+    return this->elems_.view();
 }
 
-const Element &
+ElementView
 Mesh::element(Index idx) const
 {
     return this->elems_.at(idx);
 }
 
+const Connectivity &
+Mesh::connectivity() const
+{
+    return this->elems_;
+}
+
 Ptr<Mesh>
 Mesh::scaled(double factor) const
 {
@@ -413,18 +854,10 @@ Mesh::translate(double tx, double ty, double tz)
 Ptr<Mesh>
 Mesh::transformed(const Trsf & tr) const
 {
-    std::vector<Point> pts;
-    pts.reserve(this->pnts_.size());
-    // clang-format off
-    std::ranges::transform(
-        this->pnts_, std::back_inserter(pts),
-        [=](Point p) {
-            return tr * p;
-        }
-    );
-    // clang-format on
+    auto pts = this->pnts_;
+    pts.transform(tr);
 
-    auto mesh = Ptr<Mesh>::alloc(pts, this->elems_);
+    auto mesh = Ptr<Mesh>::alloc(std::move(pts), this->elems_);
     mesh->cell_sets_ = this->cell_sets_;
     mesh->cell_set_names_ = this->cell_set_names_;
     mesh->side_sets_ = this->side_sets_;
@@ -437,15 +870,14 @@ Mesh::transformed(const Trsf & tr) const
 Mesh &
 Mesh::transform(const Trsf & tr)
 {
-    for (auto & p : this->pnts_)
-        p = tr * p;
+    this->pnts_.transform(tr);
     return *this;
 }
 
 Ptr<Mesh>
 Mesh::mirrored(const Axis2 & axis) const
 {
-    std::vector<Point> points;
+    Coordinates points;
     points.reserve(this->num_points());
     for (const auto & pt : this->points())
         points.push_back(pt.mirrored(axis));
@@ -484,14 +916,9 @@ Mesh::add(const Mesh & other)
     auto n_elem_ofst = this->elems_.size();
     auto n_pt_ofst = this->pnts_.size();
     // merge points
-    this->pnts_.insert(this->pnts_.end(), other.pnts_.begin(), other.pnts_.end());
+    this->pnts_.append(other.pnts_);
     // merge elements
-    this->elems_.insert(this->elems_.end(), other.elems_.begin(), other.elems_.end());
-    for (auto i : make_range(n_elem_ofst, this->elems_.size())) {
-        auto & ids = this->elems_[i].vtx_id_;
-        for (auto & id : ids)
-            id += n_pt_ofst;
-    }
+    this->elems_.append(other.elems_, n_pt_ofst);
 
     // merge cell sets
     for (auto & id : other.cell_set_ids()) {
@@ -512,71 +939,41 @@ Mesh::add(const Mesh & other)
         }
     }
 
-    // merge side sets
-    std::map<Marker, std::vector<SideEntry>> side_sets;
-    {
-        std::unordered_map<Marker, std::size_t> side_sets_size;
-        expand_size(side_sets_size, this->side_sets_);
-        expand_size(side_sets_size, other.side_sets_);
-
-        for (auto & [id, n] : side_sets_size)
-            side_sets[id].reserve(n);
-        for (auto & [id, ss] : this->side_sets_)
-            append(side_sets[id], ss);
-        for (const auto & [id, ss] : other.side_sets_) {
-            auto ss_shifted = ss;
-            for (auto & ent : ss_shifted)
-                ent.elem += n_elem_ofst;
-            append(side_sets[id], ss_shifted);
-        }
+    // merge side sets (appended in place, so repeated `add` calls do not copy the sets)
+    for (const auto & [id, ss] : other.side_sets_) {
+        auto & dest = this->side_sets_[id];
+        for (auto & ent : ss)
+            dest.emplace_back(ent.elem + n_elem_ofst, ent.side);
 
-        for (auto & id : other.side_set_ids()) {
-            auto name = other.side_set_name(id);
-            if (name.has_value()) {
-                auto my_name = side_set_name(id);
-                if (my_name.has_value())
-                    this->side_set_names_[id] = name.value();
-                else if (name != my_name)
-                    Log::warn("Side set with id={} already exists, but with a different name '{}'",
-                              id,
-                              name.value());
-            }
+        auto name = other.side_set_name(id);
+        if (name.has_value()) {
+            auto my_name = side_set_name(id);
+            if (!my_name.has_value())
+                this->side_set_names_[id] = name.value();
+            else if (name != my_name)
+                Log::warn("Side set with id={} already exists, but with a different name '{}'",
+                          id,
+                          name.value());
         }
     }
-    this->side_sets_ = side_sets;
 
     // merge node sets
-    std::map<Marker, std::vector<Index>> node_sets;
-    {
-        std::unordered_map<Marker, std::size_t> node_sets_size;
-        expand_size(node_sets_size, this->node_sets_);
-        expand_size(node_sets_size, other.node_sets_);
-        for (auto & [id, n] : node_sets_size)
-            node_sets[id].reserve(n);
-
-        for (auto & [id, ns] : this->node_sets_)
-            append(node_sets[id], ns);
-        for (const auto & [id, ns] : other.node_sets_) {
-            auto ns_shifted = ns;
-            for (auto & idx : ns_shifted)
-                idx += n_pt_ofst;
-            append(node_sets[id], ns_shifted);
-        }
+    for (const auto & [id, ns] : other.node_sets_) {
+        auto & dest = this->node_sets_[id];
+        for (auto & idx : ns)
+            dest.push_back(idx + n_pt_ofst);
 
-        for (auto & id : other.node_set_ids()) {
-            auto name = other.node_set_name(id);
-            if (name.has_value()) {
-                auto my_name = node_set_name(id);
-                if (my_name.has_value())
-                    this->node_set_names_[id] = name.value();
-                else if (name != my_name)
-                    Log::warn("Node set with id={} already exists, but with a different name '{}'",
-                              id,
-                              name.value());
-            }
+        auto name = other.node_set_name(id);
+        if (name.has_value()) {
+            auto my_name = node_set_name(id);
+            if (!my_name.has_value())
+                this->node_set_names_[id] = name.value();
+            else if (name != my_name)
+                Log::warn("Node set with id={} already exists, but with a different name '{}'",
+                          id,
+                          name.value());
         }
     }
-    this->node_sets_ = node_sets;
 
     return *this;
 }
@@ -587,18 +984,54 @@ Mesh::remove_duplicate_points(double tolerance)
     Log::info("Removing duplicates: tolerance={}", tolerance);
     LoggingTimer timer;
 
-    PointCloud cloud(*this);
-    std::map<std::size_t, std::size_t> point_map;
-    std::tie(this->pnts_, point_map) = remove_duplicates(cloud, tolerance);
-    for (auto & elem : this->elems_) {
-        auto & ids = elem.vtx_id_;
-        for (auto & id : ids)
-            id = point_map[id];
+    auto n_points = this->pnts_.size();
+    std::vector<Index> point_map;
+    std::tie(this->pnts_, point_map) = remove_duplicates(this->pnts_, tolerance);
+    Log::info(2,
+              "Merged {} points into {}",
+              utils::human_number(n_points),
+              utils::human_number(this->pnts_.size()));
+
+    this->elems_.remap(point_map);
+    for (auto & [id, nodes] : this->node_sets_) {
+        for (auto & n : nodes)
+            n = point_map[n];
+        std::sort(nodes.begin(), nodes.end());
+        nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
     }
 
     return *this;
 }
 
+Mesh &
+Mesh::renumber(Span<const Index> node_ids, Span<const Index> elem_ids)
+{
+    this->pnts_.permute(node_ids);
+    this->elems_.permute(elem_ids);
+    this->elems_.remap(node_ids);
+
+    for (auto & [id, cells] : this->cell_sets_) {
+        for (auto & c : cells)
+            c = elem_ids[c];
+        std::sort(cells.begin(), cells.end());
+    }
+    for (auto & [id, sides] : this->side_sets_) {
+        for (auto & ent : sides)
+            ent.elem = elem_ids[ent.elem];
+        std::sort(sides.begin(), sides.end(), [](const SideEntry & a, const SideEntry & b) {
+            return a.elem < b.elem || (a.elem == b.elem && a.side < b.side);
+        });
+    }
+    for (auto & [id, nodes] : this->node_sets_) {
+        for (auto & n : nodes)
+            n = node_ids[n];
+        std::sort(nodes.begin(), nodes.end());
+    }
+    this->hasse_ = HasseDiagram();
+
+    return *this;
+}
+
 Ptr<Mesh>
 Mesh::duplicate() const
 {
@@ -651,6 +1084,13 @@ Mesh::set_cell_set(Marker id, const std::vector<Index> & cell_ids)
     return *this;
 }
 
+Mesh &
+Mesh::set_cell_set(Marker id, std::vector<Index> && cell_ids)
+{
+    this->cell_sets_[id] = std::move(cell_ids);
+    return *this;
+}
+
 Mesh &
 Mesh::remove_cell_sets()
 {
@@ -701,6 +1141,13 @@ Mesh::set_side_set(Marker id, const std::vector<SideEntry> & side_set)
     return *this;
 }
 
+Mesh &
+Mesh::set_side_set(Marker id, std::vector<SideEntry> && side_set)
+{
+    this->side_sets_[id] = std::move(side_set);
+    return *this;
+}
+
 Mesh &
 Mesh::remove_side_sets()
 {
@@ -750,6 +1197,13 @@ Mesh::set_node_set(Marker id, const std::vector<Index> & node_ids)
     return *this;
 }
 
+Mesh &
+Mesh::set_node_set(Marker id, std::vector<Index> && node_ids)
+{
+    this->node_sets_[id] = std::move(node_ids);
+    return *this;
+}
+
 Mesh &
 Mesh::remove_node_sets()
 {
@@ -840,9 +1294,15 @@ Mesh::element_type(Index index) const
 }
 
 void
-Mesh::set_up()
+Mesh::set_up(Flags<HasseDiagram::Relation> relations)
 {
-    this->hasse_ = HasseDiagram(*this);
+    this->hasse_ = HasseDiagram(*this, relations);
+}
+
+const HasseDiagram &
+Mesh::hasse_diagram() const
+{
+    return this->hasse_;
 }
 
 std::vector<HasseIndex>
@@ -860,12 +1320,7 @@ Mesh::boundary_faces() const
 Point
 Mesh::compute_centroid(Span<const Index> connect) const
 {
-    Point center(0, 0, 0);
-    for (const auto & pt_id : connect) {
-        center += this->pnts_[pt_id];
-    }
-    center *= 1. / connect.size();
-    return center;
+    return this->pnts_.centroid(connect);
 }
 
 Point
@@ -930,10 +1385,7 @@ Mesh::outward_normal(HasseIndex index) const
 BoundingBox3D
 compute_bounding_box(const Mesh & mesh)
 {
-    BoundingBox3D bbox;
-    for (const auto & pt : mesh.points())
-        bbox += pt;
-    return bbox;
+    return mesh.coordinates().bounding_box();
 }
 
 BoundingBox3D
@@ -942,130 +1394,230 @@ compute_bounding_box(Ptr<const Mesh> mesh)
     return compute_bounding_box(*mesh);
 }
 
+std::size_t
+node_bandwidth(const Mesh & mesh)
+{
+    auto elems = mesh.elements();
+    return parallel_reduce(
+        elems.size(),
+        std::size_t(0),
+        [&](std::size_t begin, std::size_t end) {
+            std::size_t bw = 0;
+            for (auto e = begin; e < end; ++e) {
+                auto ids = elems[e].indices();
+                if (ids.empty())
+                    continue;
+                auto [lo, hi] = std::minmax_element(ids.begin(), ids.end());
+                bw = std::max<std::size_t>(bw, *hi - *lo);
+            }
+            return bw;
+        },
+        [](std::size_t a, std::size_t b) { return std::max(a, b); },
+        4096);
+}
+
+Mesh &
+reorder(Mesh & mesh, Ordering ordering)
+{
+    static const std::map<Ordering, const char *> names = { { Ordering::RCM, "RCM" },
+                                                            { Ordering::HILBERT, "Hilbert" },
+                                                            { Ordering::MORTON, "Morton" } };
+    Log::info("Reordering mesh: {}", names.at(ordering));
+    LoggingTimer timer;
+
+    auto bw_before = node_bandwidth(mesh);
+    std::vector<Index> node_ids, elem_ids;
+    if (ordering == Ordering::RCM) {
+        node_ids = rcm_order(mesh);
+        elem_ids = lowest_node_order(mesh, node_ids);
+    }
+    else {
+        elem_ids = space_filling_curve_order(mesh, ordering);
+        node_ids = first_touch_order(mesh, elem_ids);
+    }
+    mesh.renumber(node_ids, elem_ids);
+    Log::info(2, "Bandwidth: {} -> {}", bw_before, node_bandwidth(mesh));
+
+    return mesh;
+}
+
 //
 
-std::tuple<std::vector<Point>, std::map<Ptr<MeshVertexAbstract>, Index>>
-build_points(const GeomModel & model)
+namespace {
+
+/// Collect entities of a model, so they can be processed in parallel
+template <typename ENTITY>
+std::vector<Ptr<ENTITY>>
+entity_list(const std::map<ShapeID, Ptr<ENTITY>> & entities)
 {
-    Log::debug("Building points");
+    std::vector<Ptr<ENTITY>> list;
+    list.reserve(entities.size());
+    for (const auto & [id, e] : entities)
+        list.push_back(e);
+    return list;
+}
 
-    std::vector<Point> pnts;
-    std::size_t sz = model.vertices().size();
-    pnts.reserve(sz);
-    for (const auto & [_, curve] : model.curves())
-        sz += curve->curve_vertices().size();
-    for (const auto & [id, surface] : model.surfaces())
-        sz += surface->surface_vertices().size();
-    std::map<Ptr<MeshVertexAbstract>, Index> vtx_map;
-    Index gid = 0;
-
-    for (const auto & [id, v] : model.vertices()) {
-        vtx_map.emplace(v, gid);
-        pnts.emplace_back(v->point());
-        gid++;
+/// Last numbering pass handed out by `number_vertices` (vertices are created with pass 0)
+std::atomic<u32> last_numbering_pass = 0;
+
+/// Number vertices owned by mesh entities consecutively
+///
+/// @param entities Mesh entities (curves or surfaces)
+/// @param first Number of the first vertex
+/// @param pass Numbering pass
+/// @param vertices_of Function returning the vertices owned by an entity
+/// @return Number past the last numbered vertex
+template <typename ENTITY, typename FN>
+Index
+number_entity_vertices(const std::map<ShapeID, Ptr<ENTITY>> & entities,
+                       Index first,
+                       u32 pass,
+                       FN vertices_of)
+{
+    auto list = entity_list(entities);
+    std::vector<Index> offsets(list.size() + 1, 0);
+    for (auto i : make_range(list.size()))
+        offsets[i + 1] = vertices_of(*list[i]).size();
+    auto n = parallel_offsets(offsets);
+    parallel_for(
+        list.size(),
+        [&](std::size_t i) {
+            auto vtxs = vertices_of(*list[i]);
+            for (auto j : make_range(vtxs.size()))
+                vtxs[j]->set_num(first + offsets[i] + j, pass);
+        },
+        1);
+    return first + n;
+}
+
+/// Convert mesh elements into elements indexing the mesh points
+///
+/// @param mesh_elems Mesh elements with numbered vertices
+/// @param numbering Vertex numbering
+/// @param make Function building an element from vertex indices (i.e. `Element::Tri3`)
+/// @param elems Vector to append the elements to
+template <std::size_t N>
+void
+append_elements(Span<const MeshElement> mesh_elems,
+                const VertexNumbering & numbering,
+                Element (*make)(const std::array<Index, N> &),
+                std::vector<Element> & elems)
+{
+    std::array<Index, N> ids;
+    for (const auto & local_elem : mesh_elems) {
+        auto vtxs = local_elem.vertices();
+        for (auto i : make_range(N))
+            ids[i] = numbering.index(*vtxs[i]);
+        elems.emplace_back(make(ids));
     }
-    for (const auto & [id, curve] : model.curves())
-        for (auto & v : curve->curve_vertices()) {
-            vtx_map.emplace(v, gid);
-            pnts.emplace_back(v->point());
-            gid++;
-        }
-    for (const auto & [id, surface] : model.surfaces())
-        for (auto & v : surface->surface_vertices()) {
-            vtx_map.emplace(v, gid);
-            pnts.emplace_back(v->point());
-            gid++;
-        }
-    return { pnts, vtx_map };
 }
 
+/// Build elements of all entities in parallel and concatenate them (in the order of entity IDs)
+template <typename ENTITY, typename FN>
 std::vector<Element>
-build_1d_elements(const GeomModel & model, const std::map<Ptr<MeshVertexAbstract>, Index> & vtx_map)
+build_entity_elements(const std::map<ShapeID, Ptr<ENTITY>> & entities, FN build)
 {
-    Log::debug("Building 1D elements");
+    auto list = entity_list(entities);
+    std::vector<std::vector<Element>> parts(list.size());
+    parallel_for(list.size(), [&](std::size_t i) { build(*list[i], parts[i]); }, 1);
 
-    std::vector<Element> elems;
     std::size_t sz = 0;
-    for (const auto & [id, curve] : model.curves())
-        sz += curve->segments().size();
+    for (const auto & p : parts)
+        sz += p.size();
+    std::vector<Element> elems;
     elems.reserve(sz);
-    for (const auto & [id, curve] : model.curves()) {
-        std::array<Index, Line2::N_VERTICES> line;
-        for (const auto & local_elem : curve->segments()) {
-            for (auto i : make_range(Line2::N_VERTICES)) {
-                auto vtx = local_elem.vertex(i);
-                auto gid = vtx_map.at(vtx);
-                line[i] = gid;
-            }
-            elems.emplace_back(Element::Line2(line));
-        }
-    }
+    for (const auto & p : parts)
+        elems.insert(elems.end(), p.begin(), p.end());
     return elems;
 }
 
+} // namespace
+
+Index
+VertexNumbering::index(const MeshVertexAbstract & vtx) const
+{
+    if (vtx.num_pass() != this->pass || vtx.num() >= this->n_vertices)
+        throw Exception("Mesh vertex {} is not part of the numbered model", vtx.num());
+    return vtx.num();
+}
+
+VertexNumbering
+number_vertices(const GeomModel & model)
+{
+    Log::debug("Numbering vertices");
+
+    auto pass = last_numbering_pass.fetch_add(1, std::memory_order_relaxed) + 1;
+    Index n = 0;
+    for (const auto & [id, v] : model.vertices())
+        v->set_num(n++, pass);
+    n = number_entity_vertices(model.curves(), n, pass, [](MeshCurve & curve) {
+        return curve.curve_vertices();
+    });
+    n = number_entity_vertices(model.surfaces(), n, pass, [](MeshSurface & surface) {
+        return surface.surface_vertices();
+    });
+    return { n, pass };
+}
+
+std::vector<Point>
+build_points(const GeomModel & model, const VertexNumbering & numbering)
+{
+    Log::debug("Building points");
+
+    std::vector<Point> pnts(numbering.n_vertices);
+    for (const auto & [id, v] : model.vertices())
+        pnts[numbering.index(*v)] = v->point();
+    for (const auto & [id, curve] : model.curves())
+        for (auto & v : curve->curve_vertices())
+            pnts[numbering.index(*v)] = v->point();
+    for (const auto & [id, surface] : model.surfaces())
+        for (auto & v : surface->surface_vertices())
+            pnts[numbering.index(*v)] = v->point();
+    return pnts;
+}
+
 std::vector<Element>
-build_2d_elements(const GeomModel & model, const std::map<Ptr<MeshVertexAbstract>, Index> & vtx_map)
+build_1d_elements(const GeomModel & model, const VertexNumbering & numbering)
 {
-    Log::debug("Building 2D elements");
+    Log::debug("Building 1D elements");
 
-    std::vector<Element> elems;
-    std::size_t sz = 0;
-    for (const auto & [id, surface] : model.surfaces()) {
-        sz += surface->triangles().size();
-        sz += surface->quadrangles().size();
-    }
-    elems.reserve(sz);
-    for (const auto & [id, surface] : model.surfaces()) {
-        std::array<Index, Tri3::N_VERTICES> tri;
-        for (auto & local_elem : surface->triangles()) {
-            for (auto i : make_range(Tri3::N_VERTICES)) {
-                auto vtx = local_elem.vertex(i);
-                auto gid = vtx_map.at(vtx);
-                tri[i] = gid;
-            }
-            elems.emplace_back(Element::Tri3(tri));
-        }
+    return build_entity_elements(
+        model.curves(),
+        [&](const MeshCurve & curve, std::vector<Element> & elems) {
+            elems.reserve(curve.segments().size());
+            append_elements(curve.segments(), numbering, Element::Line2, elems);
+        });
+}
 
-        std::array<Index, Quad4::N_VERTICES> quad;
-        for (auto & local_elem : surface->quadrangles()) {
-            for (auto i : make_range(Quad4::N_VERTICES)) {
-                auto vtx = local_elem.vertex(i);
-                auto gid = vtx_map.at(vtx);
-                quad[i] = gid;
-            }
-            elems.emplace_back(Element::Quad4(quad));
-        }
-    }
-    return elems;
+std::vector<Element>
+build_2d_elements(const GeomModel & model, const VertexNumbering & numbering)
+{
+    Log::debug("Building 2D elements");
+
+    return build_entity_elements(
+        model.surfaces(),
+        [&](const MeshSurface & surface, std::vector<Element> & elems) {
+            elems.reserve(surface.triangles().size() + surface.quadrangles().size());
+            append_elements(surface.triangles(), numbering, Element::Tri3, elems);
+            append_elements(surface.quadrangles(), numbering, Element::Quad4, elems);
+        });
 }
 
 std::vector<Element>
-build_3d_elements(const GeomModel & model, const std::map<Ptr<MeshVertexAbstract>, Index> & vtx_map)
+build_3d_elements(const GeomModel & model, const VertexNumbering & numbering)
 {
     Log::debug("Building 3D elements");
 
-    std::vector<Element> elems;
-    std::size_t sz = 0;
-    for (const auto & [id, volume] : model.volumes()) {
-        sz += volume->tetrahedra().size();
-    }
-    elems.reserve(sz);
-    for (const auto & [id, volume] : model.volumes()) {
-        std::array<Index, Tetra4::N_VERTICES> tet;
-        for (const auto & local_elem : volume->tetrahedra()) {
-            for (auto i : make_range(Tetra4::N_VERTICES)) {
-                auto vtx = local_elem.vertex(i);
-                auto gid = vtx_map.at(vtx);
-                tet[i] = gid;
-            }
-            elems.emplace_back(Element::Tetra4(tet));
-        }
-    }
-    return elems;
+    return build_entity_elements(
+        model.volumes(),
+        [&](const MeshVolume & volume, std::vector<Element> & elems) {
+            elems.reserve(volume.tetrahedra().size());
+            append_elements(volume.tetrahedra(), numbering, Element::Tetra4, elems);
+        });
 }
 
 std::vector<Element>
-build_elements(const GeomModel & model, const std::map<Ptr<MeshVertexAbstract>, Index> & vtx_map)
+build_elements(const GeomModel & model, const VertexNumbering & numbering)
 {
     Log::debug("Building elements");
 
@@ -1073,15 +1625,15 @@ build_elements(const GeomModel & model, const std::map<Ptr<MeshVertexAbstract>,
     auto dim = determine_spatial_dim(bbox);
 
     if (dim == 1)
-        return build_1d_elements(model, vtx_map);
+        return build_1d_elements(model, numbering);
     else if (dim == 2) {
         if (not model.surfaces().empty())
-            return build_2d_elements(model, vtx_map);
+            return build_2d_elements(model, numbering);
         else
-            return build_1d_elements(model, vtx_map);
+            return build_1d_elements(model, numbering);
     }
     else if (dim == 3)
-        return build_3d_elements(model, vtx_map);
+        return build_3d_elements(model, numbering);
     else
         throw Exception("Element construction for your setup is not implemented yet");
 }
@@ -1114,13 +1666,225 @@ create_side_set(Ptr<const Mesh> mesh, const std::vector<HasseIndex> & idxs)
         throw Exception("Null pointer access");
 }
 
+std::vector<Index>
+find_coincident_points(PointsView points, double threshold)
+{
+    const auto n = points.size();
+    const auto threshold2 = threshold * threshold;
+
+    double cell_size = 2. * threshold;
+    if (cell_size <= 0.) {
+        // exact matches only, pick a cell size that spreads the points over the grid
+        BoundingBox3D bbox;
+        for (const auto & pt : points)
+            bbox += pt;
+        auto extent = n > 0 ? std::max({ bbox.size(0), bbox.size(1), bbox.size(2) }) : 0.;
+        cell_size = extent > 0. ? extent / std::cbrt(static_cast<double>(n)) : 1.;
+    }
+    PointGrid grid(points, cell_size);
+
+    // points with lower index closer than the threshold (CSR)
+    auto for_each_close = [&](std::size_t i, auto && fn) {
+        grid.for_each_neighbor(points[i], [&](Index j) {
+            if (j < i && distance2(points[i], points[j]) <= threshold2)
+                fn(j);
+        });
+    };
+    // points are visited in the grid order, so that the neighboring cells stay in the cache
+    auto order = grid.sorted();
+    std::vector<u64> ofst(n + 1, 0);
+    parallel_for(n, [&](std::size_t k) {
+        auto i = order[k];
+        for_each_close(i, [&](Index) { ++ofst[i + 1]; });
+    });
+    auto n_pairs = parallel_offsets(ofst);
+    std::vector<Index> close(n_pairs);
+    parallel_for(n, [&](std::size_t k) {
+        auto i = order[k];
+        auto pos = ofst[i];
+        for_each_close(i, [&](Index j) { close[pos++] = j; });
+        std::sort(close.begin() + ofst[i], close.begin() + ofst[i + 1]);
+    });
+
+    // points are kept greedily in the index order
+    std::vector<Index> target(n);
+    std::vector<u8> kept(n, 0);
+    for (auto i : make_range(n)) {
+        auto begin = close.begin() + ofst[i];
+        auto end = close.begin() + ofst[i + 1];
+        auto first = std::find_if(begin, end, [&](Index j) { return kept[j]; });
+        if (first != end)
+            target[i] = *first;
+        else {
+            kept[i] = 1;
+            target[i] = i;
+        }
+    }
+
+    // diagnostics: distances between kept points and the points close to them
+    std::size_t close_pairs_count = 0;
+    double min_dist2 = std::numeric_limits<double>::max();
+    const int BINS = 10;
+    std::array<std::size_t, BINS> histogram {};
+    for (auto i : make_range(n)) {
+        for (auto k : make_range(ofst[i], ofst[i + 1])) {
+            auto j = close[k];
+            if (!kept[i] && !kept[j])
+                continue;
+            auto dist2 = distance2(points[i], points[j]);
+            ++close_pairs_count;
+            min_dist2 = std::min(min_dist2, dist2);
+
+            double dist = std::sqrt(dist2);
+            int bin = 0;
+            if (threshold > 0.)
+                bin = std::min<int>((dist / threshold) * histogram.size(), histogram.size() - 1);
+            histogram[bin]++;
+        }
+    }
+
+    Log::info(2, "Diagnostics:");
+    Log::info(2, "  Total close pairs: {} ", utils::human_number(close_pairs_count));
+    Log::info(2, "  Histogram (0.0 = identical, 1.0 = exactly at tolerance)");
+    print_histogram<BINS>(histogram);
+    if (close_pairs_count > 0)
+        Log::info(2, "  Smallest separation: {:.6g}", std::sqrt(min_dist2));
+
+    return target;
+}
+
+namespace {
+
+/// Build records of all element facets sorted by their vertices
+///
+/// @param elems Elements
+/// @param ofst [out] Index of the first facet of every element (number of elements + 1 entries)
+/// @return Sorted facet records
+std::vector<FacetRecord>
+sorted_facets(ElementsView elems, std::vector<u64> & ofst)
+{
+    ofst.assign(elems.size() + 1, 0);
+    parallel_for(elems.size(), [&](std::size_t i) { ofst[i + 1] = facet_count(elems[i].type()); });
+    auto n_facets = parallel_offsets(ofst);
+
+    std::vector<FacetRecord> records(n_facets);
+    parallel_for(elems.size(), [&](std::size_t i) {
+        for (auto j : make_range(facet_count(elems[i].type()))) {
+            auto & rec = records[ofst[i] + j];
+            rec.vtx.fill(std::numeric_limits<Index>::max());
+            auto n = facet_vertices(elems[i], j, rec.vtx);
+            std::sort(rec.vtx.begin(), rec.vtx.begin() + n);
+            rec.elem = i;
+            rec.side = j;
+        }
+    });
+    parallel_sort(records, [](const FacetRecord & a, const FacetRecord & b) {
+        if (a.vtx != b.vtx)
+            return a.vtx < b.vtx;
+        if (a.elem != b.elem)
+            return a.elem < b.elem;
+        return a.side < b.side;
+    });
+    return records;
+}
+
+} // namespace
+
+std::vector<SideEntry>
+boundary_sides(const Mesh & mesh)
+{
+    Log::info(2, "Extracting boundary");
+    LoggingTimer timer;
+
+    auto elems = mesh.elements();
+    std::vector<u64> ofst;
+    auto records = sorted_facets(elems, ofst);
+    auto n_facets = records.size();
+
+    // facets that have a single supporting element, flagged by their (element, side) slot so
+    // the result comes out ordered by element and side
+    std::vector<u8> on_boundary(n_facets, 0);
+    parallel_for(n_facets, [&](std::size_t i) {
+        bool unique = (i == 0 || records[i - 1].vtx != records[i].vtx) &&
+                      (i + 1 == n_facets || records[i + 1].vtx != records[i].vtx);
+        if (unique)
+            on_boundary[ofst[records[i].elem] + records[i].side] = 1;
+    });
+
+    std::vector<SideEntry> sides;
+    sides.reserve(std::count(on_boundary.begin(), on_boundary.end(), 1));
+    for (auto i : make_range(elems.size()))
+        for (auto j : make_range(ofst[i], ofst[i + 1]))
+            if (on_boundary[j])
+                sides.emplace_back(i, j - ofst[i]);
+    return sides;
+}
+
+std::vector<SideEntry>
+boundary_sides(Ptr<const Mesh> mesh)
+{
+    if (mesh)
+        return boundary_sides(*mesh);
+    else
+        throw Exception("Null pointer access");
+}
+
+std::vector<Index>
+boundary_nodes(const Mesh & mesh)
+{
+    auto elems = mesh.elements();
+    auto sides = boundary_sides(mesh);
+    std::vector<u8> on_boundary(mesh.num_points(), 0);
+    parallel_for(sides.size(), [&](std::size_t i) {
+        std::array<Index, 4> vtx;
+        auto n = facet_vertices(elems[sides[i].elem], sides[i].side, vtx);
+        for (auto j : make_range(n))
+            std::atomic_ref<u8>(on_boundary[vtx[j]]).store(1, std::memory_order_relaxed);
+    });
+
+    std::vector<Index> nodes;
+    nodes.reserve(std::count(on_boundary.begin(), on_boundary.end(), 1));
+    for (auto i : make_range(on_boundary.size()))
+        if (on_boundary[i])
+            nodes.push_back(i);
+    return nodes;
+}
+
+std::vector<Optional<SideEntry>>
+match_sides(const Mesh & mesh, ElementsView facets)
+{
+    std::vector<u64> ofst;
+    auto records = sorted_facets(mesh.elements(), ofst);
+
+    std::vector<Optional<SideEntry>> sides(facets.size());
+    parallel_for(facets.size(), [&](std::size_t i) {
+        FacetRecord key;
+        key.vtx.fill(std::numeric_limits<Index>::max());
+        auto vtx = facets[i].indices();
+        if (vtx.size() > key.vtx.size())
+            return;
+        std::copy(vtx.begin(), vtx.end(), key.vtx.begin());
+        std::sort(key.vtx.begin(), key.vtx.begin() + vtx.size());
+        auto it = std::lower_bound(records.begin(),
+                                   records.end(),
+                                   key,
+                                   [](const FacetRecord & a, const FacetRecord & b) {
+                                       return a.vtx < b.vtx;
+                                   });
+        if (it != records.end() && it->vtx == key.vtx)
+            sides[i] = SideEntry(it->elem, it->side);
+    });
+    return sides;
+}
+
 Ptr<Mesh>
 build_mesh(const GeomModel & model)
 {
     Log::debug("Building mesh");
 
-    auto [points, vtx_map] = build_points(model);
-    auto elements = build_elements(model, vtx_map);
+    auto numbering = number_vertices(model);
+    auto points = build_points(model, numbering);
+    auto elements = build_elements(model, numbering);
     auto mesh = Ptr<Mesh>::alloc(points, elements);
     // TODO: create cell sets
     // TODO: create side sets
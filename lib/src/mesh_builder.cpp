@@ -0,0 +1,166 @@
+// SPDX-FileCopyrightText: 2026 David Andrs <andrsd@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "krado/mesh_builder.h"
+#include "krado/mesh.h"
+#include "krado/exception.h"
+#include "krado/log.h"
+
+namespace krado {
+
+namespace {
+
+void
+merge_name(std::map<Marker, std::string> & names,
+           Marker id,
+           const std::string & name,
+           const char * kind)
+{
+    auto [it, inserted] = names.emplace(id, name);
+    if (!inserted && it->second != name)
+        Log::warn("{} set with id={} already exists, but with a different name '{}'",
+                  kind,
+                  id,
+                  name);
+}
+
+} // namespace
+
+void
+MeshBuilder::reserve(std::size_t n_points, std::size_t n_elements, std::size_t n_indices)
+{
+    this->pnts_.reserve(n_points);
+    this->elems_.reserve(n_elements, n_indices > 0 ? n_indices : 4 * n_elements);
+}
+
+std::size_t
+MeshBuilder::num_points() const
+{
+    return this->pnts_.size();
+}
+
+std::size_t
+MeshBuilder::num_elements() const
+{
+    return this->elems_.size();
+}
+
+MeshBuilder &
+MeshBuilder::add(const Mesh & mesh)
+{
+    Index pt_ofst = this->pnts_.size();
+    Index elem_ofst = this->elems_.size();
+
+    this->pnts_.append(mesh.points());
+    this->elems_.append(mesh.elements(), pt_ofst);
+
+    for (auto id : mesh.cell_set_ids()) {
+        auto & cs = this->cell_sets_[id];
+        for (auto cell : mesh.cell_set(id))
+            cs.push_back(cell + elem_ofst);
+        auto name = mesh.cell_set_name(id);
+        if (name.has_value())
+            merge_name(this->cell_set_names_, id, name.value(), "Cell");
+    }
+    for (auto id : mesh.side_set_ids()) {
+        auto & ss = this->side_sets_[id];
+        for (auto & side : mesh.side_set(id))
+            ss.emplace_back(side.elem + elem_ofst, side.side);
+        auto name = mesh.side_set_name(id);
+        if (name.has_value())
+            merge_name(this->side_set_names_, id, name.value(), "Side");
+    }
+    for (auto id : mesh.node_set_ids()) {
+        auto & ns = this->node_sets_[id];
+        for (auto node : mesh.node_set(id))
+            ns.push_back(node + pt_ofst);
+        auto name = mesh.node_set_name(id);
+        if (name.has_value())
+            merge_name(this->node_set_names_, id, name.value(), "Node");
+    }
+
+    return *this;
+}
+
+MeshBuilder &
+MeshBuilder::add(Ptr<const Mesh> mesh)
+{
+    if (mesh)
+        return add(*mesh);
+    else
+        throw Exception("Null pointer access");
+}
+
+Index
+MeshBuilder::add_point(const Point & pt)
+{
+    this->pnts_.push_back(pt);
+    return this->pnts_.size() - 1;
+}
+
+Index
+MeshBuilder::add_element(const Element & elem)
+{
+    this->elems_.push_back(elem);
+    return this->elems_.size() - 1;
+}
+
+void
+MeshBuilder::add_to_cell_set(Marker id, Index elem)
+{
+    this->cell_sets_[id].push_back(elem);
+}
+
+void
+MeshBuilder::add_to_side_set(Marker id, SideEntry side)
+{
+    this->side_sets_[id].push_back(side);
+}
+
+void
+MeshBuilder::add_to_node_set(Marker id, Index node)
+{
+    this->node_sets_[id].push_back(node);
+}
+
+void
+MeshBuilder::set_cell_set_name(Marker id, const std::string & name)
+{
+    this->cell_set_names_[id] = name;
+}
+
+void
+MeshBuilder::set_side_set_name(Marker id, const std::string & name)
+{
+    this->side_set_names_[id] = name;
+}
+
+void
+MeshBuilder::set_node_set_name(Marker id, const std::string & name)
+{
+    this->node_set_names_[id] = name;
+}
+
+Ptr<Mesh>
+MeshBuilder::build()
+{
+    auto mesh = Ptr<Mesh>::alloc(std::move(this->pnts_), std::move(this->elems_));
+    mesh->cell_set_names_ = std::move(this->cell_set_names_);
+    mesh->cell_sets_ = std::move(this->cell_sets_);
+    mesh->side_set_names_ = std::move(this->side_set_names_);
+    mesh->side_sets_ = std::move(this->side_sets_);
+    mesh->node_set_names_ = std::move(this->node_set_names_);
+    mesh->node_sets_ = std::move(this->node_sets_);
+
+    this->pnts_.clear();
+    this->elems_.clear();
+    this->cell_set_names_.clear();
+    this->cell_sets_.clear();
+    this->side_set_names_.clear();
+    this->side_sets_.clear();
+    this->node_set_names_.clear();
+    this->node_sets_.clear();
+    return mesh;
+}
+
+} // namespace krado
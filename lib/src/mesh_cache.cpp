@@ -0,0 +1,538 @@
+// SPDX-FileCopyrightText: 2026 David Andrs <andrsd@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "krado/mesh_cache.h"
+#include "krado/exception.h"
+#include "krado/geom_curve.h"
+#include "krado/geom_surface.h"
+#include "krado/log.h"
+#include "krado/mesh_curve.h"
+#include "krado/mesh_curve_vertex.h"
+#include "krado/mesh_element.h"
+#include "krado/mesh_surface.h"
+#include "krado/mesh_surface_vertex.h"
+#include "krado/mesh_vertex.h"
+#include "krado/scheme.h"
+#include "krado/uv_param.h"
+#include "BRep_Tool.hxx"
+#include "BRepAdaptor_Surface.hxx"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <unordered_map>
+#include <vector>
+#include <unistd.h>
+
+namespace krado {
+
+namespace {
+
+/// Number of samples per parameter direction used in fingerprints
+const int N_SAMPLES = 8;
+
+const char MAGIC[8] = { 'K', 'R', 'M', 'C', 'A', 'C', 'H', '1' };
+
+/// Kind of a mesh vertex referenced by a cached element
+enum VertexKind : std::uint32_t {
+    /// Bounding vertex of a curve
+    BOUNDING = 0,
+    /// Curve vertex
+    CURVE = 1,
+    /// Surface vertex
+    SURFACE = 2
+};
+
+/// Reference to a mesh vertex: kind, position of the curve in the owning entity and vertex index
+struct VertexRef {
+    std::uint32_t kind;
+    std::uint32_t owner;
+    std::uint32_t index;
+};
+
+/// 64-bit FNV-1a hash
+std::uint64_t
+fnv1a(const std::string & str)
+{
+    std::uint64_t hash = 14695981039346656037ULL;
+    for (unsigned char c : str) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+void
+append_point(std::string & str, const Point & pt)
+{
+    str += fmt::format(";{:.12g},{:.12g},{:.12g}", pt.x, pt.y, pt.z);
+}
+
+class Writer {
+public:
+    explicit Writer(const std::filesystem::path & file_name) :
+        out_(file_name, std::ios::binary | std::ios::trunc)
+    {
+    }
+
+    [[nodiscard]] bool
+    good() const
+    {
+        return this->out_.good();
+    }
+
+    template <typename T>
+    void
+    write(const T & val)
+    {
+        this->out_.write(reinterpret_cast<const char *>(&val), sizeof(T));
+    }
+
+    template <typename T>
+    void
+    write(const std::vector<T> & vals)
+    {
+        write<std::uint64_t>(vals.size());
+        this->out_.write(reinterpret_cast<const char *>(vals.data()), sizeof(T) * vals.size());
+    }
+
+    void
+    write(const std::string & str)
+    {
+        write<std::uint64_t>(str.size());
+        this->out_.write(str.data(), str.size());
+    }
+
+    void
+    close()
+    {
+        this->out_.close();
+    }
+
+private:
+    std::ofstream out_;
+};
+
+class Reader {
+public:
+    explicit Reader(const std::filesystem::path & file_name) :
+        in_(file_name, std::ios::binary),
+        size_(std::filesystem::file_size(file_name))
+    {
+        if (!this->in_)
+            throw Exception("Unable to open '{}'", file_name.string());
+    }
+
+    template <typename T>
+    T
+    read()
+    {
+        T val;
+        read_bytes(reinterpret_cast<char *>(&val), sizeof(T));
+        return val;
+    }
+
+    template <typename T>
+    std::vector<T>
+    read_vector()
+    {
+        auto n = read_count(sizeof(T));
+        std::vector<T> vals(n);
+        read_bytes(reinterpret_cast<char *>(vals.data()), sizeof(T) * n);
+        return vals;
+    }
+
+    std::string
+    read_string()
+    {
+        auto n = read_count(1);
+        std::string str(n, '\0');
+        read_bytes(str.data(), n);
+        return str;
+    }
+
+private:
+    std::size_t
+    read_count(std::size_t item_size)
+    {
+        auto n = read<std::uint64_t>();
+        // guard against allocating garbage sizes from a truncated file
+        if (n > this->size_ / item_size)
+            throw Exception("Invalid item count");
+        return n;
+    }
+
+    void
+    read_bytes(char * data, std::size_t n)
+    {
+        if (!this->in_.read(data, n))
+            throw Exception("Unexpected end of file");
+    }
+
+    std::ifstream in_;
+    std::uintmax_t size_;
+};
+
+/// Map from mesh vertices to their references
+class VertexRefMap {
+public:
+    void
+    add_curve(std::uint32_t owner, const MeshCurve & curve)
+    {
+        auto bnd_vtxs = curve.bounding_vertices();
+        for (std::uint32_t i = 0; i < bnd_vtxs.size(); ++i)
+            this->refs_.emplace(bnd_vtxs[i].get(), VertexRef { BOUNDING, owner, i });
+        auto curve_vtxs = curve.curve_vertices();
+        for (std::uint32_t i = 0; i < curve_vtxs.size(); ++i)
+            this->refs_.emplace(curve_vtxs[i].get(), VertexRef { CURVE, owner, i });
+    }
+
+    void
+    add_surface(const MeshSurface & surface)
+    {
+        auto surf_vtxs = surface.surface_vertices();
+        for (std::uint32_t i = 0; i < surf_vtxs.size(); ++i)
+            this->refs_.emplace(surf_vtxs[i].get(), VertexRef { SURFACE, 0, i });
+    }
+
+    /// Append references of element vertices
+    ///
+    /// @return `false` if an element has a vertex that is not in the map
+    bool
+    add_elements(Span<const MeshElement> elems, std::vector<VertexRef> & refs) const
+    {
+        for (auto & e : elems) {
+            for (auto & v : e.vertices()) {
+                auto it = this->refs_.find(v.get());
+                if (it == this->refs_.end())
+                    return false;
+                refs.push_back(it->second);
+            }
+        }
+        return true;
+    }
+
+private:
+    std::unordered_map<const MeshVertexAbstract *, VertexRef> refs_;
+};
+
+/// Check that a reference points to an existing vertex
+///
+/// @param ref Vertex reference
+/// @param curves Curves of the entity
+/// @param n_curve_vtxs Number of curve vertices of each curve
+/// @param n_surf_vtxs Number of surface vertices
+bool
+is_valid(const VertexRef & ref,
+         Span<const Ptr<MeshCurve>> curves,
+         const std::vector<std::size_t> & n_curve_vtxs,
+         std::size_t n_surf_vtxs)
+{
+    switch (ref.kind) {
+    case BOUNDING:
+        return ref.owner < curves.size() &&
+               ref.index < curves[ref.owner]->bounding_vertices().size();
+    case CURVE:
+        return ref.owner < curves.size() && ref.index < n_curve_vtxs[ref.owner];
+    case SURFACE:
+        return ref.owner == 0 && ref.index < n_surf_vtxs;
+    default:
+        return false;
+    }
+}
+
+Ptr<MeshVertexAbstract>
+resolve(const VertexRef & ref,
+        Span<const Ptr<MeshCurve>> curves,
+        Span<const Ptr<MeshSurfaceVertex>> surf_vtxs)
+{
+    switch (ref.kind) {
+    case BOUNDING:
+        return curves[ref.owner]->bounding_vertices()[ref.index];
+    case CURVE:
+        return curves[ref.owner]->curve_vertices()[ref.index];
+    default:
+        return surf_vtxs[ref.index];
+    }
+}
+
+void
+write_header(Writer & out, const std::string & key)
+{
+    for (auto c : MAGIC)
+        out.write(c);
+    out.write(key);
+}
+
+/// Read file header
+///
+/// @return `true` if the file holds a mesh with fingerprint `key`
+bool
+read_header(Reader & in, const std::string & key)
+{
+    for (auto c : MAGIC)
+        if (in.read<char>() != c)
+            return false;
+    return in.read_string() == key;
+}
+
+/// Write a file so that concurrent readers never see it half-written
+template <typename FN>
+void
+write_file(const std::filesystem::path & file_name, FN && fn)
+{
+    // unique across threads (counter), processes (pid) and hosts sharing the directory (random)
+    static std::atomic<unsigned int> counter { 0 };
+    auto tmp = file_name;
+    tmp += fmt::format(".{}.{}.{:08x}.tmp",
+                       ::getpid(),
+                       counter.fetch_add(1, std::memory_order_relaxed),
+                       std::random_device()());
+    Writer out(tmp);
+    fn(out);
+    out.close();
+    if (!out.good())
+        throw Exception("Unable to write '{}'", tmp.string());
+    std::filesystem::rename(tmp, file_name);
+}
+
+} // namespace
+
+MeshCache::MeshCache(const std::filesystem::path & dir) : dir_(dir)
+{
+    std::error_code ec;
+    std::filesystem::create_directories(dir, ec);
+    if (ec)
+        throw Exception("Unable to create mesh cache directory '{}': {}",
+                        dir.string(),
+                        ec.message());
+}
+
+const std::filesystem::path &
+MeshCache::directory() const
+{
+    return this->dir_;
+}
+
+std::filesystem::path
+MeshCache::file_name(const std::string & key) const
+{
+    return this->dir_ / fmt::format("{:016x}.kmc", fnv1a(key));
+}
+
+std::string
+MeshCache::fingerprint(Ptr<MeshCurve> curve, Scheme & scheme)
+{
+    const auto & gcurve = curve->geom_curve();
+    auto [umin, umax] = gcurve.param_range();
+    const TopoDS_Edge & edge = gcurve;
+
+    std::vector<double> u(N_SAMPLES);
+    for (int i = 0; i < N_SAMPLES; ++i)
+        u[i] = umin + (umax - umin) * i / (N_SAMPLES - 1);
+    std::vector<Point> pts(N_SAMPLES);
+    gcurve.point(u, pts);
+
+    auto key = fmt::format("curve;{};{};{:.12g},{:.12g};{:.12g}",
+                           gcurve.type(),
+                           gcurve.orientation(),
+                           umin,
+                           umax,
+                           BRep_Tool::Tolerance(edge));
+    for (auto & pt : pts)
+        append_point(key, pt);
+    key += fmt::format(";{};{}", scheme.name(), scheme.params_to_str());
+    return key;
+}
+
+std::string
+MeshCache::fingerprint(Ptr<MeshSurface> surface, Scheme & scheme)
+{
+    const auto & gsurface = surface->geom_surface();
+    auto [umin, umax] = gsurface.param_range(0);
+    auto [vmin, vmax] = gsurface.param_range(1);
+    const TopoDS_Face & face = gsurface;
+
+    std::vector<UVParam> uv;
+    uv.reserve(N_SAMPLES * N_SAMPLES);
+    for (int i = 0; i < N_SAMPLES; ++i)
+        for (int j = 0; j < N_SAMPLES; ++j)
+            uv.emplace_back(umin + (umax - umin) * i / (N_SAMPLES - 1),
+                            vmin + (vmax - vmin) * j / (N_SAMPLES - 1));
+    std::vector<Point> pts(uv.size());
+    gsurface.point(uv, pts);
+
+    // reversed faces have the same samples, but the elements are wound the other way
+    auto key = fmt::format("surface;{};{};{:.12g},{:.12g},{:.12g},{:.12g};{:.12g}",
+                           static_cast<int>(BRepAdaptor_Surface(face).GetType()),
+                           static_cast<int>(face.Orientation()),
+                           umin,
+                           umax,
+                           vmin,
+                           vmax,
+                           BRep_Tool::Tolerance(face));
+    for (auto & pt : pts)
+        append_point(key, pt);
+    // surface mesh connects to the curve vertices, so it is valid only for the same curve meshes
+    for (auto & crv : surface->curves()) {
+        std::string crv_mesh;
+        for (auto & v : crv->bounding_vertices())
+            append_point(crv_mesh, v->point());
+        for (auto & v : crv->curve_vertices())
+            append_point(crv_mesh, v->point());
+        key += fmt::format(";{}:{:016x}", crv->curve_vertices().size(), fnv1a(crv_mesh));
+    }
+    key += fmt::format(";{};{}", scheme.name(), scheme.params_to_str());
+    return key;
+}
+
+bool
+MeshCache::load(Ptr<MeshCurve> curve, Scheme & scheme) const
+{
+    auto key = fingerprint(curve, scheme);
+    auto fn = file_name(key);
+    if (!std::filesystem::exists(fn))
+        return false;
+
+    try {
+        Reader in(fn);
+        if (!read_header(in, key))
+            return false;
+        auto params = in.read_vector<double>();
+        auto seg_refs = in.read_vector<VertexRef>();
+
+        std::array<Ptr<MeshCurve>, 1> curves { curve };
+        std::vector<std::size_t> n_curve_vtxs { params.size() };
+        if (seg_refs.size() % 2 != 0)
+            throw Exception("Invalid segments");
+        for (auto & r : seg_refs)
+            if (!is_valid(r, curves, n_curve_vtxs, 0))
+                throw Exception("Invalid vertex reference");
+
+        curve->add_vertices(params);
+        for (std::size_t i = 0; i < seg_refs.size(); i += 2)
+            curve->add_segment({ resolve(seg_refs[i], curves, {}),
+                                 resolve(seg_refs[i + 1], curves, {}) });
+    }
+    catch (std::exception & e) {
+        Log::warn("Ignoring mesh cache file '{}': {}", fn.string(), e.what());
+        return false;
+    }
+    return true;
+}
+
+bool
+MeshCache::load(Ptr<MeshSurface> surface, Scheme & scheme) const
+{
+    auto key = fingerprint(surface, scheme);
+    auto fn = file_name(key);
+    if (!std::filesystem::exists(fn))
+        return false;
+
+    try {
+        Reader in(fn);
+        if (!read_header(in, key))
+            return false;
+        auto uvs = in.read_vector<UVParam>();
+        auto tri_refs = in.read_vector<VertexRef>();
+        auto quad_refs = in.read_vector<VertexRef>();
+
+        auto curves = surface->curves();
+        std::vector<std::size_t> n_curve_vtxs;
+        for (auto & crv : curves)
+            n_curve_vtxs.push_back(crv->curve_vertices().size());
+        if (tri_refs.size() % 3 != 0 || quad_refs.size() % 4 != 0)
+            throw Exception("Invalid elements");
+        for (auto & refs : { std::cref(tri_refs), std::cref(quad_refs) })
+            for (auto & r : refs.get())
+                if (!is_valid(r, curves, n_curve_vtxs, uvs.size()))
+                    throw Exception("Invalid vertex reference");
+
+        auto first = surface->surface_vertices().size();
+        surface->add_vertices(uvs);
+        auto surf_vtxs = surface->surface_vertices().subspan(first);
+        surface->reserve_mem(tri_refs.size() / 3);
+        for (std::size_t i = 0; i < tri_refs.size(); i += 3)
+            surface->add_triangle({ resolve(tri_refs[i], curves, surf_vtxs),
+                                    resolve(tri_refs[i + 1], curves, surf_vtxs),
+                                    resolve(tri_refs[i + 2], curves, surf_vtxs) });
+        for (std::size_t i = 0; i < quad_refs.size(); i += 4)
+            surface->add_quadrangle({ resolve(quad_refs[i], curves, surf_vtxs),
+                                      resolve(quad_refs[i + 1], curves, surf_vtxs),
+                                      resolve(quad_refs[i + 2], curves, surf_vtxs),
+                                      resolve(quad_refs[i + 3], curves, surf_vtxs) });
+    }
+    catch (std::exception & e) {
+        Log::warn("Ignoring mesh cache file '{}': {}", fn.string(), e.what());
+        return false;
+    }
+    return true;
+}
+
+void
+MeshCache::store(Ptr<MeshCurve> curve, Scheme & scheme) const
+{
+    auto key = fingerprint(curve, scheme);
+
+    VertexRefMap ref_map;
+    ref_map.add_curve(0, *curve);
+    std::vector<VertexRef> seg_refs;
+    if (!ref_map.add_elements(curve->segments(), seg_refs)) {
+        Log::debug("Not caching mesh of curve {}: unknown vertices", curve->id());
+        return;
+    }
+
+    std::vector<double> params;
+    for (auto & cv : curve->curve_vertices())
+        params.push_back(cv->parameter());
+
+    try {
+        write_file(file_name(key), [&](Writer & out) {
+            write_header(out, key);
+            out.write(params);
+            out.write(seg_refs);
+        });
+    }
+    catch (std::exception & e) {
+        Log::warn("Unable to cache mesh of curve {}: {}", curve->id(), e.what());
+    }
+}
+
+void
+MeshCache::store(Ptr<MeshSurface> surface, Scheme & scheme) const
+{
+    auto key = fingerprint(surface, scheme);
+
+    VertexRefMap ref_map;
+    auto curves = surface->curves();
+    for (std::uint32_t k = 0; k < curves.size(); ++k)
+        ref_map.add_curve(k, *curves[k]);
+    ref_map.add_surface(*surface);
+    std::vector<VertexRef> tri_refs;
+    std::vector<VertexRef> quad_refs;
+    if (!ref_map.add_elements(surface->triangles(), tri_refs) ||
+        !ref_map.add_elements(surface->quadrangles(), quad_refs)) {
+        Log::debug("Not caching mesh of surface {}: unknown vertices", surface->id());
+        return;
+    }
+
+    std::vector<UVParam> uvs;
+    for (auto & sv : surface->surface_vertices())
+        uvs.push_back(sv->parameter());
+
+    try {
+        write_file(file_name(key), [&](Writer & out) {
+            write_header(out, key);
+            out.write(uvs);
+            out.write(tri_refs);
+            out.write(quad_refs);
+        });
+    }
+    catch (std::exception & e) {
+        Log::warn("Unable to cache mesh of surface {}: {}", surface->id(), e.what());
+    }
+}
+
+} // namespace krado
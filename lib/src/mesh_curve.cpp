@@ -54,6 +54,24 @@ MeshCurve::add_vertex(Ptr<MeshCurveVertex> curve_vertex)
     this->curve_vtx_.push_back(curve_vertex);
 }
 
+Ptr<MeshCurveVertex>
+MeshCurve::add_vertex(double u)
+{
+    auto vtx = this->vtx_arena_.alloc(this->gcurve_, u);
+    this->curve_vtx_.push_back(vtx);
+    return vtx;
+}
+
+void
+MeshCurve::add_vertices(Span<const double> u)
+{
+    std::vector<Point> pts(u.size());
+    this->gcurve_.point(u, pts);
+    this->curve_vtx_.reserve(this->curve_vtx_.size() + u.size());
+    for (std::size_t i = 0; i < u.size(); ++i)
+        this->curve_vtx_.push_back(this->vtx_arena_.alloc(this->gcurve_, u[i], pts[i]));
+}
+
 Span<const Ptr<MeshCurveVertex>>
 MeshCurve::curve_vertices() const
 {
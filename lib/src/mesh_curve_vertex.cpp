@@ -14,6 +14,14 @@ MeshCurveVertex::MeshCurveVertex(const GeomCurve & geom_curve, double u) :
     this->phys_pt_ = geom_curve.point(u);
 }
 
+MeshCurveVertex::MeshCurveVertex(const GeomCurve & geom_curve, double u, const Point & pt) :
+    MeshVertexAbstract(geom_curve),
+    gcurve_(geom_curve),
+    u_(u),
+    phys_pt_(pt)
+{
+}
+
 const GeomCurve &
 MeshCurveVertex::geom_curve() const
 {
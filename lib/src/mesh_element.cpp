@@ -10,14 +10,23 @@
 #include "krado/point.h"
 #include "krado/element.h"
 #include "krado/range.h"
+#include <algorithm>
 #include <cassert>
 
 namespace krado {
 
 MeshElement::MeshElement(ElementType type, const std::vector<Ptr<MeshVertexAbstract>> & vtx) :
     type_(type),
-    vtx_(vtx)
+    n_vtx_(0)
 {
+    set_vertices(vtx);
+}
+
+MeshElement::MeshElement(ElementType type, std::initializer_list<Ptr<MeshVertexAbstract>> vtx) :
+    type_(type),
+    n_vtx_(0)
+{
+    set_vertices(Span<const Ptr<MeshVertexAbstract>>(vtx.begin(), vtx.size()));
 }
 
 MeshElement::~MeshElement() = default;
@@ -31,20 +40,20 @@ MeshElement::type() const
 int
 MeshElement::num_vertices() const
 {
-    return this->vtx_.size();
+    return this->n_vtx_;
 }
 
 Ptr<MeshVertexAbstract>
 MeshElement::vertex(int idx) const
 {
-    assert(!this->vtx_[idx].is_null());
+    assert(idx < this->n_vtx_ && !this->vtx_[idx].is_null());
     return this->vtx_[idx];
 }
 
 Span<const Ptr<MeshVertexAbstract>>
 MeshElement::vertices() const
 {
-    return this->vtx_;
+    return Span<const Ptr<MeshVertexAbstract>>(this->vtx_.data(), this->n_vtx_);
 }
 
 MeshElement
@@ -64,6 +73,17 @@ MeshElement::get_edge(int i) const
         throw Exception("Unsupported element to get edge of");
 }
 
+void
+MeshElement::set_vertices(Span<const Ptr<MeshVertexAbstract>> vtx)
+{
+    if (vtx.size() > MAX_VERTICES)
+        throw Exception("Mesh element can have at most {} vertices, got {}",
+                        MAX_VERTICES,
+                        vtx.size());
+    std::copy(vtx.begin(), vtx.end(), this->vtx_.begin());
+    this->n_vtx_ = vtx.size();
+}
+
 void
 MeshElement::swap_vertices(int idx1, int idx2)
 {
@@ -98,6 +98,24 @@ MeshSurface::add_vertex(Ptr<MeshSurfaceVertex> vertex)
     this->surf_vtxs_.push_back(vertex);
 }
 
+Ptr<MeshSurfaceVertex>
+MeshSurface::add_vertex(const UVParam & uv)
+{
+    auto vtx = this->vtx_arena_.alloc(this->gsurface_, uv);
+    this->surf_vtxs_.push_back(vtx);
+    return vtx;
+}
+
+void
+MeshSurface::add_vertices(Span<const UVParam> uv)
+{
+    std::vector<Point> pts(uv.size());
+    this->gsurface_.point(uv, pts);
+    this->surf_vtxs_.reserve(this->surf_vtxs_.size() + uv.size());
+    for (std::size_t i = 0; i < uv.size(); ++i)
+        this->surf_vtxs_.push_back(this->vtx_arena_.alloc(this->gsurface_, uv[i], pts[i]));
+}
+
 void
 MeshSurface::add_triangle(const std::array<Ptr<MeshVertexAbstract>, 3> & tri)
 {
@@ -129,20 +147,28 @@ MeshSurface::quads_to_tris(QuadSplitMode mode)
     if (this->quads_.empty())
         return;
 
-    for (const auto & quad : this->quads_) {
-        auto v = quad.vertices();
-        if (mode == QuadSplitMode::SPLIT2) {
+    if (mode == QuadSplitMode::SPLIT2) {
+        for (const auto & quad : this->quads_) {
+            auto v = quad.vertices();
             add_triangle({ v[0], v[1], v[2] });
             add_triangle({ v[2], v[3], v[0] });
         }
-        else if (mode == QuadSplitMode::SPLIT4) {
-            const auto & gsurf = geom_surface();
-            Point center_pt =
-                0.25 * (v[0]->point() + v[1]->point() + v[2]->point() + v[3]->point());
-            auto uv = gsurf.parameter_from_point(center_pt);
-
-            auto center_vtx = Ptr<MeshSurfaceVertex>::alloc(this->gsurface_, uv);
-            this->surf_vtxs_.push_back(center_vtx);
+    }
+    else if (mode == QuadSplitMode::SPLIT4) {
+        const auto n_quads = this->quads_.size();
+        std::vector<Point> center_pts(n_quads);
+        for (std::size_t i = 0; i < n_quads; ++i) {
+            auto v = this->quads_[i].vertices();
+            center_pts[i] = 0.25 * (v[0]->point() + v[1]->point() + v[2]->point() + v[3]->point());
+        }
+        std::vector<UVParam> center_uvs(n_quads);
+        geom_surface().parameter_from_point(center_pts, center_uvs);
+
+        auto first = this->surf_vtxs_.size();
+        add_vertices(center_uvs);
+        for (std::size_t i = 0; i < n_quads; ++i) {
+            auto v = this->quads_[i].vertices();
+            Ptr<MeshVertexAbstract> center_vtx = this->surf_vtxs_[first + i];
             add_triangle({ v[0], v[1], center_vtx });
             add_triangle({ v[1], v[2], center_vtx });
             add_triangle({ v[2], v[3], center_vtx });
@@ -22,6 +22,16 @@ MeshSurfaceVertex::MeshSurfaceVertex(const GeomSurface & geom_surface, UVParam u
     this->phys_pt_ = geom_surface.point(this->uv_);
 }
 
+MeshSurfaceVertex::MeshSurfaceVertex(const GeomSurface & geom_surface,
+                                     UVParam uv,
+                                     const Point & pt) :
+    MeshVertexAbstract(geom_surface),
+    gsurface_(geom_surface),
+    uv_(uv),
+    phys_pt_(pt)
+{
+}
+
 const GeomSurface &
 MeshSurfaceVertex::geom_surface() const
 {
@@ -40,10 +50,17 @@ MeshSurfaceVertex::point() const
     return this->phys_pt_;
 }
 
+void
+MeshSurfaceVertex::set_parameter(UVParam uv)
+{
+    this->uv_ = uv;
+    this->phys_pt_ = this->gsurface_.point(uv);
+}
+
 void
 MeshSurfaceVertex::relocate(const Point & p)
 {
-    this->uv_ = this->gsurface_.parameter_from_point(p);
+    this->uv_ = this->gsurface_.parameter_from_point(p, this->uv_);
     this->phys_pt_ = this->gsurface_.point(this->uv_);
 }
 
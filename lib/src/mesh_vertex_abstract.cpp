@@ -2,18 +2,21 @@
 // SPDX-License-Identifier: MIT
 
 #include "krado/mesh_vertex_abstract.h"
+#include <atomic>
 
 namespace krado {
 
 namespace {
 
-int vertex_counter = 0;
+// vertices can be created from several threads
+std::atomic<Index> vertex_counter = 0;
 
 }
 
 MeshVertexAbstract::MeshVertexAbstract(const GeomShape & geom_shape) :
     geom_shape_(geom_shape),
-    num_(vertex_counter++)
+    num_(vertex_counter.fetch_add(1, std::memory_order_relaxed)),
+    num_pass_(0)
 {
 }
 
@@ -23,10 +26,23 @@ MeshVertexAbstract::geom_shape() const
     return this->geom_shape_;
 }
 
-int
+Index
 MeshVertexAbstract::num() const
 {
     return this->num_;
 }
 
+void
+MeshVertexAbstract::set_num(Index num, u32 pass)
+{
+    this->num_ = num;
+    this->num_pass_ = pass;
+}
+
+u32
+MeshVertexAbstract::num_pass() const
+{
+    return this->num_pass_;
+}
+
 } // namespace krado
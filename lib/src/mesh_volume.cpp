@@ -56,6 +56,12 @@ MeshVolume::add_tetra(const std::array<Ptr<MeshVertexAbstract>, 4> & tetra)
     this->tetras_.emplace_back(tet4);
 }
 
+bool
+MeshVolume::has_scheme() const
+{
+    return this->scheme_.get() != nullptr;
+}
+
 Scheme3D &
 MeshVolume::scheme()
 {
@@ -22,6 +22,10 @@
 #include "krado/range.h"
 #include "krado/timer.h"
 #include "krado/fe_values.h"
+#include "krado/parallel.h"
+#include "krado/pattern.h"
+#include "krado/transform.h"
+#include "krado/uv_param.h"
 #include "Geom_TrimmedCurve.hxx"
 #include "BRepLib.hxx"
 #include "BRepBuilderAPI_MakeEdge.hxx"
@@ -49,7 +53,10 @@
 #include "BRepAlgoAPI_Splitter.hxx"
 #include "TopTools_DataMapOfShapeInteger.hxx"
 #include "BRepGProp.hxx"
-#include <set>
+#include <array>
+#include <atomic>
+#include <limits>
+#include <unordered_map>
 
 namespace krado {
 
@@ -263,11 +270,23 @@ compute_volume(Ptr<const Mesh> mesh)
     return compute_volume(*mesh);
 }
 
+namespace {
+
+/// Combine mesh parts
+///
+/// @param parts Mesh parts to combine
+/// @param merged_points Points of the combined mesh if points were merged (empty otherwise)
+/// @param point_map Index into `merged_points` for every point of the concatenated parts
+/// @return Combined mesh
 Ptr<Mesh>
-combine(const std::vector<Ptr<Mesh>> & parts)
+combine_parts(const std::vector<const Mesh *> & parts,
+              Coordinates merged_points,
+              Span<const Index> point_map)
 {
+    const bool merge = !point_map.empty();
     Index n_total_elems = 0;
     Index n_total_points = 0;
+    std::size_t n_total_ids = 0;
     // how much we shift element and point indices per mesh part
     std::vector<Index> elem_shift;
     elem_shift.reserve(parts.size());
@@ -278,25 +297,25 @@ combine(const std::vector<Ptr<Mesh>> & parts)
         pts_shift.push_back(n_total_points);
         n_total_elems += p->num_elements();
         n_total_points += p->num_points();
+        n_total_ids += p->connectivity().ids().size();
     }
 
-    // combine points and elements
-    std::vector<Point> points;
-    std::vector<Element> elements;
-    points.reserve(n_total_points);
-    elements.reserve(n_total_elems);
-    for (const auto & p : parts) {
-        points.insert(points.end(), p->points().begin(), p->points().end());
-        elements.insert(elements.end(), p->elements().begin(), p->elements().end());
-    }
-    // shift points
-    for (std::size_t i = 0, k = 0; i < parts.size(); ++i) {
-        const auto & p = parts[i];
-        for (std::size_t j = 0; j < p->num_elements(); ++j, ++k) {
-            auto & elem = elements[k];
-            elem.shift(pts_shift[i]);
-        }
+    // combine points and elements, element vertex indices are shifted while appended
+    Coordinates points;
+    Connectivity elements;
+    if (merge)
+        points = std::move(merged_points);
+    else
+        points.reserve(n_total_points);
+    elements.reserve(n_total_elems, n_total_ids);
+    for (auto i : make_range(parts.size())) {
+        if (!merge)
+            points.append(parts[i]->points());
+        elements.append(parts[i]->elements(), pts_shift[i]);
     }
+    // renumber points
+    if (merge)
+        elements.remap(point_map);
 
     // merge cell sets
     std::unordered_map<Marker, std::size_t> cell_sets_size;
@@ -392,12 +411,19 @@ combine(const std::vector<Ptr<Mesh>> & parts)
 
                 auto node_set = p->node_set(id);
                 for (const auto & c : node_set)
-                    node_sets[id].push_back(c + pts_shift[i]);
+                    node_sets[id].push_back(merge ? point_map[c + pts_shift[i]] : c + pts_shift[i]);
+            }
+        }
+        if (merge) {
+            // nodes on interfaces may now be listed more than once
+            for (auto & [id, nset] : node_sets) {
+                std::sort(nset.begin(), nset.end());
+                nset.erase(std::unique(nset.begin(), nset.end()), nset.end());
             }
         }
     }
 
-    auto mesh = Ptr<Mesh>::alloc(points, elements);
+    auto mesh = Ptr<Mesh>::alloc(std::move(points), std::move(elements));
     for (auto & [id, cset] : cell_sets)
         mesh->set_cell_set(id, cset);
     for (auto & [id, name] : cell_set_names)
@@ -416,6 +442,178 @@ combine(const std::vector<Ptr<Mesh>> & parts)
     return mesh;
 }
 
+/// Result of merging coincident points of concatenated mesh parts
+struct PointMerge {
+    /// Number of points after merging
+    Index n_points;
+    /// Index of the merged point for every point of the concatenated parts
+    std::vector<Index> point_map;
+    /// Point of the concatenated parts every point is merged into (itself if the point is kept)
+    std::vector<Index> merged_into;
+};
+
+/// Merge coincident points of concatenated mesh parts
+///
+/// @param n_total_points Number of points of the concatenated parts
+/// @param candidates Points that can coincide with other points
+/// @param candidate_pts Coordinates of the candidates
+/// @param merge_tolerance Points closer than this distance are merged
+/// @return Mapping of the points
+PointMerge
+merge_points(Index n_total_points,
+             Span<const Index> candidates,
+             const Coordinates & candidate_pts,
+             double merge_tolerance)
+{
+    Log::info(2,
+              "Matching {} boundary nodes out of {}",
+              utils::human_number(candidates.size()),
+              utils::human_number(n_total_points));
+    auto target = find_coincident_points(candidate_pts, merge_tolerance);
+
+    PointMerge merge;
+    merge.merged_into.resize(n_total_points);
+    parallel_for(n_total_points, [&](std::size_t i) { merge.merged_into[i] = i; });
+    parallel_for(candidates.size(), [&](std::size_t k) {
+        merge.merged_into[candidates[k]] = candidates[target[k]];
+    });
+
+    std::vector<u64> rank(n_total_points + 1, 0);
+    parallel_for(n_total_points,
+                 [&](std::size_t i) { rank[i + 1] = merge.merged_into[i] == i ? 1 : 0; });
+    merge.n_points = parallel_offsets(rank);
+
+    merge.point_map.resize(n_total_points);
+    parallel_for(n_total_points,
+                 [&](std::size_t i) { merge.point_map[i] = rank[merge.merged_into[i]]; });
+    Log::info(2,
+              "Merged {} points into {}",
+              utils::human_number(n_total_points),
+              utils::human_number(merge.n_points));
+    return merge;
+}
+
+std::vector<const Mesh *>
+raw_parts(const std::vector<Ptr<Mesh>> & parts)
+{
+    std::vector<const Mesh *> raw;
+    raw.reserve(parts.size());
+    for (auto & p : parts)
+        raw.push_back(p.get());
+    return raw;
+}
+
+} // namespace
+
+Ptr<Mesh>
+combine(const std::vector<Ptr<Mesh>> & parts)
+{
+    return combine_parts(raw_parts(parts), {}, {});
+}
+
+Ptr<Mesh>
+combine(const std::vector<Ptr<Mesh>> & parts, double merge_tolerance)
+{
+    Log::info("Combining {} mesh parts: merge tolerance={}", parts.size(), merge_tolerance);
+    LoggingTimer timer;
+
+    // only nodes on the boundary of a part can coincide with nodes of another part
+    Index n_total_points = 0;
+    std::vector<Index> pts_shift;
+    pts_shift.reserve(parts.size());
+    std::vector<Index> candidates;
+    Coordinates candidate_pts;
+    for (const auto & p : parts) {
+        auto pnts = p->points();
+        for (auto n : boundary_nodes(*p)) {
+            candidates.push_back(n_total_points + n);
+            candidate_pts.push_back(pnts[n]);
+        }
+        pts_shift.push_back(n_total_points);
+        n_total_points += p->num_points();
+    }
+    auto merge = merge_points(n_total_points, candidates, candidate_pts, merge_tolerance);
+
+    Coordinates points;
+    points.resize(merge.n_points);
+    for (auto i : make_range(parts.size())) {
+        auto pnts = parts[i]->points();
+        parallel_for(pnts.size(), [&](std::size_t j) {
+            auto k = pts_shift[i] + j;
+            if (merge.merged_into[k] == k)
+                points.set(merge.point_map[k], pnts[j]);
+        });
+    }
+
+    return combine_parts(raw_parts(parts), std::move(points), merge.point_map);
+}
+
+Ptr<Mesh>
+instantiate(const Mesh & prototype, const std::vector<Trsf> & placements, double merge_tolerance)
+{
+    Log::info("Instantiating mesh: copies={}, merge tolerance={}",
+              placements.size(),
+              merge_tolerance);
+    LoggingTimer timer;
+
+    const auto n_copies = placements.size();
+    const Index n_pts = prototype.num_points();
+    auto pnts = prototype.points();
+
+    // boundary nodes are the same in every copy, so they are found only once
+    auto bnd = boundary_nodes(prototype);
+    std::vector<Index> candidates(n_copies * bnd.size());
+    Coordinates candidate_pts;
+    candidate_pts.resize(candidates.size());
+    parallel_for(candidates.size(), [&](std::size_t i) {
+        auto copy = i / bnd.size();
+        auto n = bnd[i % bnd.size()];
+        candidates[i] = copy * n_pts + n;
+        candidate_pts.set(i, placements[copy] * pnts[n]);
+    });
+    auto merge = merge_points(n_copies * n_pts, candidates, candidate_pts, merge_tolerance);
+
+    Coordinates points;
+    points.resize(merge.n_points);
+    parallel_for(n_copies * n_pts, [&](std::size_t k) {
+        if (merge.merged_into[k] == k)
+            points.set(merge.point_map[k], placements[k / n_pts] * pnts[k % n_pts]);
+    });
+
+    std::vector<const Mesh *> parts(n_copies, &prototype);
+    return combine_parts(parts, std::move(points), merge.point_map);
+}
+
+Ptr<Mesh>
+instantiate(Ptr<const Mesh> prototype,
+            const std::vector<Trsf> & placements,
+            double merge_tolerance)
+{
+    if (prototype)
+        return instantiate(*prototype, placements, merge_tolerance);
+    else
+        throw Exception("Null pointer access");
+}
+
+Ptr<Mesh>
+instantiate(const Mesh & prototype, const Pattern & pattern, double merge_tolerance)
+{
+    std::vector<Trsf> placements;
+    placements.reserve(pattern.points().size());
+    for (auto & pt : pattern.points())
+        placements.push_back(Trsf::translated(pt.x, pt.y, pt.z));
+    return instantiate(prototype, placements, merge_tolerance);
+}
+
+Ptr<Mesh>
+instantiate(Ptr<const Mesh> prototype, const Pattern & pattern, double merge_tolerance)
+{
+    if (prototype)
+        return instantiate(*prototype, pattern, merge_tolerance);
+    else
+        throw Exception("Null pointer access");
+}
+
 GeomShape
 fuse(const GeomShape & shape, const GeomShape & tool, bool simplify)
 {
@@ -610,59 +808,392 @@ sew(const std::vector<GeomShape> & faces, double tol)
     return GeomShape(sewing_tool.SewedShape());
 }
 
-void
-smooth(Ptr<MeshSurface> surface, int iterations)
-{
-    LoggingTimer timer;
-    Log::info("Applying Laplace smoothing on surface {} ({} iterations)",
-              surface->id(),
-              iterations);
-
-    // 1. Build adjacency map for internal vertices
-    std::map<Ptr<MeshVertexAbstract>, std::set<Ptr<MeshVertexAbstract>>> neighbors;
-
-    for (auto vtx : surface->surface_vertices())
-        neighbors[vtx] = {};
-
-    auto add_neighbors = [&](const MeshElement & elem) {
-        auto vtxs = elem.vertices();
-        for (auto i : make_range(vtxs.size())) {
-            auto vtx = vtxs[i];
-            auto it = neighbors.find(vtx);
-            if (it != neighbors.end()) {
-                for (auto j : make_range(vtxs.size())) {
-                    if (i != j) {
-                        it->second.insert(vtxs[j]);
+namespace {
+
+/// Surface mesh prepared for smoothing
+///
+/// Vertices are numbered locally. Vertices inside the surface can move and come first, vertices on
+/// the bounding curves stay fixed. Adjacency is stored in CSR format and built once.
+class SurfaceSmoother {
+public:
+    explicit SurfaceSmoother(MeshSurface & surface) :
+        surface_(surface),
+        gsurf_(surface.geom_surface()),
+        n_movable_(surface.surface_vertices().size())
+    {
+        std::unordered_map<const MeshVertexAbstract *, Index> local_idx;
+        for (auto & vtx : surface.surface_vertices()) {
+            local_idx.emplace(vtx.get(), this->pts_.size());
+            this->pts_.push_back(vtx->point());
+            this->uvs_.push_back(vtx->parameter());
+        }
+
+        this->elem_offsets_.push_back(0);
+        auto add_element = [&](const MeshElement & elem) {
+            for (auto & vtx : elem.vertices()) {
+                auto [it, inserted] = local_idx.emplace(vtx.get(), this->pts_.size());
+                if (inserted)
+                    this->pts_.push_back(vtx->point());
+                this->elem_vtxs_.push_back(it->second);
+            }
+            this->elem_types_.push_back(elem.type());
+            this->elem_offsets_.push_back(this->elem_vtxs_.size());
+        };
+        for (const auto & tri : surface.triangles())
+            add_element(tri);
+        for (const auto & quad : surface.quadrangles())
+            add_element(quad);
+
+        build_vertex_elements();
+        build_neighbors();
+    }
+
+    /// Move vertices to the average of their neighbors (Jacobi iterations)
+    ///
+    /// @param iterations Maximum number of iterations
+    /// @param tolerance Stop when no vertex moves more than this
+    void
+    laplace(int iterations, double tolerance)
+    {
+        std::vector<Point> targets(this->n_movable_);
+        std::vector<UVParam> new_uvs(this->n_movable_);
+        std::vector<Point> new_pts(this->n_movable_);
+        for (auto iter : make_range(iterations)) {
+            parallel_for(
+                this->n_movable_,
+                [&](std::size_t i) { targets[i] = neighbor_average(i); },
+                256);
+            this->gsurf_.parameter_from_point(targets,
+                                              Span<const UVParam>(this->uvs_),
+                                              new_uvs);
+            this->gsurf_.point(new_uvs, new_pts);
+
+            auto max_dist = parallel_reduce(
+                this->n_movable_,
+                0.,
+                [&](std::size_t begin, std::size_t end) {
+                    double d = 0.;
+                    for (auto i = begin; i < end; ++i) {
+                        d = std::max(d, this->pts_[i].distance(new_pts[i]));
+                        this->pts_[i] = new_pts[i];
+                        this->uvs_[i] = new_uvs[i];
                     }
+                    return d;
+                },
+                [](double a, double b) { return std::max(a, b); });
+            Log::debug("Smoothing iteration {}: max displacement {}", iter + 1, max_dist);
+            if (max_dist < tolerance)
+                break;
+        }
+    }
+
+    /// Move vertices so that the minimum quality of the surrounding elements increases
+    ///
+    /// Vertices are processed by colors. Vertices of the same color do not share elements, so they
+    /// can move concurrently.
+    ///
+    /// @param iterations Maximum number of iterations
+    /// @param metric Quality metric
+    /// @param tolerance Stop when the minimum quality improves less than this
+    void
+    optimize(int iterations, qm::Metric metric, double tolerance)
+    {
+        const double sign = qm::higher_is_better(metric) ? 1. : -1.;
+        auto [color_offsets, color_vtxs] = color_vertices();
+
+        auto min_score = [&]() {
+            return parallel_reduce(
+                this->elem_types_.size(),
+                std::numeric_limits<double>::max(),
+                [&](std::size_t begin, std::size_t end) {
+                    double q = std::numeric_limits<double>::max();
+                    for (auto e = begin; e < end; ++e)
+                        q = std::min(q, sign * quality(e, metric));
+                    return q;
+                },
+                [](double a, double b) { return std::min(a, b); });
+        };
+
+        auto q_min = min_score();
+        Log::info(2, "Initial minimum quality: {}", sign * q_min);
+        for (auto iter : make_range(iterations)) {
+            std::atomic<bool> moved { false };
+            for (std::size_t c = 0; c + 1 < color_offsets.size(); ++c) {
+                auto vtxs = Span<const Index>(color_vtxs).subspan(
+                    color_offsets[c],
+                    color_offsets[c + 1] - color_offsets[c]);
+
+                std::vector<Point> targets(vtxs.size());
+                std::vector<UVParam> guesses(vtxs.size());
+                std::vector<UVParam> target_uvs(vtxs.size());
+                for (std::size_t i = 0; i < vtxs.size(); ++i) {
+                    targets[i] = neighbor_average(vtxs[i]);
+                    guesses[i] = this->uvs_[vtxs[i]];
                 }
+                this->gsurf_.parameter_from_point(targets, guesses, target_uvs);
+
+                parallel_for(
+                    vtxs.size(),
+                    [&](std::size_t i) {
+                        if (improve_vertex(vtxs[i], target_uvs[i], metric, sign))
+                            moved = true;
+                    },
+                    64);
             }
+
+            auto q_new = min_score();
+            Log::debug("Smoothing iteration {}: minimum quality {}", iter + 1, sign * q_new);
+            auto improvement = q_new - q_min;
+            q_min = q_new;
+            if (!moved || improvement < tolerance)
+                break;
         }
-    };
+        Log::info(2, "Final minimum quality: {}", sign * q_min);
+    }
 
-    for (auto tri : surface->triangles())
-        add_neighbors(tri);
-    for (auto quad : surface->quadrangles())
-        add_neighbors(quad);
-
-    // 2. Perform Laplace iterations
-    for (auto iter : make_range(iterations)) {
-        (void) iter;
-        std::map<Ptr<MeshVertexAbstract>, Point> new_positions;
-        for (const auto & [vtx, adj] : neighbors) {
-            Point avg(0, 0, 0);
-            for (const auto & neighbor : adj)
-                avg += neighbor->point();
-
-            if (not adj.empty()) {
-                avg *= 1.0 / adj.size();
-                new_positions[vtx] = avg;
-            }
+    /// Write new locations into the surface vertices
+    void
+    apply()
+    {
+        auto vtxs = this->surface_.surface_vertices();
+        parallel_for(
+            this->n_movable_,
+            [&](std::size_t i) { vtxs[i]->set_parameter(this->uvs_[i]); },
+            256);
+    }
+
+private:
+    void
+    build_vertex_elements()
+    {
+        this->vtx_elem_offsets_.assign(this->n_movable_ + 1, 0);
+        for (auto v : this->elem_vtxs_)
+            if (v < this->n_movable_)
+                this->vtx_elem_offsets_[v + 1]++;
+        parallel_offsets(this->vtx_elem_offsets_);
+
+        this->vtx_elems_.resize(this->vtx_elem_offsets_.back());
+        std::vector<Index> pos(this->vtx_elem_offsets_.begin(), this->vtx_elem_offsets_.end() - 1);
+        for (Index e = 0; e < this->elem_types_.size(); ++e)
+            for (auto v : element_vertices(e))
+                if (v < this->n_movable_)
+                    this->vtx_elems_[pos[v]++] = e;
+    }
+
+    void
+    build_neighbors()
+    {
+        // upper bound on the number of neighbors, then sort, remove duplicates and compact
+        std::vector<Index> bound(this->n_movable_ + 1, 0);
+        parallel_for(this->n_movable_, [&](std::size_t v) {
+            for (auto e : vertex_elements(v))
+                bound[v + 1] += element_vertices(e).size() - 1;
+        });
+        parallel_offsets(bound);
+
+        std::vector<Index> nbrs(bound.back());
+        this->nbr_offsets_.assign(this->n_movable_ + 1, 0);
+        parallel_for(this->n_movable_, [&](std::size_t v) {
+            auto first = nbrs.begin() + bound[v];
+            auto last = first;
+            for (auto e : vertex_elements(v))
+                for (auto w : element_vertices(e))
+                    if (w != v)
+                        *last++ = w;
+            std::sort(first, last);
+            this->nbr_offsets_[v + 1] = std::unique(first, last) - first;
+        });
+        parallel_offsets(this->nbr_offsets_);
+
+        this->nbrs_.resize(this->nbr_offsets_.back());
+        parallel_for(this->n_movable_, [&](std::size_t v) {
+            auto first = nbrs.begin() + bound[v];
+            std::copy(first,
+                      first + (this->nbr_offsets_[v + 1] - this->nbr_offsets_[v]),
+                      this->nbrs_.begin() + this->nbr_offsets_[v]);
+        });
+    }
+
+    /// Greedy coloring, so that vertices of the same color do not share an element
+    ///
+    /// @return CSR offsets and vertices of each color
+    std::tuple<std::vector<Index>, std::vector<Index>>
+    color_vertices() const
+    {
+        std::vector<Index> color(this->n_movable_, 0);
+        Index n_colors = 0;
+        std::vector<bool> used;
+        for (Index v = 0; v < this->n_movable_; ++v) {
+            used.assign(n_colors + 1, false);
+            for (auto w : neighbors(v))
+                if (w < v)
+                    used[color[w]] = true;
+            color[v] = std::find(used.begin(), used.end(), false) - used.begin();
+            n_colors = std::max(n_colors, color[v] + 1);
         }
 
-        // Relocate vertices
-        for (const auto & [vtx, pos] : new_positions)
-            vtx->relocate(pos);
+        std::vector<Index> offsets(n_colors + 1, 0);
+        for (auto c : color)
+            offsets[c + 1]++;
+        parallel_offsets(offsets);
+        std::vector<Index> vtxs(this->n_movable_);
+        std::vector<Index> pos(offsets.begin(), offsets.end() - 1);
+        for (Index v = 0; v < this->n_movable_; ++v)
+            vtxs[pos[color[v]]++] = v;
+        return { offsets, vtxs };
+    }
+
+    Span<const Index>
+    element_vertices(std::size_t e) const
+    {
+        return Span<const Index>(this->elem_vtxs_)
+            .subspan(this->elem_offsets_[e], this->elem_offsets_[e + 1] - this->elem_offsets_[e]);
+    }
+
+    Span<const Index>
+    vertex_elements(std::size_t v) const
+    {
+        return Span<const Index>(this->vtx_elems_)
+            .subspan(this->vtx_elem_offsets_[v],
+                     this->vtx_elem_offsets_[v + 1] - this->vtx_elem_offsets_[v]);
     }
+
+    Span<const Index>
+    neighbors(std::size_t v) const
+    {
+        return Span<const Index>(this->nbrs_).subspan(
+            this->nbr_offsets_[v],
+            this->nbr_offsets_[v + 1] - this->nbr_offsets_[v]);
+    }
+
+    Point
+    neighbor_average(std::size_t v) const
+    {
+        auto nbrs = neighbors(v);
+        if (nbrs.empty())
+            return this->pts_[v];
+        Point avg(0, 0, 0);
+        for (auto w : nbrs)
+            avg += this->pts_[w];
+        avg *= 1.0 / nbrs.size();
+        return avg;
+    }
+
+    /// Get element vertex locations, with vertex `v` moved to `pt`
+    std::array<Point, 4>
+    element_points(std::size_t e, Index v = INVALID_IDX, const Point & pt = Point()) const
+    {
+        std::array<Point, 4> pts;
+        auto idxs = element_vertices(e);
+        for (std::size_t i = 0; i < idxs.size(); ++i)
+            pts[i] = idxs[i] == v ? pt : this->pts_[idxs[i]];
+        return pts;
+    }
+
+    double
+    quality(std::size_t e, qm::Metric metric, Index v = INVALID_IDX, const Point & pt = Point())
+        const
+    {
+        auto pts = element_points(e, v, pt);
+        auto n = element_vertices(e).size();
+        return qm::compute_metric(this->elem_types_[e], Span<const Point>(pts.data(), n), metric);
+    }
+
+    /// Element normal (not normalized), used to detect inverted elements
+    Vector
+    element_normal(std::size_t e, Index v = INVALID_IDX, const Point & pt = Point()) const
+    {
+        auto pts = element_points(e, v, pt);
+        if (this->elem_types_[e] == ElementType::TRI3)
+            return cross_product(pts[1] - pts[0], pts[2] - pts[0]);
+        else
+            return cross_product(pts[2] - pts[0], pts[3] - pts[1]);
+    }
+
+    /// Try moving vertex `v` towards `target_uv`
+    ///
+    /// @return `true` if the vertex moved
+    bool
+    improve_vertex(Index v, UVParam target_uv, qm::Metric metric, double sign)
+    {
+        auto elems = vertex_elements(v);
+        double best = std::numeric_limits<double>::max();
+        for (auto e : elems)
+            best = std::min(best, sign * quality(e, metric));
+
+        const auto uv0 = this->uvs_[v];
+        bool moved = false;
+        for (double t : { 1., 0.5, 0.25 }) {
+            UVParam uv(uv0.u + t * (target_uv.u - uv0.u), uv0.v + t * (target_uv.v - uv0.v));
+            auto pt = this->gsurf_.point(uv);
+            double q = std::numeric_limits<double>::max();
+            for (auto e : elems) {
+                if (dot_product(element_normal(e), element_normal(e, v, pt)) <= 0.) {
+                    q = -std::numeric_limits<double>::max();
+                    break;
+                }
+                q = std::min(q, sign * quality(e, metric, v, pt));
+            }
+            if (q > best) {
+                best = q;
+                this->pts_[v] = pt;
+                this->uvs_[v] = uv;
+                moved = true;
+            }
+        }
+        return moved;
+    }
+
+    static constexpr Index INVALID_IDX = std::numeric_limits<Index>::max();
+
+    MeshSurface & surface_;
+    const GeomSurface & gsurf_;
+    /// Number of vertices that can move (local indices `[0, n_movable_)`)
+    std::size_t n_movable_;
+    /// Vertex locations
+    std::vector<Point> pts_;
+    /// Parameters of movable vertices
+    std::vector<UVParam> uvs_;
+    /// Element types
+    std::vector<ElementType> elem_types_;
+    /// Element vertices (CSR)
+    std::vector<Index> elem_offsets_;
+    std::vector<Index> elem_vtxs_;
+    /// Elements around movable vertices (CSR)
+    std::vector<Index> vtx_elem_offsets_;
+    std::vector<Index> vtx_elems_;
+    /// Neighbors of movable vertices (CSR)
+    std::vector<Index> nbr_offsets_;
+    std::vector<Index> nbrs_;
+};
+
+} // namespace
+
+void
+smooth(Ptr<MeshSurface> surface, int iterations)
+{
+    SmoothingOptions opts;
+    opts.iterations = iterations;
+    smooth(surface, opts);
+}
+
+void
+smooth(Ptr<MeshSurface> surface, const SmoothingOptions & opts)
+{
+    LoggingTimer timer;
+    if (opts.method == SmoothingMethod::LAPLACE)
+        Log::info("Applying Laplace smoothing on surface {} ({} iterations)",
+                  surface->id(),
+                  opts.iterations);
+    else
+        Log::info("Optimizing surface {} ({} iterations)", surface->id(), opts.iterations);
+
+    SurfaceSmoother smoother(*surface);
+    if (opts.method == SmoothingMethod::LAPLACE)
+        smoother.laplace(opts.iterations, opts.tolerance);
+    else
+        smoother.optimize(opts.iterations, opts.metric, opts.tolerance);
+    smoother.apply();
 }
 
 } // namespace krado
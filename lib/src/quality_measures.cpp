@@ -10,6 +10,7 @@
 #include "krado/exception.h"
 #include <cmath>
 #include <algorithm>
+#include <array>
 #include <limits>
 
 namespace krado {
@@ -61,105 +62,6 @@ metric_name(Metric metric)
     }
 }
 
-double
-compute_metric(const Element & elem, const Mesh & mesh, Metric metric)
-{
-    ElementType type = elem.type();
-    switch (metric) {
-    case Metric::ASPECT_RATIO:
-        if (type == ElementType::TRI3)
-            return aspect_ratio<ElementType::TRI3>(elem, mesh);
-        if (type == ElementType::QUAD4)
-            return aspect_ratio<ElementType::QUAD4>(elem, mesh);
-        if (type == ElementType::TETRA4)
-            return aspect_ratio<ElementType::TETRA4>(elem, mesh);
-        if (type == ElementType::HEX8)
-            return aspect_ratio<ElementType::HEX8>(elem, mesh);
-        if (type == ElementType::PRISM6)
-            return aspect_ratio<ElementType::PRISM6>(elem, mesh);
-        if (type == ElementType::PYRAMID5)
-            return aspect_ratio<ElementType::PYRAMID5>(elem, mesh);
-        break;
-    case Metric::MIN_ANGLE:
-        if (type == ElementType::TRI3)
-            return min_angle<ElementType::TRI3>(elem, mesh);
-        if (type == ElementType::QUAD4)
-            return min_angle<ElementType::QUAD4>(elem, mesh);
-        if (type == ElementType::TETRA4)
-            return min_angle<ElementType::TETRA4>(elem, mesh);
-        if (type == ElementType::HEX8)
-            return min_angle<ElementType::HEX8>(elem, mesh);
-        if (type == ElementType::PRISM6)
-            return min_angle<ElementType::PRISM6>(elem, mesh);
-        if (type == ElementType::PYRAMID5)
-            return min_angle<ElementType::PYRAMID5>(elem, mesh);
-        break;
-    case Metric::MAX_ANGLE:
-        if (type == ElementType::TRI3)
-            return max_angle<ElementType::TRI3>(elem, mesh);
-        if (type == ElementType::QUAD4)
-            return max_angle<ElementType::QUAD4>(elem, mesh);
-        if (type == ElementType::TETRA4)
-            return max_angle<ElementType::TETRA4>(elem, mesh);
-        if (type == ElementType::HEX8)
-            return max_angle<ElementType::HEX8>(elem, mesh);
-        if (type == ElementType::PRISM6)
-            return max_angle<ElementType::PRISM6>(elem, mesh);
-        if (type == ElementType::PYRAMID5)
-            return max_angle<ElementType::PYRAMID5>(elem, mesh);
-        break;
-    case Metric::SCALED_JACOBIAN:
-        if (type == ElementType::TRI3)
-            return scaled_jacobian<ElementType::TRI3>(elem, mesh);
-        if (type == ElementType::QUAD4)
-            return scaled_jacobian<ElementType::QUAD4>(elem, mesh);
-        if (type == ElementType::TETRA4)
-            return scaled_jacobian<ElementType::TETRA4>(elem, mesh);
-        if (type == ElementType::HEX8)
-            return scaled_jacobian<ElementType::HEX8>(elem, mesh);
-        if (type == ElementType::PRISM6)
-            return scaled_jacobian<ElementType::PRISM6>(elem, mesh);
-        if (type == ElementType::PYRAMID5)
-            return scaled_jacobian<ElementType::PYRAMID5>(elem, mesh);
-        break;
-    case Metric::ETA:
-        if (type == ElementType::TRI3)
-            return eta<ElementType::TRI3>(elem, mesh);
-        if (type == ElementType::QUAD4)
-            return eta<ElementType::QUAD4>(elem, mesh);
-        if (type == ElementType::TETRA4)
-            return eta<ElementType::TETRA4>(elem, mesh);
-        if (type == ElementType::HEX8)
-            return eta<ElementType::HEX8>(elem, mesh);
-        if (type == ElementType::PRISM6)
-            return eta<ElementType::PRISM6>(elem, mesh);
-        if (type == ElementType::PYRAMID5)
-            return eta<ElementType::PYRAMID5>(elem, mesh);
-        break;
-    case Metric::GAMMA:
-        if (type == ElementType::TRI3)
-            return gamma<ElementType::TRI3>(elem, mesh);
-        if (type == ElementType::TETRA4)
-            return gamma<ElementType::TETRA4>(elem, mesh);
-        break;
-    case Metric::SKEWNESS:
-        if (type == ElementType::QUAD4)
-            return skewness<ElementType::QUAD4>(elem, mesh);
-        if (type == ElementType::HEX8)
-            return skewness<ElementType::HEX8>(elem, mesh);
-        if (type == ElementType::PRISM6)
-            return skewness<ElementType::PRISM6>(elem, mesh);
-        if (type == ElementType::PYRAMID5)
-            return skewness<ElementType::PYRAMID5>(elem, mesh);
-        break;
-    default:
-        break;
-    }
-    throw Exception("Metric {} is not supported for element type {}",
-                    metric_name(metric),
-                    Element::type(type));
-}
-
 void
 print_histogram(const std::vector<std::size_t> & histogram, double min_val, double max_val)
 {
@@ -189,16 +91,29 @@ print_histogram(const std::vector<std::size_t> & histogram, double min_val, doub
 
 } // namespace
 
+namespace {
+
+/// Locations of element vertices
 template <ElementType ET>
-double
-aspect_ratio(const Element & elem, const Mesh & mesh)
+std::array<Point, ElementSelector<ET>::N_VERTICES>
+element_points(const Element & elem, const Mesh & mesh)
 {
     auto idxs = elem.indices();
+    std::array<Point, ElementSelector<ET>::N_VERTICES> pts;
+    for (std::size_t i = 0; i < pts.size(); ++i)
+        pts[i] = mesh.point(idxs[i]);
+    return pts;
+}
+
+template <ElementType ET>
+double
+aspect_ratio(Span<const Point> pts)
+{
     double l_max = 0;
     double l_min = std::numeric_limits<double>::max();
     for (auto & ev : ElementSelector<ET>::edge_vertices()) {
-        const auto & p1 = mesh.point(idxs[ev[0]]);
-        const auto & p2 = mesh.point(idxs[ev[1]]);
+        const auto & p1 = pts[ev[0]];
+        const auto & p2 = pts[ev[1]];
         double l = (p2 - p1).magnitude();
         l_max = std::max(l_max, l);
         l_min = std::min(l_min, l);
@@ -210,16 +125,18 @@ aspect_ratio(const Element & elem, const Mesh & mesh)
 
 template <ElementType ET>
 std::vector<Vector>
-compute_face_normals(const Element & elem, const Mesh & mesh)
+compute_face_normals(Span<const Point> pts)
 {
-    auto idxs = elem.indices();
-    auto center = mesh.compute_centroid(idxs);
+    Point center(0., 0., 0.);
+    for (const auto & pt : pts)
+        center += pt;
+    center *= 1. / static_cast<double>(pts.size());
 
     std::vector<Vector> normals;
     for (auto & fv : ElementSelector<ET>::face_vertices()) {
-        const auto & p0 = mesh.point(idxs[fv[0]]);
-        const auto & p1 = mesh.point(idxs[fv[1]]);
-        const auto & p2 = mesh.point(idxs[fv[2]]);
+        const auto & p0 = pts[fv[0]];
+        const auto & p1 = pts[fv[1]];
+        const auto & p2 = pts[fv[2]];
         Vector n = cross_product(p1 - p0, p2 - p0).normalized();
         if (dot_product(Vector(p0) - Vector(center), n) < 0)
             n = -n;
@@ -230,37 +147,22 @@ compute_face_normals(const Element & elem, const Mesh & mesh)
 
 template <ElementType ET>
 std::vector<double>
-compute_angles_deg(const Element & elem, const Mesh & mesh)
+compute_angles_deg(Span<const Point> pts)
 {
-    auto idxs = elem.indices();
     std::vector<double> angles;
     if constexpr (ET == ElementType::TRI3) {
-        angles.push_back(
-            utils::angle(mesh.point(idxs[2]), mesh.point(idxs[0]), mesh.point(idxs[1])) * 180. /
-            M_PI);
-        angles.push_back(
-            utils::angle(mesh.point(idxs[0]), mesh.point(idxs[1]), mesh.point(idxs[2])) * 180. /
-            M_PI);
-        angles.push_back(
-            utils::angle(mesh.point(idxs[1]), mesh.point(idxs[2]), mesh.point(idxs[0])) * 180. /
-            M_PI);
+        angles.push_back(utils::angle(pts[2], pts[0], pts[1]) * 180. / M_PI);
+        angles.push_back(utils::angle(pts[0], pts[1], pts[2]) * 180. / M_PI);
+        angles.push_back(utils::angle(pts[1], pts[2], pts[0]) * 180. / M_PI);
     }
     else if constexpr (ET == ElementType::QUAD4) {
-        angles.push_back(
-            utils::angle(mesh.point(idxs[3]), mesh.point(idxs[0]), mesh.point(idxs[1])) * 180. /
-            M_PI);
-        angles.push_back(
-            utils::angle(mesh.point(idxs[0]), mesh.point(idxs[1]), mesh.point(idxs[2])) * 180. /
-            M_PI);
-        angles.push_back(
-            utils::angle(mesh.point(idxs[1]), mesh.point(idxs[2]), mesh.point(idxs[3])) * 180. /
-            M_PI);
-        angles.push_back(
-            utils::angle(mesh.point(idxs[2]), mesh.point(idxs[3]), mesh.point(idxs[0])) * 180. /
-            M_PI);
+        angles.push_back(utils::angle(pts[3], pts[0], pts[1]) * 180. / M_PI);
+        angles.push_back(utils::angle(pts[0], pts[1], pts[2]) * 180. / M_PI);
+        angles.push_back(utils::angle(pts[1], pts[2], pts[3]) * 180. / M_PI);
+        angles.push_back(utils::angle(pts[2], pts[3], pts[0]) * 180. / M_PI);
     }
     else {
-        auto normals = compute_face_normals<ET>(elem, mesh);
+        auto normals = compute_face_normals<ET>(pts);
         const auto & face_vtx = ElementSelector<ET>::face_vertices();
         for (std::size_t i = 0; i < face_vtx.size(); ++i) {
             for (std::size_t j = i + 1; j < face_vtx.size(); ++j) {
@@ -282,9 +184,9 @@ compute_angles_deg(const Element & elem, const Mesh & mesh)
 
 template <ElementType ET>
 double
-min_angle(const Element & elem, const Mesh & mesh)
+min_angle(Span<const Point> pts)
 {
-    auto angles = compute_angles_deg<ET>(elem, mesh);
+    auto angles = compute_angles_deg<ET>(pts);
     if (angles.empty())
         return 0;
     return *std::min_element(angles.begin(), angles.end());
@@ -292,9 +194,9 @@ min_angle(const Element & elem, const Mesh & mesh)
 
 template <ElementType ET>
 double
-max_angle(const Element & elem, const Mesh & mesh)
+max_angle(Span<const Point> pts)
 {
-    auto angles = compute_angles_deg<ET>(elem, mesh);
+    auto angles = compute_angles_deg<ET>(pts);
     if (angles.empty())
         return 0;
     return *std::max_element(angles.begin(), angles.end());
@@ -302,16 +204,15 @@ max_angle(const Element & elem, const Mesh & mesh)
 
 template <ElementType ET>
 double
-scaled_jacobian(const Element & elem, const Mesh & mesh)
+scaled_jacobian(Span<const Point> pts)
 {
     Point p = reference_center<ET>();
-    auto idxs = elem.indices();
     if constexpr (ET == ElementType::TRI3 || ET == ElementType::QUAD4) {
         Vector dxdxi(0, 0, 0);
         Vector dxdeta(0, 0, 0);
         for (u8 i = 0; i < ElementSelector<ET>::N_VERTICES; ++i) {
             const auto der = FEValues<ET>::shape_der(i, p);
-            const Vector pt(mesh.point(idxs[i]));
+            const Vector pt(pts[i]);
             dxdxi += der.x * pt;
             dxdeta += der.y * pt;
         }
@@ -327,7 +228,7 @@ scaled_jacobian(const Element & elem, const Mesh & mesh)
         Vector dxdzeta(0, 0, 0);
         for (u8 i = 0; i < ElementSelector<ET>::N_VERTICES; ++i) {
             const auto der = FEValues<ET>::shape_der(i, p);
-            const Vector pt(mesh.point(idxs[i]));
+            const Vector pt(pts[i]);
             dxdxi += der.x * pt;
             dxdeta += der.y * pt;
             dxdzeta += der.z * pt;
@@ -342,14 +243,13 @@ scaled_jacobian(const Element & elem, const Mesh & mesh)
 
 template <ElementType ET>
 double
-eta(const Element & elem, const Mesh & mesh)
+eta(Span<const Point> pts)
 {
     if constexpr (ET == ElementType::TRI3) {
-        auto idxs = elem.indices();
-        return Tri3::eta(mesh.point(idxs[0]), mesh.point(idxs[1]), mesh.point(idxs[2]));
+        return Tri3::eta(pts[0], pts[1], pts[2]);
     }
     else {
-        auto angles = compute_angles_deg<ET>(elem, mesh);
+        auto angles = compute_angles_deg<ET>(pts);
         if (angles.empty())
             return 0;
         double theta_e = 60.0;
@@ -370,20 +270,18 @@ eta(const Element & elem, const Mesh & mesh)
 }
 
 template <ElementType ET>
-    requires IsSimplex<ElementSelector<ET>>
 double
-gamma(const Element & elem, const Mesh & mesh)
+gamma(Span<const Point> pts)
 {
-    auto idxs = elem.indices();
     if constexpr (ET == ElementType::TRI3) {
-        return Tri3::gamma(mesh.point(idxs[0]), mesh.point(idxs[1]), mesh.point(idxs[2]));
+        return Tri3::gamma(pts[0], pts[1], pts[2]);
     }
     else {
         // Tetra4
-        const auto & p0 = mesh.point(idxs[0]);
-        const auto & p1 = mesh.point(idxs[1]);
-        const auto & p2 = mesh.point(idxs[2]);
-        const auto & p3 = mesh.point(idxs[3]);
+        const auto & p0 = pts[0];
+        const auto & p1 = pts[1];
+        const auto & p2 = pts[2];
+        const auto & p3 = pts[3];
         Vector a = p1 - p0;
         Vector b = p2 - p0;
         Vector c = p3 - p0;
@@ -405,12 +303,11 @@ gamma(const Element & elem, const Mesh & mesh)
 }
 
 template <ElementType ET>
-    requires IsNotSimplex<ElementSelector<ET>>
 double
-skewness(const Element & elem, const Mesh & mesh)
+skewness(Span<const Point> pts)
 {
     // For non-simplex elements, we'll use the angles deviation as a measure of skewness
-    auto angles = compute_angles_deg<ET>(elem, mesh);
+    auto angles = compute_angles_deg<ET>(pts);
     if (angles.empty())
         return 0;
     double theta_e = 90.0;
@@ -420,6 +317,198 @@ skewness(const Element & elem, const Mesh & mesh)
     return std::clamp(s_e, 0.0, 1.0);
 }
 
+/// Number of vertices of an element type supported by the quality measures
+std::size_t
+num_vertices(ElementType type)
+{
+    switch (type) {
+    case ElementType::TRI3:
+        return ElementSelector<ElementType::TRI3>::N_VERTICES;
+    case ElementType::QUAD4:
+        return ElementSelector<ElementType::QUAD4>::N_VERTICES;
+    case ElementType::TETRA4:
+        return ElementSelector<ElementType::TETRA4>::N_VERTICES;
+    case ElementType::PYRAMID5:
+        return ElementSelector<ElementType::PYRAMID5>::N_VERTICES;
+    case ElementType::PRISM6:
+        return ElementSelector<ElementType::PRISM6>::N_VERTICES;
+    case ElementType::HEX8:
+        return ElementSelector<ElementType::HEX8>::N_VERTICES;
+    default:
+        throw Exception("Quality measures do not support element type {}", Element::type(type));
+    }
+}
+
+} // namespace
+
+template <ElementType ET>
+double
+aspect_ratio(const Element & elem, const Mesh & mesh)
+{
+    return aspect_ratio<ET>(element_points<ET>(elem, mesh));
+}
+
+template <ElementType ET>
+double
+min_angle(const Element & elem, const Mesh & mesh)
+{
+    return min_angle<ET>(element_points<ET>(elem, mesh));
+}
+
+template <ElementType ET>
+double
+max_angle(const Element & elem, const Mesh & mesh)
+{
+    return max_angle<ET>(element_points<ET>(elem, mesh));
+}
+
+template <ElementType ET>
+double
+scaled_jacobian(const Element & elem, const Mesh & mesh)
+{
+    return scaled_jacobian<ET>(element_points<ET>(elem, mesh));
+}
+
+template <ElementType ET>
+double
+eta(const Element & elem, const Mesh & mesh)
+{
+    return eta<ET>(element_points<ET>(elem, mesh));
+}
+
+template <ElementType ET>
+    requires IsSimplex<ElementSelector<ET>>
+double
+gamma(const Element & elem, const Mesh & mesh)
+{
+    return gamma<ET>(element_points<ET>(elem, mesh));
+}
+
+template <ElementType ET>
+    requires IsNotSimplex<ElementSelector<ET>>
+double
+skewness(const Element & elem, const Mesh & mesh)
+{
+    return skewness<ET>(element_points<ET>(elem, mesh));
+}
+
+double
+compute_metric(ElementType type, Span<const Point> pts, Metric metric)
+{
+    if (pts.size() != num_vertices(type))
+        throw Exception("Element {} has {} vertices, got {}",
+                        Element::type(type),
+                        num_vertices(type),
+                        pts.size());
+
+    switch (metric) {
+    case Metric::ASPECT_RATIO:
+        if (type == ElementType::TRI3)
+            return aspect_ratio<ElementType::TRI3>(pts);
+        if (type == ElementType::QUAD4)
+            return aspect_ratio<ElementType::QUAD4>(pts);
+        if (type == ElementType::TETRA4)
+            return aspect_ratio<ElementType::TETRA4>(pts);
+        if (type == ElementType::HEX8)
+            return aspect_ratio<ElementType::HEX8>(pts);
+        if (type == ElementType::PRISM6)
+            return aspect_ratio<ElementType::PRISM6>(pts);
+        if (type == ElementType::PYRAMID5)
+            return aspect_ratio<ElementType::PYRAMID5>(pts);
+        break;
+    case Metric::MIN_ANGLE:
+        if (type == ElementType::TRI3)
+            return min_angle<ElementType::TRI3>(pts);
+        if (type == ElementType::QUAD4)
+            return min_angle<ElementType::QUAD4>(pts);
+        if (type == ElementType::TETRA4)
+            return min_angle<ElementType::TETRA4>(pts);
+        if (type == ElementType::HEX8)
+            return min_angle<ElementType::HEX8>(pts);
+        if (type == ElementType::PRISM6)
+            return min_angle<ElementType::PRISM6>(pts);
+        if (type == ElementType::PYRAMID5)
+            return min_angle<ElementType::PYRAMID5>(pts);
+        break;
+    case Metric::MAX_ANGLE:
+        if (type == ElementType::TRI3)
+            return max_angle<ElementType::TRI3>(pts);
+        if (type == ElementType::QUAD4)
+            return max_angle<ElementType::QUAD4>(pts);
+        if (type == ElementType::TETRA4)
+            return max_angle<ElementType::TETRA4>(pts);
+        if (type == ElementType::HEX8)
+            return max_angle<ElementType::HEX8>(pts);
+        if (type == ElementType::PRISM6)
+            return max_angle<ElementType::PRISM6>(pts);
+        if (type == ElementType::PYRAMID5)
+            return max_angle<ElementType::PYRAMID5>(pts);
+        break;
+    case Metric::SCALED_JACOBIAN:
+        if (type == ElementType::TRI3)
+            return scaled_jacobian<ElementType::TRI3>(pts);
+        if (type == ElementType::QUAD4)
+            return scaled_jacobian<ElementType::QUAD4>(pts);
+        if (type == ElementType::TETRA4)
+            return scaled_jacobian<ElementType::TETRA4>(pts);
+        if (type == ElementType::HEX8)
+            return scaled_jacobian<ElementType::HEX8>(pts);
+        if (type == ElementType::PRISM6)
+            return scaled_jacobian<ElementType::PRISM6>(pts);
+        if (type == ElementType::PYRAMID5)
+            return scaled_jacobian<ElementType::PYRAMID5>(pts);
+        break;
+    case Metric::ETA:
+        if (type == ElementType::TRI3)
+            return eta<ElementType::TRI3>(pts);
+        if (type == ElementType::QUAD4)
+            return eta<ElementType::QUAD4>(pts);
+        if (type == ElementType::TETRA4)
+            return eta<ElementType::TETRA4>(pts);
+        if (type == ElementType::HEX8)
+            return eta<ElementType::HEX8>(pts);
+        if (type == ElementType::PRISM6)
+            return eta<ElementType::PRISM6>(pts);
+        if (type == ElementType::PYRAMID5)
+            return eta<ElementType::PYRAMID5>(pts);
+        break;
+    case Metric::GAMMA:
+        if (type == ElementType::TRI3)
+            return gamma<ElementType::TRI3>(pts);
+        if (type == ElementType::TETRA4)
+            return gamma<ElementType::TETRA4>(pts);
+        break;
+    case Metric::SKEWNESS:
+        if (type == ElementType::QUAD4)
+            return skewness<ElementType::QUAD4>(pts);
+        if (type == ElementType::HEX8)
+            return skewness<ElementType::HEX8>(pts);
+        if (type == ElementType::PRISM6)
+            return skewness<ElementType::PRISM6>(pts);
+        if (type == ElementType::PYRAMID5)
+            return skewness<ElementType::PYRAMID5>(pts);
+        break;
+    default:
+        break;
+    }
+    throw Exception("Metric {} is not supported for element type {}",
+                    metric_name(metric),
+                    Element::type(type));
+}
+
+bool
+higher_is_better(Metric metric)
+{
+    switch (metric) {
+    case Metric::ASPECT_RATIO:
+    case Metric::MAX_ANGLE:
+    case Metric::SKEWNESS:
+        return false;
+    default:
+        return true;
+    }
+}
+
 // Explicit instantiations
 template double aspect_ratio<ElementType::TRI3>(const Element &, const Mesh &);
 template double aspect_ratio<ElementType::QUAD4>(const Element &, const Mesh &);
@@ -490,8 +579,19 @@ compute_quality(const Mesh & mesh, qm::Metric metric, int n_bins)
     std::vector<double> qualities;
     qualities.reserve(mesh.num_elements());
 
+    // hexahedron has the most vertices
+    std::array<Point, ElementSelector<ElementType::HEX8>::N_VERTICES> pts;
     for (const auto & elem : mesh.elements()) {
-        double q = qm::compute_metric(elem, mesh, metric);
+        auto idxs = elem.indices();
+        if (idxs.size() != qm::num_vertices(elem.type()))
+            throw Exception("Element {} has {} vertices, got {}",
+                            Element::type(elem.type()),
+                            qm::num_vertices(elem.type()),
+                            idxs.size());
+        for (std::size_t i = 0; i < idxs.size(); ++i)
+            pts[i] = mesh.point(idxs[i]);
+        auto elem_pts = Span<const Point>(pts.data(), idxs.size());
+        double q = qm::compute_metric(elem.type(), elem_pts, metric);
         q_min = std::min(q_min, q);
         q_max = std::max(q_max, q);
         qualities.push_back(q);
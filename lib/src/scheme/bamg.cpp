@@ -278,4 +278,10 @@ SchemeBAMG::mesh_surface(Ptr<MeshSurface> surface)
     }
 }
 
+bool
+SchemeBAMG::is_thread_safe() const
+{
+    return false;
+}
+
 } // namespace krado
@@ -40,6 +40,7 @@ SchemeBias::mesh_curve(Ptr<MeshCurve> curve)
     // place mesh curve vertices
     double l0 = geom_curve.length() * (bias_factor - 1.) / (std::pow(bias_factor, n_segs) - 1);
     double p_prev = 0.;
+    std::vector<double> params;
     for (int count = 1, num_pts = 0; num_pts < n_segs - 1;) {
         auto pt1 = igrl.point(count - 1);
         auto pt2 = igrl.point(count);
@@ -49,13 +50,14 @@ SchemeBias::mesh_curve(Ptr<MeshCurve> curve)
             const auto dt = pt2.t - pt1.t;
             const auto dp = pt2.p - pt1.p;
             const auto t = pt1.t + dt / dp * (d - pt1.p);
-            curve->add_vertex(Ptr<MeshCurveVertex>::alloc(geom_curve, t));
+            params.push_back(t);
             num_pts++;
         }
         else {
             count++;
         }
     }
+    curve->add_vertices(params);
 
     build_curve_segments(curve);
 }
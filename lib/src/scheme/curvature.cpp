@@ -62,6 +62,7 @@ SchemeCurvature::mesh_curve(Ptr<MeshCurve> curve)
     std::size_t n_segs = std::max(1, static_cast<int>(std::round(total_weight)));
     auto delta_weight = total_weight / static_cast<double>(n_segs);
 
+    std::vector<double> params;
     for (std::size_t count = 1, num_pts = 1; num_pts < n_segs;) {
         auto pt1 = igrl.point(count - 1);
         auto pt2 = igrl.point(count);
@@ -70,7 +71,7 @@ SchemeCurvature::mesh_curve(Ptr<MeshCurve> curve)
             const auto dt = pt2.t - pt1.t;
             const auto dp = pt2.p - pt1.p;
             const auto t = pt1.t + dt / dp * (d - pt1.p);
-            curve->add_vertex(Ptr<MeshCurveVertex>::alloc(geom_curve, t));
+            params.push_back(t);
             num_pts++;
         }
         else {
@@ -79,6 +80,7 @@ SchemeCurvature::mesh_curve(Ptr<MeshCurve> curve)
                 break;
         }
     }
+    curve->add_vertices(params);
 
     build_curve_segments(curve);
 }
@@ -153,8 +153,7 @@ SchemeFan::mesh_surface(Ptr<MeshSurface> mesh_surface)
             auto t = t_lo + (t_hi - t_lo) * beta;
             auto p = arc.point(t);
             auto uv = gsurf.parameter_from_point(p);
-            auto v = Ptr<MeshSurfaceVertex>::alloc(gsurf, uv);
-            mesh_surface->add_vertex(v);
+            auto v = mesh_surface->add_vertex(uv);
             rings[k].emplace_back(v);
         }
         rings[k].push_back(end);
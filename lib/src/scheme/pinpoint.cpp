@@ -29,6 +29,7 @@ SchemePinpoint::mesh_curve(Ptr<MeshCurve> curve)
 
     // place mesh curve vertices
     std::sort(apos.begin(), apos.end());
+    std::vector<double> params;
     for (std::size_t count = 1, num_pts = 0; num_pts < apos.size() && count < igrl.num_points();) {
         auto pt1 = igrl.point(count - 1);
         auto pt2 = igrl.point(count);
@@ -37,13 +38,14 @@ SchemePinpoint::mesh_curve(Ptr<MeshCurve> curve)
             const auto dt = pt2.t - pt1.t;
             const auto dp = pt2.p - pt1.p;
             const auto t = pt1.t + dt / dp * (d - pt1.p);
-            curve->add_vertex(Ptr<MeshCurveVertex>::alloc(geom_curve, t));
+            params.push_back(t);
             num_pts++;
         }
         else {
             count++;
         }
     }
+    curve->add_vertices(params);
     if (curve->curve_vertices().empty())
         throw Exception("No points were generated by pinpoint scheme");
 
@@ -35,6 +35,7 @@ SchemeSize::mesh_curve(Ptr<MeshCurve> curve)
 
     int n_segs = std::round(geom_curve.length() / this->opts_.size);
     const double b = geom_curve.length() / static_cast<double>(n_segs);
+    std::vector<double> params;
     for (int count = 1, num_pts = 1; num_pts < n_segs;) {
         auto pt1 = igrl.point(count - 1);
         auto pt2 = igrl.point(count);
@@ -43,13 +44,14 @@ SchemeSize::mesh_curve(Ptr<MeshCurve> curve)
             const auto dt = pt2.t - pt1.t;
             const auto dp = pt2.p - pt1.p;
             const auto t = pt1.t + dt / dp * (d - pt1.p);
-            curve->add_vertex(Ptr<MeshCurveVertex>::alloc(geom_curve, t));
+            params.push_back(t);
             num_pts++;
         }
         else {
             count++;
         }
     }
+    curve->add_vertices(params);
 
     build_curve_segments(curve);
 }
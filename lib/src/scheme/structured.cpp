@@ -150,34 +150,47 @@ SchemeStructured::mesh_surface(Ptr<MeshSurface> surface)
         grid[0][nj - 1 - j] = v3[j];
 
     const auto & gsurf = surface->geom_surface();
+    // parameters of the boundary vertices, indexed the same way as `grid`
+    std::vector<UVParam> uv_i0(ni), uv_i1(ni), uv_0j(nj), uv_1j(nj);
+    for (auto i : make_range(ni)) {
+        uv_i0[i] = gsurf.parameter_from_point(grid[i][0]->point());
+        uv_i1[i] = gsurf.parameter_from_point(grid[i][nj - 1]->point());
+    }
+    for (auto j : make_range(nj)) {
+        uv_0j[j] = gsurf.parameter_from_point(grid[0][j]->point());
+        uv_1j[j] = gsurf.parameter_from_point(grid[ni - 1][j]->point());
+    }
+    const auto & uv00 = uv_i0[0];
+    const auto & uv10 = uv_i0[ni - 1];
+    const auto & uv01 = uv_i1[0];
+    const auto & uv11 = uv_i1[ni - 1];
+
+    std::vector<UVParam> uvs;
+    uvs.reserve((ni - 2) * (nj - 2));
     for (auto i : make_range(1, ni - 1)) {
         for (auto j : make_range(1, nj - 1)) {
-            auto uv00 = gsurf.parameter_from_point(grid[0][0]->point());
-            auto uv10 = gsurf.parameter_from_point(grid[ni - 1][0]->point());
-            auto uv01 = gsurf.parameter_from_point(grid[0][nj - 1]->point());
-            auto uv11 = gsurf.parameter_from_point(grid[ni - 1][nj - 1]->point());
-
             auto ri = static_cast<double>(i) / (ni - 1);
             auto rj = static_cast<double>(j) / (nj - 1);
 
-            auto uv_i0 = gsurf.parameter_from_point(grid[i][0]->point());
-            auto uv_i1 = gsurf.parameter_from_point(grid[i][nj - 1]->point());
-            auto uv_0j = gsurf.parameter_from_point(grid[0][j]->point());
-            auto uv_1j = gsurf.parameter_from_point(grid[ni - 1][j]->point());
-
-            auto u = (1 - rj) * uv_i0.u + rj * uv_i1.u + (1 - ri) * uv_0j.u + ri * uv_1j.u -
+            auto u = (1 - rj) * uv_i0[i].u + rj * uv_i1[i].u + (1 - ri) * uv_0j[j].u +
+                     ri * uv_1j[j].u -
                      ((1 - ri) * (1 - rj) * uv00.u + ri * (1 - rj) * uv10.u +
                       (1 - ri) * rj * uv01.u + ri * rj * uv11.u);
-            auto v = (1 - rj) * uv_i0.v + rj * uv_i1.v + (1 - ri) * uv_0j.v + ri * uv_1j.v -
+            auto v = (1 - rj) * uv_i0[i].v + rj * uv_i1[i].v + (1 - ri) * uv_0j[j].v +
+                     ri * uv_1j[j].v -
                      ((1 - ri) * (1 - rj) * uv00.v + ri * (1 - rj) * uv10.v +
                       (1 - ri) * rj * uv01.v + ri * rj * uv11.v);
-
-            auto vtx = Ptr<MeshSurfaceVertex>::alloc(gsurf, u, v);
-            surface->add_vertex(vtx);
-            grid[i][j] = static_ptr_cast<MeshVertexAbstract>(vtx);
+            uvs.emplace_back(u, v);
         }
     }
 
+    auto first = surface->surface_vertices().size();
+    surface->add_vertices(uvs);
+    auto vtxs = surface->surface_vertices().subspan(first);
+    for (auto i : make_range(1, ni - 1))
+        for (auto j : make_range(1, nj - 1))
+            grid[i][j] = static_ptr_cast<MeshVertexAbstract>(vtxs[(i - 1) * (nj - 2) + (j - 1)]);
+
     for (auto i : make_range(ni - 1)) {
         for (auto j : make_range(nj - 1)) {
             auto q = ccw_quadrangle(gsurf,
@@ -97,8 +97,7 @@ SchemeTriAnnular::mesh_surface(Ptr<MeshSurface> mesh_surface)
             Point p = p_in + (p_out - p_in) * alpha_r;
 
             auto uv = gsurf.parameter_from_point(p);
-            auto v = Ptr<MeshSurfaceVertex>::alloc(gsurf, uv);
-            mesh_surface->add_vertex(v);
+            auto v = mesh_surface->add_vertex(uv);
             rings[k].emplace_back(v);
         }
         rings[k].push_back(rings[k].front());
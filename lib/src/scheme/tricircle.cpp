@@ -65,8 +65,7 @@ SchemeTriCircle::mesh_surface(Ptr<MeshSurface> mesh_surface)
     auto geom_crv = gsurf.curves()[0];
     auto ctr_pnt = get_circle_center(geom_crv);
     auto uv_ctr = gsurf.parameter_from_point(ctr_pnt);
-    auto ctr = Ptr<MeshSurfaceVertex>::alloc(gsurf, uv_ctr);
-    mesh_surface->add_vertex(ctr);
+    auto ctr = mesh_surface->add_vertex(uv_ctr);
 
     // Collect all boundary vertices in order
     std::vector<Ptr<MeshVertexAbstract>> circum_verts;
@@ -137,8 +136,7 @@ SchemeTriCircle::mesh_surface(Ptr<MeshSurface> mesh_surface)
 
             auto p = ctr_pnt + (p_bnd - ctr_pnt) * alpha_r;
             auto uv = gsurf.parameter_from_point(p);
-            auto v = Ptr<MeshSurfaceVertex>::alloc(gsurf, uv);
-            mesh_surface->add_vertex(v);
+            auto v = mesh_surface->add_vertex(uv);
             rings[k].emplace_back(v);
         }
         // Close the ring
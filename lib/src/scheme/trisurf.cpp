@@ -15,18 +15,59 @@
 #include "krado/scheme2d.h"
 #include "krado/range.h"
 #include "krado/utils.h"
+#include "krado/parallel.h"
 #include "BRepMesh_IncrementalMesh.hxx"
 #include "BRep_Tool.hxx"
 #include "TopoDS.hxx"
 #include "Poly_Triangulation.hxx"
+#include <algorithm>
 #include <array>
 #include <map>
 #include <cassert>
+#include <cmath>
+#include <vector>
 
 namespace krado {
 
 static const std::string scheme_name = "trisurf";
 
+namespace {
+
+/// Triangulation of a face and the mesh vertices of its nodes
+struct SurfaceTriangulation {
+    Ptr<MeshSurface> surface;
+    Handle(Poly_Triangulation) triangulation;
+    /// Mesh vertices indexed by triangulation node (0-based)
+    std::vector<Ptr<MeshVertexAbstract>> vertices;
+};
+
+bool
+by_parameter(const std::pair<double, Ptr<MeshCurveVertex>> & a,
+             const std::pair<double, Ptr<MeshCurveVertex>> & b)
+{
+    return a.first < b.first;
+}
+
+/// Find a curve vertex with parameter `u` in a cache sorted by parameter
+///
+/// @param cache Curve vertices sorted by their parameter
+/// @param u Parameter to look for
+/// @return The curve vertex or a null pointer if there is none
+Ptr<MeshCurveVertex>
+find_curve_vertex(const std::vector<std::pair<double, Ptr<MeshCurveVertex>>> & cache, double u)
+{
+    const double eps = 1e-9;
+    auto it = std::lower_bound(cache.begin(),
+                               cache.end(),
+                               u - eps,
+                               [](const auto & entry, double val) { return entry.first < val; });
+    if (it != cache.end() && std::abs(it->first - u) < eps)
+        return it->second;
+    return {};
+}
+
+} // namespace
+
 SchemeTriSurf::SchemeTriSurf(Options options) :
     Scheme("trisurf"),
     Scheme3D(),
@@ -43,6 +84,7 @@ SchemeTriSurf::params_to_str()
     spars.push_back(fmt::format("linear_deflection={}", this->opts_.linear_deflection));
     spars.push_back(fmt::format("angular_deflection={}", this->opts_.angular_deflection));
     spars.push_back(fmt::format("is_relative={}", this->opts_.is_relative));
+    spars.push_back(fmt::format("in_parallel={}", this->opts_.in_parallel));
     return join(", ", spars);
 }
 
@@ -52,14 +94,20 @@ SchemeTriSurf::mesh_volume(Ptr<MeshVolume> volume)
     auto lin_deflection = this->opts_.linear_deflection;
     auto angl_deflection = this->opts_.angular_deflection;
     auto is_relative = this->opts_.is_relative;
+    auto in_parallel = this->opts_.in_parallel;
 
     auto shape = volume->geom_volume();
 
     Standard_Boolean is_rel = is_relative ? Standard_True : Standard_False;
-    BRepMesh_IncrementalMesh mesh(shape, lin_deflection, is_rel, angl_deflection, true);
+    Standard_Boolean is_par = in_parallel ? Standard_True : Standard_False;
+    BRepMesh_IncrementalMesh mesh(shape, lin_deflection, is_rel, angl_deflection, is_par);
 
-    std::map<Ptr<MeshCurve>, std::map<double, Ptr<MeshCurveVertex>>> curve_vertex_caches;
+    // Curve vertices sorted by their parameter, so that surfaces sharing a curve share its vertices
+    std::map<Ptr<MeshCurve>, std::vector<std::pair<double, Ptr<MeshCurveVertex>>>>
+        curve_vertex_caches;
+    std::vector<SurfaceTriangulation> surf_tris;
 
+    // Curves are shared among surfaces, so their vertices are created serially
     for (auto & srf : volume->surfaces()) {
         assert(!srf.is_null());
         const auto & geom_surface = srf->geom_surface();
@@ -70,8 +118,8 @@ SchemeTriSurf::mesh_volume(Ptr<MeshVolume> volume)
         if (triangulation.IsNull())
             continue;
 
-        srf->reserve_mem(triangulation->NbTriangles());
-        std::map<Standard_Integer, Ptr<MeshVertexAbstract>> vertices;
+        // triangulation nodes are numbered from 1
+        std::vector<Ptr<MeshVertexAbstract>> vertices(triangulation->NbNodes());
 
         for (auto & curve : srf->curves()) {
             const auto & geom_curve = curve->geom_curve();
@@ -87,58 +135,84 @@ SchemeTriSurf::mesh_volume(Ptr<MeshVolume> volume)
             auto & cache = it->second;
             if (inserted) {
                 for (auto & cv : curve->curve_vertices())
-                    cache.emplace(cv->parameter(), cv);
+                    cache.emplace_back(cv->parameter(), cv);
+                std::sort(cache.begin(), cache.end(), by_parameter);
             }
 
-            for (int j : make_range(polygon->NbNodes())) {
+            auto n_nodes = polygon->NbNodes();
+            std::vector<Standard_Integer> new_idxs;
+            std::vector<double> new_params;
+            for (int j : make_range(n_nodes)) {
                 auto idx = polygon->Node(j + 1);
-                Ptr<MeshVertexAbstract> vtx;
-                if (j == 0) {
-                    vtx = bnd_vtxs[0];
-                }
-                else if (j == polygon->NbNodes() - 1) {
-                    vtx = (bnd_vtxs.size() > 1) ? bnd_vtxs[1] : bnd_vtxs[0];
-                }
+                if (j == 0)
+                    vertices[idx - 1] = bnd_vtxs[0];
+                else if (j == n_nodes - 1)
+                    vertices[idx - 1] = (bnd_vtxs.size() > 1) ? bnd_vtxs[1] : bnd_vtxs[0];
                 else {
                     auto u = polygon->Parameter(j + 1);
-                    // Search for existing vertex with this parameter in cache
-                    auto it = cache.lower_bound(u - 1e-9);
-                    if (it != cache.end() && std::abs(it->first - u) < 1e-9) {
-                        vtx = it->second;
+                    auto cv = find_curve_vertex(cache, u);
+                    if (cv.is_null()) {
+                        new_idxs.push_back(idx);
+                        new_params.push_back(u);
                     }
+                    else
+                        vertices[idx - 1] = cv;
+                }
+            }
 
-                    if (vtx.is_null()) {
-                        auto cv = Ptr<MeshCurveVertex>::alloc(geom_curve, u);
-                        curve->add_vertex(cv);
-                        cache.emplace(u, cv);
-                        vtx = cv;
-                    }
+            if (!new_params.empty()) {
+                auto first = curve->curve_vertices().size();
+                curve->add_vertices(new_params);
+                auto new_vtxs = curve->curve_vertices().subspan(first);
+                for (std::size_t k = 0; k < new_vtxs.size(); ++k) {
+                    vertices[new_idxs[k] - 1] = new_vtxs[k];
+                    cache.emplace_back(new_params[k], new_vtxs[k]);
                 }
-                vertices.emplace(idx, vtx);
+                std::sort(cache.begin(), cache.end(), by_parameter);
             }
         }
 
-        for (auto i : make_range(triangulation->NbNodes())) {
-            auto idx = i + 1;
-            if (vertices.contains(idx))
-                continue;
+        surf_tris.push_back({ srf, triangulation, std::move(vertices) });
+    }
+
+    // Interior vertices and triangles belong to one surface only, so surfaces are independent
+    auto transfer = [&](std::size_t i) {
+        auto & st = surf_tris[i];
+        auto & srf = st.surface;
+        auto & triangulation = st.triangulation;
+        auto & vertices = st.vertices;
 
-            auto uv = triangulation->UVNode(idx);
-            auto vtx = Ptr<MeshSurfaceVertex>::alloc(geom_surface, uv.X(), uv.Y());
-            srf->add_vertex(vtx);
-            vertices.emplace(idx, vtx);
+        std::vector<Standard_Integer> int_idxs;
+        std::vector<UVParam> int_uvs;
+        for (auto j : make_range(triangulation->NbNodes())) {
+            if (!vertices[j].is_null())
+                continue;
+            auto uv = triangulation->UVNode(j + 1);
+            int_idxs.push_back(j);
+            int_uvs.emplace_back(uv.X(), uv.Y());
         }
+        auto first = srf->surface_vertices().size();
+        srf->add_vertices(int_uvs);
+        auto new_vtxs = srf->surface_vertices().subspan(first);
+        for (std::size_t k = 0; k < new_vtxs.size(); ++k)
+            vertices[int_idxs[k]] = new_vtxs[k];
 
-        for (auto i : make_range(triangulation->NbTriangles())) {
-            auto tri = triangulation->Triangle(i + 1);
+        srf->reserve_mem(triangulation->NbTriangles());
+        for (auto j : make_range(triangulation->NbTriangles())) {
+            auto tri = triangulation->Triangle(j + 1);
             Standard_Integer n1, n2, n3;
             tri.Get(n1, n2, n3);
-            std::array<Ptr<MeshVertexAbstract>, 3> t { vertices.at(n1),
-                                                       vertices.at(n2),
-                                                       vertices.at(n3) };
+            std::array<Ptr<MeshVertexAbstract>, 3> t { vertices[n1 - 1],
+                                                       vertices[n2 - 1],
+                                                       vertices[n3 - 1] };
             srf->add_triangle(t);
         }
-    }
+    };
+    if (in_parallel)
+        parallel_for(surf_tris.size(), transfer, 1);
+    else
+        for (std::size_t i = 0; i < surf_tris.size(); ++i)
+            transfer(i);
 }
 
 void
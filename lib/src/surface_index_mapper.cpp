@@ -52,9 +52,8 @@ SurfaceIndexMapper::surface_vertex(double x, double y)
     if (it == this->surf_idx_.end()) {
         const auto & geom_surface = surface_->geom_surface();
         auto uv = geom_surface.parameter_from_point(pt);
-        auto sv = Ptr<MeshSurfaceVertex>::alloc(geom_surface, uv);
+        auto sv = this->surface_->add_vertex(uv);
         this->surf_idx_.try_emplace(pt, sv);
-        this->surface_->add_vertex(sv);
         return sv;
     }
     else
@@ -71,9 +70,8 @@ SurfaceIndexMapper::curve_vertex(int curve_idx, double x, double y)
         auto curve = this->surface_->curves()[curve_idx];
         const auto & geom_curve = curve->geom_curve();
         auto u = geom_curve.parameter_from_point(pt);
-        auto cv = Ptr<MeshCurveVertex>::alloc(geom_curve, u);
+        auto cv = curve->add_vertex(u);
         this->curv_surf_idx_[curve_idx].try_emplace(pt, cv);
-        curve->add_vertex(cv);
 
         this->surf_idx_.try_emplace(pt, cv);
 
@@ -0,0 +1,91 @@
+// SPDX-FileCopyrightText: 2026 David Andrs <andrsd@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "krado/task_graph.h"
+#include "krado/thread_pool.h"
+#include "krado/exception.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+
+namespace krado {
+
+Index
+TaskGraph::add(std::function<void()> fn, const std::vector<Index> & deps)
+{
+    Index id = this->tasks_.size();
+    std::vector<Index> unique_deps(deps);
+    std::sort(unique_deps.begin(), unique_deps.end());
+    unique_deps.erase(std::unique(unique_deps.begin(), unique_deps.end()), unique_deps.end());
+    // tasks can only depend on tasks added before them, so the graph has no cycles
+    if (!unique_deps.empty() && unique_deps.back() >= id)
+        throw Exception("Task {} cannot depend on task {}", id, unique_deps.back());
+    for (auto d : unique_deps)
+        this->tasks_[d].successors.push_back(id);
+    this->tasks_.push_back({ std::move(fn), {}, Index(unique_deps.size()) });
+    return id;
+}
+
+std::size_t
+TaskGraph::size() const
+{
+    return this->tasks_.size();
+}
+
+void
+TaskGraph::run()
+{
+    const auto n = this->tasks_.size();
+    if (n == 0)
+        return;
+
+    auto & pool = ThreadPool::instance();
+    std::vector<std::atomic<Index>> pending(n);
+    for (std::size_t i = 0; i < n; ++i)
+        pending[i] = this->tasks_[i].n_deps;
+    std::size_t n_done = 0;
+    std::atomic<bool> failed { false };
+    std::exception_ptr error;
+    std::mutex mutex;
+    std::condition_variable cv;
+
+    std::function<void(Index)> execute = [&](Index t) {
+        try {
+            if (!failed.load())
+                this->tasks_[t].fn();
+        }
+        catch (...) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!error)
+                error = std::current_exception();
+            failed = true;
+        }
+        for (auto s : this->tasks_[t].successors)
+            if (pending[s].fetch_sub(1) == 1)
+                pool.submit([&execute, s] { execute(s); });
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (++n_done == n)
+            cv.notify_all();
+    };
+
+    for (Index i = 0; i < n; ++i)
+        if (this->tasks_[i].n_deps == 0)
+            pool.submit([&execute, i] { execute(i); });
+
+    // the calling thread helps with queued tasks until everything is done
+    while (true) {
+        if (pool.run_pending_task())
+            continue;
+        std::unique_lock<std::mutex> lock(mutex);
+        if (cv.wait_for(lock, std::chrono::microseconds(100), [&] { return n_done == n; }))
+            break;
+    }
+    if (error)
+        std::rethrow_exception(error);
+}
+
+} // namespace krado
@@ -0,0 +1,209 @@
+// SPDX-FileCopyrightText: 2026 David Andrs <andrsd@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "krado/thread_pool.h"
+#include "krado/log.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <exception>
+#include <memory>
+#include <string>
+
+namespace krado {
+
+namespace {
+
+unsigned int
+hardware_threads()
+{
+    auto n = std::thread::hardware_concurrency();
+    return n > 0 ? n : 1;
+}
+
+/// Number of threads requested by `KRADO_NUM_THREADS` (hardware threads if not set or invalid)
+unsigned int
+default_num_threads()
+{
+    const char * env = std::getenv("KRADO_NUM_THREADS");
+    if (env == nullptr || *env == '\0')
+        return hardware_threads();
+
+    char * end = nullptr;
+    auto n = std::strtol(env, &end, 10);
+    if (*end != '\0' || n < 1) {
+        Log::warn("Ignoring invalid KRADO_NUM_THREADS='{}'", env);
+        return hardware_threads();
+    }
+    return static_cast<unsigned int>(n);
+}
+
+/// State of one `ThreadPool::run` call, shared by the caller and the workers helping it
+struct Job {
+    Job(std::size_t n, const std::function<void(std::size_t)> & fn) : n(n), fn(fn) {}
+
+    /// Process items until there are none left
+    void
+    work()
+    {
+        std::size_t i;
+        while ((i = this->next.fetch_add(1)) < this->n) {
+            try {
+                if (!this->failed.load())
+                    this->fn(i);
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> lock(this->mutex);
+                if (!this->error)
+                    this->error = std::current_exception();
+                this->failed = true;
+            }
+            if (this->done.fetch_add(1) + 1 == this->n) {
+                std::lock_guard<std::mutex> lock(this->mutex);
+                this->cv.notify_all();
+            }
+        }
+    }
+
+    const std::size_t n;
+    const std::function<void(std::size_t)> & fn;
+    std::atomic<std::size_t> next { 0 };
+    std::atomic<std::size_t> done { 0 };
+    std::atomic<bool> failed { false };
+    std::exception_ptr error;
+    std::mutex mutex;
+    std::condition_variable cv;
+};
+
+} // namespace
+
+ThreadPool::ThreadPool(unsigned int n_threads)
+{
+    start(n_threads);
+}
+
+ThreadPool::~ThreadPool()
+{
+    stop();
+}
+
+unsigned int
+ThreadPool::num_threads() const
+{
+    return this->workers_.size() + 1;
+}
+
+void
+ThreadPool::resize(unsigned int n_threads)
+{
+    stop();
+    start(n_threads);
+}
+
+void
+ThreadPool::run(std::size_t n, const std::function<void(std::size_t)> & fn)
+{
+    if (n == 0)
+        return;
+    if (n == 1 || this->workers_.empty()) {
+        for (std::size_t i = 0; i < n; ++i)
+            fn(i);
+        return;
+    }
+
+    // helpers hold on to the job, they may start after the caller is done with it
+    auto job = std::make_shared<Job>(n, fn);
+    auto n_helpers = std::min<std::size_t>(n - 1, this->workers_.size());
+    for (std::size_t i = 0; i < n_helpers; ++i)
+        submit([job] { job->work(); });
+    job->work();
+
+    std::unique_lock<std::mutex> lock(job->mutex);
+    job->cv.wait(lock, [&] { return job->done.load() == n; });
+    if (job->error)
+        std::rethrow_exception(job->error);
+}
+
+void
+ThreadPool::submit(std::function<void()> task)
+{
+    {
+        std::lock_guard<std::mutex> lock(this->mutex_);
+        this->tasks_.push_back(std::move(task));
+    }
+    this->cv_.notify_one();
+}
+
+bool
+ThreadPool::run_pending_task()
+{
+    std::function<void()> task;
+    {
+        std::lock_guard<std::mutex> lock(this->mutex_);
+        if (this->tasks_.empty())
+            return false;
+        task = std::move(this->tasks_.front());
+        this->tasks_.pop_front();
+    }
+    task();
+    return true;
+}
+
+ThreadPool &
+ThreadPool::instance()
+{
+    static ThreadPool pool(default_num_threads());
+    return pool;
+}
+
+void
+ThreadPool::start(unsigned int n_threads)
+{
+    this->stopping_ = false;
+    for (unsigned int i = 1; i < std::max(n_threads, 1u); ++i)
+        this->workers_.emplace_back(&ThreadPool::worker_loop, this);
+}
+
+void
+ThreadPool::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(this->mutex_);
+        this->stopping_ = true;
+    }
+    this->cv_.notify_all();
+    for (auto & w : this->workers_)
+        w.join();
+    this->workers_.clear();
+}
+
+void
+ThreadPool::worker_loop()
+{
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(this->mutex_);
+            this->cv_.wait(lock, [this] { return this->stopping_ || !this->tasks_.empty(); });
+            if (this->tasks_.empty())
+                return;
+            task = std::move(this->tasks_.front());
+            this->tasks_.pop_front();
+        }
+        task();
+    }
+}
+
+unsigned int
+num_threads()
+{
+    return ThreadPool::instance().num_threads();
+}
+
+void
+set_num_threads(unsigned int n)
+{
+    ThreadPool::instance().resize(n == 0 ? hardware_threads() : n);
+}
+
+} // namespace krado
@@ -97,6 +97,12 @@ Trsf::operator*(const Point & other) const
     return Point(result[0] / result[3], result[1] / result[3], result[2] / result[3]);
 }
 
+double
+Trsf::operator()(int row, int col) const
+{
+    return this->mat_[row][col];
+}
+
 Trsf
 Trsf::scaled(double factor)
 {
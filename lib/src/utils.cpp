@@ -126,6 +126,21 @@ human_time(double time)
     return join(" ", strs);
 }
 
+std::string
+human_bytes(std::size_t bytes)
+{
+    const char * units[] = { "B", "KiB", "MiB", "GiB", "TiB" };
+    if (bytes < 1024)
+        return fmt::format("{}B", bytes);
+    double value = bytes;
+    std::size_t unit = 0;
+    while (value >= 1024. && unit < std::size(units) - 1) {
+        value /= 1024.;
+        ++unit;
+    }
+    return fmt::format("{:.2f}{}", value, units[unit]);
+}
+
 [[nodiscard]]
 std::vector<Index>
 get_face_connect(const Element & elem, u8 side)
@@ -31,6 +31,7 @@
 #include "krado/cylinder.h"
 #include "krado/helix.h"
 #include "krado/iges_file.h"
+#include "krado/kmesh_file.h"
 #include "krado/inscribed_polygon.h"
 #include "krado/sphere.h"
 #include "krado/spline.h"
@@ -42,6 +43,7 @@
 #include "krado/ops.h"
 #include "krado/step_file.h"
 #include "krado/geom_model.h"
+#include "krado/gmsh_file.h"
 #include "krado/geom_shape.h"
 #include "krado/geom_shell.h"
 #include "krado/geom_vertex.h"
@@ -49,6 +51,7 @@
 #include "krado/geom_surface.h"
 #include "krado/geom_volume.h"
 #include "krado/mesh.h"
+#include "krado/mesh_builder.h"
 #include "krado/mesh_element.h"
 #include "krado/mesh_vertex.h"
 #include "krado/mesh_vertex_abstract.h"
@@ -72,6 +75,7 @@
 #include "krado/log.h"
 #include "krado/quality_measures.h"
 #include "krado/timer.h"
+#include "krado/thread_pool.h"
 #include <fmt/core.h>
 
 namespace py = pybind11;
@@ -139,10 +143,45 @@ auto make_span_view = [](auto & self, auto span_getter) {
     return py::array_t<ElementType>({ s.size() }, { sizeof(ElementType) }, s.data(), base);
 };
 
+ExodusIIFile::Options
+exodusii_options(const py::kwargs & kwargs)
+{
+    ExodusIIFile::Options opts;
+    if (kwargs.contains("format")) {
+        auto format = kwargs["format"].cast<std::string>();
+        if (format == "netcdf3")
+            opts.format = ExodusIIFile::Format::NETCDF3;
+        else if (format == "netcdf4")
+            opts.format = ExodusIIFile::Format::NETCDF4;
+        else
+            throw Exception("Unsupported file format '{}'", format);
+    }
+    if (kwargs.contains("compression")) {
+        auto compression = kwargs["compression"].cast<std::string>();
+        if (compression == "none")
+            opts.compression = ExodusIIFile::Compression::NONE;
+        else if (compression == "zlib")
+            opts.compression = ExodusIIFile::Compression::ZLIB;
+        else if (compression == "szip")
+            opts.compression = ExodusIIFile::Compression::SZIP;
+        else
+            throw Exception("Unsupported compression '{}'", compression);
+    }
+    if (kwargs.contains("compression_level"))
+        opts.compression_level = kwargs["compression_level"].cast<int>();
+    if (kwargs.contains("shuffle"))
+        opts.shuffle = kwargs["shuffle"].cast<bool>();
+    if (kwargs.contains("int64"))
+        opts.int64 = kwargs["int64"].cast<bool>();
+    return opts;
+}
+
 PYBIND11_MODULE(krado, m)
 {
     m.doc() = "pybind11 plugin for krado";
     m.attr("__version__") = KRADO_VERSION;
+    m.def("num_threads", &num_threads);
+    m.def("set_num_threads", &set_num_threads, py::arg("n"));
 
     // clang-format off
 
@@ -267,6 +306,17 @@ PYBIND11_MODULE(krado, m)
         .value("HEX8", ElementType::HEX8)
         .export_values();
 
+    py::enum_<Ordering>(m, "Ordering")
+        .value("RCM", Ordering::RCM)
+        .value("HILBERT", Ordering::HILBERT)
+        .value("MORTON", Ordering::MORTON)
+        .export_values();
+
+    py::enum_<HasseDiagram::Relation>(m, "HasseRelation", py::arithmetic())
+        .value("DOWNWARD", HasseDiagram::DOWNWARD)
+        .value("UPWARD", HasseDiagram::UPWARD)
+        .export_values();
+
     py::class_<Axis1>(m, "Axis1")
         .def(py::init<const Point &, const Vector &>())
         .def("location", &Axis1::location)
@@ -524,6 +574,8 @@ PYBIND11_MODULE(krado, m)
         .def("mesh_curve", py::overload_cast<ShapeID>(&GeomModel::mesh_curve))
         .def("mesh_surface", py::overload_cast<ShapeID>(&GeomModel::mesh_surface))
         .def("mesh_volume", py::overload_cast<ShapeID>(&GeomModel::mesh_volume))
+        .def("mesh_all", &GeomModel::mesh_all, py::arg("parallel") = true)
+        .def("set_mesh_cache", &GeomModel::set_mesh_cache)
         .def("set_block_name", &GeomModel::set_block_name)
         .def("block_name", &GeomModel::block_name)
         .def("set_side_set_name", &GeomModel::set_side_set_name)
@@ -677,14 +729,14 @@ PYBIND11_MODULE(krado, m)
                  auto span = self.points();
                  return std::vector<Point>(span.begin(), span.end());
              })
-        .def("point", &Mesh::point, py::return_value_policy::reference)
+        .def("point", &Mesh::point)
         .def("elements",
              [](const Mesh & self) {
                  auto span = self.elements();
                  return std::vector<Element>(span.begin(), span.end());
              })
         .def("num_elements", &Mesh::num_elements)
-        .def("element", &Mesh::element, py::return_value_policy::reference)
+        .def("element", [](const Mesh & self, Index idx) { return Element(self.element(idx)); })
         .def("scale", static_cast<Mesh &(Mesh::*)(double)>(&Mesh::scale))
         .def("scaled", static_cast<Ptr<Mesh> (Mesh::*)(double) const>(&Mesh::scaled))
         .def("scale", static_cast<Mesh &(Mesh::*)(double, double, double)>(&Mesh::scale),
@@ -698,9 +750,13 @@ PYBIND11_MODULE(krado, m)
         .def("mirrored", &Mesh::mirrored)
         .def("add", &Mesh::add)
         .def("remove_duplicate_points", &Mesh::remove_duplicate_points)
+        .def("renumber",
+             [](Mesh & self, const std::vector<Index> & node_ids, const std::vector<Index> & elem_ids) -> Mesh & {
+                 return self.renumber(node_ids, elem_ids);
+             })
         .def("duplicate", &Mesh::duplicate)
 
-        .def("set_cell_set", &Mesh::set_cell_set)
+        .def("set_cell_set", py::overload_cast<Marker, const std::vector<Index> &>(&Mesh::set_cell_set))
         .def("set_cell_set_name", &Mesh::set_cell_set_name)
         .def("cell_set_name", &Mesh::cell_set_name)
         .def("cell_set_ids", &Mesh::cell_set_ids)
@@ -711,7 +767,7 @@ PYBIND11_MODULE(krado, m)
              })
         .def("remove_cell_sets", &Mesh::remove_cell_sets)
 
-        .def("set_side_set", &Mesh::set_side_set)
+        .def("set_side_set", py::overload_cast<Marker, const std::vector<SideEntry> &>(&Mesh::set_side_set))
         .def("set_side_set_name", &Mesh::set_side_set_name)
         .def("side_set_name", &Mesh::side_set_name)
         .def("side_set_ids", &Mesh::side_set_ids)
@@ -722,7 +778,7 @@ PYBIND11_MODULE(krado, m)
              })
         .def("remove_side_sets", &Mesh::remove_side_sets)
 
-        .def("set_node_set", &Mesh::set_node_set)
+        .def("set_node_set", py::overload_cast<Marker, const std::vector<Index> &>(&Mesh::set_node_set))
         .def("set_node_set_name", &Mesh::set_node_set_name)
         .def("node_set_name", &Mesh::node_set_name)
         .def("node_set_ids", &Mesh::node_set_ids)
@@ -745,9 +801,12 @@ PYBIND11_MODULE(krado, m)
                  return std::vector<HasseIndex>(span.begin(), span.end());
              })
         .def("element_type", &Mesh::element_type)
-        .def("set_up", &Mesh::set_up)
+        .def("set_up",
+             [](Mesh & self, unsigned int relations) { self.set_up(relations); },
+             py::arg("relations") = (HasseDiagram::DOWNWARD | HasseDiagram::UPWARD).as_uint())
         .def("boundary_edges", &Mesh::boundary_edges)
         .def("boundary_faces", &Mesh::boundary_faces)
+        .def("boundary_sides", [](const Mesh & self) { return boundary_sides(self); })
         .def("compute_centroid", py::overload_cast<HasseIndex>(&Mesh::compute_centroid, py::const_))
         .def("outward_normal", &Mesh::outward_normal)
 
@@ -757,6 +816,23 @@ PYBIND11_MODULE(krado, m)
         })
     ;
 
+    py::class_<MeshBuilder>(m, "MeshBuilder")
+        .def(py::init<>())
+        .def("reserve", &MeshBuilder::reserve, py::arg("n_points"), py::arg("n_elements"), py::arg("n_indices") = 0)
+        .def("num_points", &MeshBuilder::num_points)
+        .def("num_elements", &MeshBuilder::num_elements)
+        .def("add", [](MeshBuilder & self, Ptr<Mesh> mesh) { self.add(*mesh); })
+        .def("add_point", &MeshBuilder::add_point)
+        .def("add_element", &MeshBuilder::add_element)
+        .def("add_to_cell_set", &MeshBuilder::add_to_cell_set)
+        .def("add_to_side_set", &MeshBuilder::add_to_side_set)
+        .def("add_to_node_set", &MeshBuilder::add_to_node_set)
+        .def("set_cell_set_name", &MeshBuilder::set_cell_set_name)
+        .def("set_side_set_name", &MeshBuilder::set_side_set_name)
+        .def("set_node_set_name", &MeshBuilder::set_node_set_name)
+        .def("build", &MeshBuilder::build)
+    ;
+
     py::class_<Meshable, Ptr<Meshable>>(m, "Meshable")
         .def(py::init<>())
         .def("is_meshed", &Meshable::is_meshed)
@@ -782,6 +858,7 @@ PYBIND11_MODULE(krado, m)
 
     py::class_<MeshVertexAbstract, PyMeshVertexAbstract, Ptr<MeshVertexAbstract>>(m, "MeshVertexAbstract")
         .def("point", &MeshVertexAbstract::point)
+        .def("num", &MeshVertexAbstract::num)
     ;
 
     py::class_<MeshVertex, MeshVertexAbstract, Ptr<MeshVertex>>(m, "MeshVertex")
@@ -934,6 +1011,8 @@ PYBIND11_MODULE(krado, m)
                          opts.angular_deflection = kwargs["angular_deflection"].cast<double>();
                      if (kwargs.contains("is_relative"))
                          opts.is_relative = kwargs["is_relative"].cast<bool>();
+                     if (kwargs.contains("in_parallel"))
+                         opts.in_parallel = kwargs["in_parallel"].cast<bool>();
                      self.set_scheme<SchemeTriSurf>(opts);
                  }
              },
@@ -942,12 +1021,32 @@ PYBIND11_MODULE(krado, m)
     ;
 
     py::class_<ExodusIIFile>(m, "ExodusIIFile")
-        .def(py::init<const std::filesystem::path &>())
+        .def(py::init([](const std::filesystem::path & file_name, py::kwargs kwargs) {
+            return std::make_unique<ExodusIIFile>(file_name, exodusii_options(kwargs));
+        }))
         .def("read", &ExodusIIFile::read)
         .def("write", py::overload_cast<Ptr<const Mesh>>(&ExodusIIFile::write))
         .def("write", py::overload_cast<const GeomModel &>(&ExodusIIFile::write))
     ;
 
+    py::class_<GmshFile>(m, "GmshFile")
+        .def(py::init([](const std::filesystem::path & file_name, bool binary) {
+                 GmshFile::Options opts;
+                 opts.binary = binary;
+                 return std::make_unique<GmshFile>(file_name, opts);
+             }),
+             py::arg("file_name"),
+             py::arg("binary") = true)
+        .def("read", &GmshFile::read)
+        .def("write", &GmshFile::write)
+    ;
+
+    py::class_<KMeshFile>(m, "KMeshFile")
+        .def(py::init<const std::filesystem::path &>())
+        .def("read", &KMeshFile::read)
+        .def("write", &KMeshFile::write)
+    ;
+
     py::class_<DAGMCFile>(m, "DAGMCFile")
         .def(py::init<const std::filesystem::path &>())
         .def("write", &DAGMCFile::write)
@@ -1024,9 +1123,23 @@ PYBIND11_MODULE(krado, m)
         }
         return py_vols;
     });
+    m.def("node_bandwidth", [](const Mesh & mesh) { return node_bandwidth(mesh); });
+    m.def("reorder", [](Ptr<Mesh> mesh, Ordering ordering) -> Ptr<Mesh> {
+            reorder(*mesh, ordering);
+            return mesh;
+    }, py::arg("mesh"), py::arg("ordering") = Ordering::RCM);
     m.def("combine", [](const std::vector<Ptr<Mesh>>& parts) -> Ptr<Mesh> {
             return combine(parts);
     });
+    m.def("combine", [](const std::vector<Ptr<Mesh>>& parts, double merge_tolerance) -> Ptr<Mesh> {
+            return combine(parts, merge_tolerance);
+    }, py::arg("parts"), py::arg("merge_tolerance"));
+    m.def("instantiate", [](Ptr<const Mesh> prototype, const std::vector<Trsf> & placements, double merge_tolerance) -> Ptr<Mesh> {
+            return instantiate(prototype, placements, merge_tolerance);
+    }, py::arg("prototype"), py::arg("placements"), py::arg("merge_tolerance"));
+    m.def("instantiate", [](Ptr<const Mesh> prototype, const Pattern & pattern, double merge_tolerance) -> Ptr<Mesh> {
+            return instantiate(prototype, pattern, merge_tolerance);
+    }, py::arg("prototype"), py::arg("pattern"), py::arg("merge_tolerance"));
 
     m.def("fuse", py::overload_cast<const GeomShape &, const GeomShape &, bool>(&fuse),
         py::arg("shape"), py::arg("tool"), py::arg("simplify") = true);
@@ -1071,7 +1184,25 @@ PYBIND11_MODULE(krado, m)
     m.def("sew", &sew,
          py::arg("faces"), py::arg("tolerance") = 1e-6);
 
-    m.def("smooth", &smooth, py::arg("surface"), py::arg("iterations") = 1);
+    m.def("smooth", [](Ptr<MeshSurface> surface, int iterations, py::kwargs kwargs) {
+            SmoothingOptions opts;
+            opts.iterations = iterations;
+            if (kwargs.contains("method")) {
+                auto method = kwargs["method"].cast<std::string>();
+                if (method == "laplace")
+                    opts.method = SmoothingMethod::LAPLACE;
+                else if (method == "optimize")
+                    opts.method = SmoothingMethod::OPTIMIZE;
+                else
+                    throw Exception("Unsupported smoothing method '{}'", method);
+            }
+            if (kwargs.contains("metric"))
+                opts.metric = kwargs["metric"].cast<qm::Metric>();
+            if (kwargs.contains("tolerance"))
+                opts.tolerance = kwargs["tolerance"].cast<double>();
+            smooth(surface, opts);
+        },
+        py::arg("surface"), py::arg("iterations") = 1);
 
     // tetrahedralize.h
 
@@ -1079,7 +1210,14 @@ PYBIND11_MODULE(krado, m)
 
     // io.h
 
-    m.def("export_mesh", &IO::export_mesh, py::arg("mesh"), py::arg("file_name"));
+    m.def("export_mesh",
+          [](Ptr<const Mesh> mesh, const std::filesystem::path & file_name, py::kwargs kwargs) {
+              if (kwargs.empty())
+                  IO::export_mesh(mesh, file_name);
+              else
+                  IO::export_mesh(mesh, file_name, exodusii_options(kwargs));
+          },
+          py::arg("mesh"), py::arg("file_name"));
     m.def("import_mesh", &IO::import_mesh, py::arg("file_name"));
     m.def("export_geometry", [](const py::object & shapes_or_shape, const std::filesystem::path & file_name) {
             std::vector<GeomShape> shapes;
@@ -18,7 +18,9 @@ __all__ = [
     "GeomSurface",
     "GeomVertex",
     "GeomVolume",
+    "GmshFile",
     "HexagonalPattern",
+    "KMeshFile",
     "LinearPattern",
     "Mesh",
     "MeshElement",
@@ -2,6 +2,7 @@ import math
 import os
 
 import krado
+import pytest
 
 root_dir = os.path.normpath(os.path.join(__file__, "..", "..", ".."))
 assets_dir = os.path.join(root_dir, "test", "assets")
@@ -32,3 +33,47 @@ def test_export_geom_list(tmp_path):
     box2 = krado.Box(krado.Point(5, 0, 0), krado.Point(6, 1, 1))
     krado.export_geometry([box1, box2], tmp_path / "boxes.step")
     krado.export_geometry([box1, box2], tmp_path / "boxes.iges")
+
+
+def test_export_mesh_compressed(tmp_path):
+    file_name = os.path.join(assets_dir, "mesh", "square-half-tri.e")
+    mesh = krado.import_mesh(file_name)
+    out_file = tmp_path / "compressed.exo"
+    try:
+        krado.export_mesh(mesh, out_file, format="netcdf4", compression="zlib", compression_level=6, int64=True)
+    except RuntimeError as e:
+        if "not supported by this build" in str(e):
+            pytest.skip(str(e))
+        raise
+    mesh_rd = krado.import_mesh(out_file)
+    assert mesh_rd.num_elements() == mesh.num_elements()
+
+
+def test_export_import_kmesh(tmp_path):
+    file_name = os.path.join(assets_dir, "mesh", "square-half-tri.e")
+    mesh = krado.import_mesh(file_name)
+    out_file = tmp_path / "mesh.kmesh"
+    krado.export_mesh(mesh, out_file)
+    mesh_rd = krado.import_mesh(out_file)
+    assert mesh_rd.num_points() == mesh.num_points()
+    assert mesh_rd.num_elements() == mesh.num_elements()
+    assert mesh_rd.cell_set_ids() == mesh.cell_set_ids()
+
+
+def test_export_import_gmsh(tmp_path):
+    file_name = os.path.join(assets_dir, "mesh", "square-half-tri.e")
+    mesh = krado.import_mesh(file_name)
+    out_file = tmp_path / "mesh.msh"
+    krado.export_mesh(mesh, out_file)
+    mesh_rd = krado.import_mesh(out_file)
+    assert mesh_rd.num_points() == mesh.num_points()
+    assert mesh_rd.num_elements() == mesh.num_elements()
+
+
+def test_export_exodusii_options_other_format(tmp_path):
+    file_name = os.path.join(assets_dir, "mesh", "square-half-tri.e")
+    mesh = krado.import_mesh(file_name)
+    with pytest.raises(RuntimeError):
+        krado.export_mesh(mesh, tmp_path / "mesh.msh", int64=True)
+    with pytest.raises(RuntimeError):
+        krado.export_mesh(mesh, tmp_path / "mesh.kmesh", format="netcdf4")
@@ -169,6 +169,20 @@ def test_mesh_span_wrappers():
     assert isinstance(cone_0, list)
 
 
+def test_mesh_set_up_relations():
+    file_name = os.path.join(assets_dir, "mesh", "square-half-tri.e")
+    mesh = krado.import_mesh(file_name)
+    mesh.set_up(relations=krado.HasseRelation.DOWNWARD)
+    # cells are numbered first, a triangle has 3 edges
+    cone_0 = mesh.cone(krado.HasseIndex(0))
+    assert len(cone_0) == 3
+
+    mesh.set_up(relations=krado.HasseRelation.DOWNWARD | krado.HasseRelation.UPWARD)
+    # vertices follow the cells
+    support_2 = mesh.support(krado.HasseIndex(2))
+    assert len(support_2) > 0
+
+
 def test_mesh_remap_block_ids_merge():
     pts = [
         krado.Point(0.0, 0.0),
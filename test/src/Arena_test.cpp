@@ -0,0 +1,72 @@
+#include "gmock/gmock.h"
+#include "krado/arena.h"
+#include <thread>
+#include <vector>
+
+using namespace krado;
+
+namespace {
+
+class Counted {
+public:
+    Counted(int value, int * n_dtors) : value(value), n_dtors(n_dtors) {}
+    ~Counted() { ++*this->n_dtors; }
+
+    int value;
+
+private:
+    int * n_dtors;
+};
+
+} // namespace
+
+TEST(ArenaTest, alloc)
+{
+    int n_dtors = 0;
+    {
+        Arena<Counted, 4> arena;
+        std::vector<Ptr<Counted>> objs;
+        for (int i = 0; i < 10; ++i)
+            objs.push_back(arena.alloc(i, &n_dtors));
+        for (int i = 0; i < 10; ++i) {
+            EXPECT_EQ(objs[i]->value, i);
+            EXPECT_EQ(objs[i].ref_count(), 1);
+        }
+        objs.resize(5);
+        EXPECT_EQ(n_dtors, 5);
+    }
+    EXPECT_EQ(n_dtors, 10);
+}
+
+TEST(ArenaTest, outlive_arena)
+{
+    int n_dtors = 0;
+    Ptr<Counted> obj;
+    {
+        Arena<Counted, 4> arena;
+        obj = arena.alloc(3, &n_dtors);
+        auto tmp = arena.alloc(4, &n_dtors);
+    }
+    EXPECT_EQ(n_dtors, 1);
+    EXPECT_EQ(obj->value, 3);
+    obj = nullptr;
+    EXPECT_EQ(n_dtors, 2);
+}
+
+TEST(ArenaTest, release_from_threads)
+{
+    int n_dtors[4] = { 0, 0, 0, 0 };
+    std::vector<std::vector<Ptr<Counted>>> objs(4);
+    {
+        Arena<Counted, 8> arena;
+        for (int i = 0; i < 1000; ++i)
+            objs[i % 4].push_back(arena.alloc(i, &n_dtors[i % 4]));
+    }
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+        threads.emplace_back([&objs, t] { objs[t].clear(); });
+    for (auto & th : threads)
+        th.join();
+    for (int t = 0; t < 4; ++t)
+        EXPECT_EQ(n_dtors[t], 250);
+}
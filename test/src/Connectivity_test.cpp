@@ -0,0 +1,134 @@
+#include "gmock/gmock.h"
+#include "krado/connectivity.h"
+#include "krado/exception.h"
+
+using namespace krado;
+using namespace testing;
+
+namespace {
+
+std::vector<Element>
+mixed_elements()
+{
+    return { Element::Tri3({ 0, 1, 2 }),
+             Element::Quad4({ 1, 3, 4, 2 }),
+             Element::Line2({ 4, 5 }),
+             Element::Hex8({ 0, 1, 2, 3, 4, 5, 6, 7 }) };
+}
+
+} // namespace
+
+TEST(ConnectivityTest, ctor)
+{
+    auto elems = mixed_elements();
+    Connectivity connect(elems);
+    ASSERT_EQ(connect.size(), 4);
+    EXPECT_THAT(connect.offsets(), ElementsAre(0, 3, 7, 9, 17));
+    EXPECT_EQ(connect.ids().size(), 17);
+    for (std::size_t i = 0; i < elems.size(); ++i) {
+        EXPECT_EQ(connect[i].type(), elems[i].type());
+        EXPECT_THAT(connect[i].indices(), ElementsAreArray(elems[i].indices()));
+        EXPECT_EQ(connect[i], elems[i]);
+    }
+    EXPECT_EQ(connect[1].num_vertices(), 4);
+    EXPECT_EQ(connect[1].index(3), 2);
+    EXPECT_THROW((void) connect[1].index(4), Exception);
+    EXPECT_THROW((void) connect.at(4), std::out_of_range);
+}
+
+TEST(ConnectivityTest, ctor_csr)
+{
+    std::vector<ElementType> types = { ElementType::TRI3, ElementType::LINE2 };
+    std::vector<Index> offsets = { 0, 3, 5 };
+    std::vector<Index> ids = { 0, 1, 2, 2, 3 };
+    Connectivity connect(types, offsets, ids);
+    ASSERT_EQ(connect.size(), 2);
+    EXPECT_EQ(connect[0], Element::Tri3({ 0, 1, 2 }));
+    EXPECT_EQ(connect[1], Element::Line2({ 2, 3 }));
+
+    EXPECT_THROW(Connectivity(types, { 0, 3 }, ids), Exception);
+    EXPECT_THROW(Connectivity(types, { 0, 3, 4 }, ids), Exception);
+}
+
+TEST(ConnectivityTest, push_back)
+{
+    Connectivity connect;
+    EXPECT_TRUE(connect.empty());
+    connect.push_back(Element::Tri3({ 0, 1, 2 }));
+    connect.push_back(Element::Line2({ 3, 4 }));
+    ASSERT_EQ(connect.size(), 2);
+    EXPECT_EQ(connect[0], Element::Tri3({ 0, 1, 2 }));
+    EXPECT_EQ(connect[1], Element::Line2({ 3, 4 }));
+
+    connect.clear();
+    EXPECT_TRUE(connect.empty());
+    EXPECT_THAT(connect.offsets(), ElementsAre(0));
+}
+
+TEST(ConnectivityTest, append)
+{
+    Connectivity connect(std::vector<Element> { Element::Tri3({ 0, 1, 2 }) });
+    Connectivity other(mixed_elements());
+    connect.append(other, 10);
+    ASSERT_EQ(connect.size(), 5);
+    EXPECT_EQ(connect[0], Element::Tri3({ 0, 1, 2 }));
+    EXPECT_EQ(connect[1], Element::Tri3({ 10, 11, 12 }));
+    EXPECT_EQ(connect[2], Element::Quad4({ 11, 13, 14, 12 }));
+    EXPECT_EQ(connect[3], Element::Line2({ 14, 15 }));
+    EXPECT_EQ(connect[4], Element::Hex8({ 10, 11, 12, 13, 14, 15, 16, 17 }));
+    EXPECT_THAT(connect.offsets(), ElementsAre(0, 3, 6, 10, 12, 20));
+}
+
+TEST(ConnectivityTest, shift_remap)
+{
+    Connectivity connect(mixed_elements());
+    connect.shift(1, 3, 100);
+    EXPECT_EQ(connect[0], Element::Tri3({ 0, 1, 2 }));
+    EXPECT_EQ(connect[1], Element::Quad4({ 101, 103, 104, 102 }));
+    EXPECT_EQ(connect[2], Element::Line2({ 104, 105 }));
+    EXPECT_EQ(connect[3], Element::Hex8({ 0, 1, 2, 3, 4, 5, 6, 7 }));
+
+    Connectivity tri(std::vector<Element> { Element::Tri3({ 0, 1, 2 }) });
+    std::vector<Index> new_ids = { 2, 0, 1 };
+    tri.remap(new_ids);
+    EXPECT_EQ(tri[0], Element::Tri3({ 2, 0, 1 }));
+}
+
+TEST(ConnectivityTest, permute)
+{
+    Connectivity connect(mixed_elements());
+    std::vector<Index> new_ids = { 2, 0, 3, 1 };
+    connect.permute(new_ids);
+    ASSERT_EQ(connect.size(), 4);
+    EXPECT_EQ(connect[0], Element::Quad4({ 1, 3, 4, 2 }));
+    EXPECT_EQ(connect[1], Element::Hex8({ 0, 1, 2, 3, 4, 5, 6, 7 }));
+    EXPECT_EQ(connect[2], Element::Tri3({ 0, 1, 2 }));
+    EXPECT_EQ(connect[3], Element::Line2({ 4, 5 }));
+    EXPECT_THAT(connect.offsets(), ElementsAre(0, 4, 12, 15, 17));
+
+    std::vector<Index> wrong_size = { 0, 1 };
+    EXPECT_THROW(connect.permute(wrong_size), Exception);
+}
+
+TEST(ConnectivityTest, view)
+{
+    auto elems = mixed_elements();
+    Connectivity connect(elems);
+    auto view = connect.view();
+    ASSERT_EQ(view.size(), 4);
+    std::vector<Element> copy(view.begin(), view.end());
+    EXPECT_EQ(copy, elems);
+    std::size_t n = 0;
+    for (const auto & el : view)
+        n += el.num_vertices();
+    EXPECT_EQ(n, 17);
+}
+
+TEST(ConnectivityTest, memory_usage)
+{
+    std::vector<Element> tris(1000, Element::Tri3({ 0, 1, 2 }));
+    Connectivity connect(tris);
+    // type, offset and 3 vertex indices per triangle
+    EXPECT_LE(connect.memory_usage(), 1000 * (1 + 4 + 12) + 4);
+    EXPECT_LT(connect.memory_usage(), tris.size() * sizeof(Element));
+}
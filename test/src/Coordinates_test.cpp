@@ -0,0 +1,117 @@
+#include "gmock/gmock.h"
+#include "krado/coordinates.h"
+#include "krado/bounding_box_3d.h"
+#include "krado/transform.h"
+#include "krado/exception.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace krado;
+using namespace testing;
+
+TEST(CoordinatesTest, ctor_points)
+{
+    std::vector<Point> pts = { Point(1, 2, 3), Point(4, 5, 6) };
+    Coordinates coords(pts);
+    ASSERT_EQ(coords.size(), 2);
+    EXPECT_THAT(coords.x(), ElementsAre(1, 4));
+    EXPECT_THAT(coords.y(), ElementsAre(2, 5));
+    EXPECT_THAT(coords.z(), ElementsAre(3, 6));
+    EXPECT_THAT(coords[1], Point(4, 5, 6));
+    EXPECT_THROW((void) coords.at(2), std::out_of_range);
+}
+
+TEST(CoordinatesTest, ctor_arrays)
+{
+    Coordinates coords({ 1, 2 }, { 3, 4 }, { 5, 6 });
+    ASSERT_EQ(coords.size(), 2);
+    EXPECT_THAT(coords[0], Point(1, 3, 5));
+    EXPECT_THAT(coords[1], Point(2, 4, 6));
+
+    EXPECT_THROW(Coordinates({ 1, 2 }, { 3 }, { 5, 6 }), Exception);
+}
+
+TEST(CoordinatesTest, push_back_append)
+{
+    Coordinates coords;
+    EXPECT_TRUE(coords.empty());
+    coords.push_back(Point(1, 2, 3));
+    Coordinates other({ 4, 7 }, { 5, 8 }, { 6, 9 });
+    coords.append(other);
+    ASSERT_EQ(coords.size(), 3);
+    EXPECT_THAT(coords[0], Point(1, 2, 3));
+    EXPECT_THAT(coords[1], Point(4, 5, 6));
+    EXPECT_THAT(coords[2], Point(7, 8, 9));
+
+    coords.set(1, Point(-1, -2, -3));
+    EXPECT_THAT(coords[1], Point(-1, -2, -3));
+}
+
+TEST(CoordinatesTest, permute)
+{
+    Coordinates coords(std::vector<Point> { Point(1, 2, 3), Point(4, 5, 6), Point(7, 8, 9) });
+    std::vector<Index> new_ids = { 2, 0, 1 };
+    coords.permute(new_ids);
+    EXPECT_THAT(coords.x(), ElementsAre(4, 7, 1));
+    EXPECT_THAT(coords.y(), ElementsAre(5, 8, 2));
+    EXPECT_THAT(coords.z(), ElementsAre(6, 9, 3));
+
+    std::vector<Index> wrong_size = { 0 };
+    EXPECT_THROW(coords.permute(wrong_size), Exception);
+}
+
+TEST(CoordinatesTest, view)
+{
+    Coordinates coords({ 1, 2, 3 }, { 4, 5, 6 }, { 7, 8, 9 });
+    auto view = coords.view();
+    ASSERT_EQ(view.size(), 3);
+    EXPECT_THAT(view[2], Point(3, 6, 9));
+
+    std::vector<Point> pts(view.begin(), view.end());
+    EXPECT_THAT(pts, ElementsAre(Point(1, 4, 7), Point(2, 5, 8), Point(3, 6, 9)));
+    EXPECT_TRUE(std::ranges::equal(view, pts));
+    EXPECT_EQ(view.end() - view.begin(), 3);
+}
+
+TEST(CoordinatesTest, transform)
+{
+    std::vector<Point> pts;
+    for (int i = 0; i < 10000; ++i)
+        pts.emplace_back(i, 2. * i, -i);
+    Coordinates coords(pts);
+    auto tr = Trsf::rotated_z(0.3).translate(1, 2, 3).scale(2.);
+    coords.transform(tr);
+    for (std::size_t i = 0; i < pts.size(); ++i) {
+        auto expected = tr * pts[i];
+        EXPECT_NEAR(coords[i].x, expected.x, 1e-9);
+        EXPECT_NEAR(coords[i].y, expected.y, 1e-9);
+        EXPECT_NEAR(coords[i].z, expected.z, 1e-9);
+    }
+}
+
+TEST(CoordinatesTest, bounding_box)
+{
+    std::vector<Point> pts;
+    for (int i = 0; i < 100000; ++i)
+        pts.emplace_back(std::sin(i), 3. * std::cos(i), i * 1e-3);
+    Coordinates coords(pts);
+    auto bbox = coords.bounding_box();
+
+    BoundingBox3D expected;
+    for (auto & pt : pts)
+        expected += pt;
+    EXPECT_THAT(bbox.min(), expected.min());
+    EXPECT_THAT(bbox.max(), expected.max());
+
+    EXPECT_TRUE(Coordinates().bounding_box().empty());
+}
+
+TEST(CoordinatesTest, centroid)
+{
+    Coordinates coords({ 0, 2, 0, 2 }, { 0, 0, 2, 2 }, { 1, 1, 1, 1 });
+    std::vector<Index> ids = { 0, 1, 3 };
+    auto ctr = coords.centroid(ids);
+    EXPECT_DOUBLE_EQ(ctr.x, 4. / 3.);
+    EXPECT_DOUBLE_EQ(ctr.y, 2. / 3.);
+    EXPECT_DOUBLE_EQ(ctr.z, 1.);
+}
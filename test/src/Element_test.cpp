@@ -3,6 +3,7 @@
 #include "krado/point.h"
 
 using namespace krado;
+using namespace testing;
 
 TEST(ElementTest, line2)
 {
@@ -105,3 +106,11 @@ TEST(ElementTest, shift)
     EXPECT_EQ(elem.index(1), 15);
     EXPECT_EQ(elem.index(2), 19);
 }
+
+TEST(ElementTest, remap)
+{
+    auto elem = Element::Tri3({ 0, 2, 3 });
+    std::vector<Index> new_ids = { 7, 6, 5, 4 };
+    elem.remap(new_ids);
+    EXPECT_THAT(elem.indices(), ElementsAre(7, 5, 4));
+}
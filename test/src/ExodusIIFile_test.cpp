@@ -1,5 +1,6 @@
 #include "gmock/gmock.h"
 #include "builder.h"
+#include "ExceptionTestMacros.h"
 #include "krado/exodusii_file.h"
 #include "krado/element.h"
 #include "krado/mesh.h"
@@ -87,6 +88,32 @@ TEST(ExodusIIFileTest, write_geom_model_2d)
     EXPECT_TRUE(fs::exists(temp_fname));
 }
 
+TEST(ExodusIIFileTest, write_geom_model_foreign_vertex)
+{
+    auto mesh_rect = [](GeomModel & model) {
+        SchemeEqual::Options opts;
+        opts.intervals = 2;
+        for (auto & [id, crv] : model.curves())
+            crv->set_scheme<SchemeEqual>(opts);
+        model.surface(1)->set_scheme<SchemeStructured>(SchemeStructured::Options());
+        model.surface(1)->set_marker(100);
+        model.mesh_surface(1);
+    };
+
+    auto rect = testing::build_rect(Point(0, 0, 0), Point(1, 1, 0));
+    GeomModel model(rect);
+    mesh_rect(model);
+    auto other_rect = testing::build_rect(Point(2, 0, 0), Point(3, 1, 0));
+    GeomModel other(other_rect);
+    mesh_rect(other);
+    model.surface(1)->add_quadrangle(
+        { model.vertex(1), model.vertex(2), other.vertex(3), model.vertex(4) });
+
+    auto temp_fname = fs::temp_directory_path() / ("krado_" + std::to_string(rand()) + ".exo");
+    ExodusIIFile f(temp_fname);
+    EXPECT_THROW(f.write(model), Exception);
+}
+
 TEST(ExodusIIFileTest, read_2d)
 {
     ExodusIIFile f(fs::path(KRADO_UNIT_TESTS_ROOT) / "assets" / "mesh" / "square-half-tri.e");
@@ -242,3 +269,164 @@ TEST(ExodusIIFileTest, warn_on_empty_node_set)
     ExodusIIFile exo(temp_fname);
     exo.write(mesh);
 }
+
+TEST(ExodusIIFileTest, write_mixed_types_without_cell_sets)
+{
+    // clang-format off
+    std::vector<Point> pts = {
+        Point(0, 0), Point(1, 0), Point(2, 0),
+        Point(0, 1), Point(1, 1), Point(2, 1)
+    };
+    std::vector<Element> elems = {
+        Element::Tri3({ 0, 1, 3 }),
+        Element::Quad4({ 1, 2, 5, 4 }),
+        Element::Tri3({ 1, 4, 3 })
+    };
+    // clang-format on
+    auto mesh = Ptr<Mesh>::alloc(pts, elems);
+    std::vector<SideEntry> sides = { { 1, 1 }, { 2, 0 } };
+    mesh->set_side_set(10, sides);
+
+    auto temp_fname = fs::temp_directory_path() / ("krado_" + std::to_string(rand()) + ".exo");
+    {
+        ExodusIIFile f(temp_fname);
+        f.write(mesh);
+    }
+    {
+        ExodusIIFile f(temp_fname);
+        auto mesh_read = f.read();
+        // one block per element type, so elements are grouped by type: triangles, then quads
+        ASSERT_EQ(mesh_read->num_elements(), 3);
+        EXPECT_EQ(mesh_read->element(0).type(), ElementType::TRI3);
+        EXPECT_THAT(mesh_read->element(0).indices(), ElementsAre(0, 1, 3));
+        EXPECT_EQ(mesh_read->element(1).type(), ElementType::TRI3);
+        EXPECT_THAT(mesh_read->element(1).indices(), ElementsAre(1, 4, 3));
+        EXPECT_EQ(mesh_read->element(2).type(), ElementType::QUAD4);
+        EXPECT_THAT(mesh_read->element(2).indices(), ElementsAre(1, 2, 5, 4));
+        EXPECT_THAT(mesh_read->cell_set_ids(), ElementsAre(1, 2));
+        EXPECT_THAT(mesh_read->cell_set(1), ElementsAre(0, 1));
+        EXPECT_THAT(mesh_read->cell_set(2), ElementsAre(2));
+
+        // side set entries follow their elements
+        EXPECT_THAT(mesh_read->side_set(10), ElementsAre(SideEntry(2, 1), SideEntry(1, 0)));
+    }
+    fs::remove(temp_fname);
+}
+
+TEST(ExodusIIFileTest, write_skips_empty_sets)
+{
+    std::vector<Point> pts = { Point(0, 0, 0), Point(1, 0, 0), Point(1, 1, 0), Point(0, 1, 0) };
+    std::vector<Element> elems = { Element::Quad4({ 0, 1, 2, 3 }) };
+    auto mesh = Ptr<Mesh>::alloc(pts, elems);
+    mesh->set_up();
+    mesh->set_side_set(10, {});
+    mesh->set_side_set(11, std::vector<SideEntry> { { 0, 2 } });
+    mesh->set_node_set(20, { 0, 3 });
+    mesh->set_node_set(21, {});
+    mesh->set_node_set(22, { 1 });
+
+    auto temp_fname = fs::temp_directory_path() / ("krado_" + std::to_string(rand()) + ".exo");
+    {
+        ExodusIIFile f(temp_fname);
+        f.write(mesh);
+    }
+    {
+        exodusIIcpp::File exo;
+        exo.open(temp_fname.string());
+        EXPECT_EQ(exo.get_num_side_sets(), 1);
+        EXPECT_EQ(exo.get_num_node_sets(), 2);
+    }
+    {
+        ExodusIIFile f(temp_fname);
+        auto mesh_read = f.read();
+        EXPECT_THAT(mesh_read->side_set_ids(), ElementsAre(11));
+        EXPECT_THAT(mesh_read->side_set(11), ElementsAre(SideEntry(0, 2)));
+        EXPECT_THAT(mesh_read->node_set_ids(), ElementsAre(20, 22));
+        EXPECT_THAT(mesh_read->node_set(22), ElementsAre(1));
+    }
+    fs::remove(temp_fname);
+}
+
+TEST(ExodusIIFileTest, write_mixed_type_cell_set)
+{
+    std::vector<Point> pts = { Point(0, 0), Point(1, 0), Point(2, 0), Point(0, 1), Point(1, 1) };
+    std::vector<Element> elems = { Element::Quad4({ 0, 1, 4, 3 }), Element::Tri3({ 1, 2, 4 }) };
+    auto mesh = Ptr<Mesh>::alloc(pts, elems);
+    mesh->set_cell_set(1, { 0, 1 });
+
+    auto temp_fname = fs::temp_directory_path() / ("krado_" + std::to_string(rand()) + ".exo");
+    ExodusIIFile f(temp_fname);
+    EXPECT_THROW_MSG(f.write(mesh), "Element block 1 has elements of different types");
+    fs::remove(temp_fname);
+}
+
+TEST(ExodusIIFileTest, write_side_set_outside_blocks)
+{
+    std::vector<Point> pts = { Point(0, 0), Point(1, 0), Point(2, 0), Point(0, 1), Point(1, 1) };
+    std::vector<Element> elems = { Element::Quad4({ 0, 1, 4, 3 }), Element::Tri3({ 1, 2, 4 }) };
+    auto mesh = Ptr<Mesh>::alloc(pts, elems);
+    mesh->set_cell_set(1, { 0 });
+    mesh->set_side_set(10, std::vector<SideEntry> { { 1, 0 } });
+    mesh->set_side_set_name(10, "right");
+
+    auto temp_fname = fs::temp_directory_path() / ("krado_" + std::to_string(rand()) + ".exo");
+    ExodusIIFile f(temp_fname);
+    EXPECT_THROW_MSG(f.write(mesh),
+                     "Side set 'right' refers to element 1 which is not in any block");
+    fs::remove(temp_fname);
+}
+
+TEST(ExodusIIFileTest, write_netcdf4_compressed)
+{
+    std::vector<Point> pts = { Point(0, 0, 0), Point(1, 0, 0), Point(1, 1, 0), Point(0, 1, 0) };
+    std::vector<Element> elems = { Element::Tri3({ 0, 1, 2 }), Element::Tri3({ 0, 2, 3 }) };
+    auto mesh = Ptr<Mesh>::alloc(pts, elems);
+    mesh->set_up();
+    mesh->set_node_set(10, { 0, 3 });
+
+    ExodusIIFile::Options opts;
+    opts.format = ExodusIIFile::Format::NETCDF4;
+    opts.compression = ExodusIIFile::Compression::ZLIB;
+    opts.compression_level = 4;
+    opts.int64 = true;
+
+    auto temp_fname = fs::temp_directory_path() / ("krado_" + std::to_string(rand()) + ".exo");
+#ifndef KRADO_WITH_EXODUSII_NETCDF4
+    EXPECT_THROW_MSG(ExodusIIFile(temp_fname, opts).write(mesh),
+                     "Writing NetCDF-4 ExodusII files is not supported by this build");
+    GTEST_SKIP() << "exodusIIcpp cannot write NetCDF-4 files";
+#endif
+    {
+        ExodusIIFile exo(temp_fname, opts);
+        exo.write(mesh);
+    }
+    {
+        ExodusIIFile exo(temp_fname);
+        auto mesh_read = exo.read();
+        EXPECT_EQ(mesh_read->num_elements(), 2);
+        EXPECT_THAT(mesh_read->element(1).indices(), ElementsAre(0, 2, 3));
+        EXPECT_THAT(mesh_read->node_set(10), ElementsAre(0, 3));
+    }
+}
+
+TEST(ExodusIIFileTest, invalid_options)
+{
+    ExodusIIFile::Options opts;
+    opts.compression = ExodusIIFile::Compression::ZLIB;
+    EXPECT_THROW_MSG(ExodusIIFile("a.exo", opts), "Compression requires NetCDF-4 format");
+
+    opts.compression = ExodusIIFile::Compression::NONE;
+    opts.int64 = true;
+    EXPECT_THROW_MSG(ExodusIIFile("a.exo", opts), "64-bit integers require NetCDF-4 format");
+
+    opts.format = ExodusIIFile::Format::NETCDF4;
+    opts.compression = ExodusIIFile::Compression::ZLIB;
+    opts.compression_level = 10;
+    EXPECT_THROW_MSG(ExodusIIFile("a.exo", opts),
+                     "Deflate compression level must be between 1 and 9, got 10");
+
+    opts.compression = ExodusIIFile::Compression::SZIP;
+    opts.compression_level = 5;
+    EXPECT_THROW_MSG(ExodusIIFile("a.exo", opts),
+                     "Szip pixels per block must be an even number between 4 and 32, got 5");
+}
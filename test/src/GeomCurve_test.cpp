@@ -7,6 +7,7 @@
 #include "krado/mesh_surface_vertex.h"
 #include "krado/vector.h"
 #include "builder.h"
+#include "GeomLProp_CLProps.hxx"
 
 using namespace krado;
 
@@ -119,6 +120,47 @@ TEST(GeomCurveTest, d1_arc)
     EXPECT_NEAR(v_2.z, 0., 1e-10);
 }
 
+TEST(GeomCurveTest, batch_eval)
+{
+    auto cyl = testing::build_cylinder(Point(0, 0, 0), 2., 3.);
+    for (auto & surf : cyl.surfaces()) {
+        for (auto & crv : surf.curves()) {
+            auto [lo, hi] = crv.param_range();
+            std::vector<double> u;
+            for (int i = 0; i <= 10; ++i)
+                u.push_back(lo + (hi - lo) * i / 10.);
+
+            std::vector<Point> pts(u.size());
+            std::vector<Vector> ders(u.size());
+            std::vector<double> curv(u.size());
+            crv.point(u, pts);
+            crv.d1(u, ders);
+            crv.curvature(u, curv);
+            for (std::size_t i = 0; i < u.size(); ++i) {
+                // compare with OpenCASCADE
+                auto occ_pt = crv.curve_handle()->Value(u[i]);
+                EXPECT_NEAR(pts[i].x, occ_pt.X(), 1e-12);
+                EXPECT_NEAR(pts[i].y, occ_pt.Y(), 1e-12);
+                EXPECT_NEAR(pts[i].z, occ_pt.Z(), 1e-12);
+                auto occ_d1 = crv.curve_handle()->DN(u[i], 1);
+                EXPECT_NEAR(ders[i].x, occ_d1.X(), 1e-12);
+                EXPECT_NEAR(ders[i].y, occ_d1.Y(), 1e-12);
+                EXPECT_NEAR(ders[i].z, occ_d1.Z(), 1e-12);
+                GeomLProp_CLProps props(crv.curve_handle(), u[i], 2, 1e-12);
+                EXPECT_NEAR(curv[i], props.Curvature(), 1e-12);
+            }
+        }
+    }
+}
+
+TEST(GeomCurveTest, batch_eval_size_mismatch)
+{
+    auto line = testing::build_line(Point(0, 0, 0), Point(3, 4, 0));
+    std::vector<double> u = { 0., 1. };
+    std::vector<Point> pts(1);
+    EXPECT_THROW(line.point(u, pts), Exception);
+}
+
 TEST(GeomCurveTest, vertices)
 {
     auto line = testing::build_line(Point(1, 2, 3), Point(3, 4, 5));
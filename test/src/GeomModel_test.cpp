@@ -6,7 +6,13 @@
 #include "krado/mesh_curve.h"
 #include "krado/mesh_surface.h"
 #include "krado/mesh_volume.h"
+#include "krado/mesh_curve_vertex.h"
+#include "krado/mesh_surface_vertex.h"
 #include "krado/vector.h"
+#include "krado/mesh.h"
+#include "krado/scheme/equal.h"
+#include "krado/scheme/structured.h"
+#include "builder.h"
 #include <filesystem>
 
 using namespace krado;
@@ -57,3 +63,98 @@ TEST(GeomModelTest, load_box)
     EXPECT_EQ(model.volumes().size(), 1);
     EXPECT_THROW({ auto v = model.volume(1000); }, Exception);
 }
+
+TEST(GeomModelTest, mesh_all)
+{
+    auto box = testing::build_box(Point(0, 0, 0), Point(1, 2, 3));
+
+    SchemeEqual::Options opts_equal;
+    opts_equal.intervals = 4;
+    SchemeStructured::Options opts_struct;
+    auto mesh_box = [&](bool parallel) {
+        GeomModel model(box);
+        for (auto & [id, crv] : model.curves())
+            crv->set_scheme<SchemeEqual>(opts_equal);
+        for (auto & [id, srf] : model.surfaces())
+            srf->set_scheme<SchemeStructured>(opts_struct);
+        model.mesh_all(parallel);
+
+        for (auto & [id, crv] : model.curves())
+            EXPECT_TRUE(crv->is_meshed());
+        for (auto & [id, srf] : model.surfaces()) {
+            EXPECT_TRUE(srf->is_meshed());
+            EXPECT_EQ(srf->quadrangles().size(), 16);
+        }
+        EXPECT_FALSE(model.volume(1)->is_meshed());
+        return build_mesh(model);
+    };
+
+    auto serial = mesh_box(false);
+    auto parallel = mesh_box(true);
+    EXPECT_EQ(parallel->points().size(), serial->points().size());
+    EXPECT_EQ(parallel->num_elements(), 6 * 16);
+    ASSERT_EQ(parallel->num_elements(), serial->num_elements());
+    for (Index i = 0; i < serial->num_elements(); ++i)
+        EXPECT_THAT(parallel->element(i).indices(),
+                    testing::ElementsAreArray(serial->element(i).indices()));
+}
+
+TEST(GeomModelTest, number_vertices)
+{
+    auto box = testing::build_box(Point(0, 0, 0), Point(1, 2, 3));
+    GeomModel model(box);
+
+    SchemeEqual::Options opts_equal;
+    opts_equal.intervals = 2;
+    SchemeStructured::Options opts_struct;
+    for (auto & [id, crv] : model.curves())
+        crv->set_scheme<SchemeEqual>(opts_equal);
+    for (auto & [id, srf] : model.surfaces())
+        srf->set_scheme<SchemeStructured>(opts_struct);
+    model.mesh_all();
+
+    // 8 corners, 12 curves with 1 vertex, 6 surfaces with 1 vertex
+    auto numbering = number_vertices(model);
+    auto n = numbering.n_vertices;
+    EXPECT_EQ(n, 8 + 12 + 6);
+    EXPECT_EQ(model.vertex(1)->num(), 0);
+    EXPECT_EQ(model.curve(1)->curve_vertices()[0]->num(), 8);
+    EXPECT_EQ(model.surface(1)->surface_vertices()[0]->num(), 20);
+
+    auto mesh = build_mesh(model);
+    ASSERT_EQ(mesh->num_points(), n);
+    for (auto & [id, srf] : model.surfaces())
+        for (auto & v : srf->surface_vertices())
+            EXPECT_EQ(mesh->point(v->num()), v->point());
+}
+
+TEST(GeomModelTest, foreign_vertex)
+{
+    auto mesh_rect = [](GeomModel & model) {
+        SchemeEqual::Options opts_equal;
+        opts_equal.intervals = 2;
+        for (auto & [id, crv] : model.curves())
+            crv->set_scheme<SchemeEqual>(opts_equal);
+        model.surface(1)->set_scheme<SchemeStructured>(SchemeStructured::Options());
+        model.mesh_all();
+    };
+
+    auto rect = testing::build_rect(Point(0, 0, 0), Point(1, 1, 0));
+    GeomModel model(rect);
+    mesh_rect(model);
+    auto other_rect = testing::build_rect(Point(2, 0, 0), Point(3, 1, 0));
+    GeomModel other(other_rect);
+    mesh_rect(other);
+    EXPECT_EQ(build_mesh(model)->num_points(), 9);
+
+    // the vertex of `other` has an in-range number, but from a different numbering pass
+    number_vertices(other);
+    ASSERT_LT(other.vertex(3)->num(), 9);
+    model.surface(1)->add_quadrangle(
+        { model.vertex(1), model.vertex(2), other.vertex(3), model.vertex(4) });
+    EXPECT_THROW(build_mesh(model), Exception);
+
+    auto numbering = number_vertices(model);
+    EXPECT_EQ(numbering.index(*model.vertex(2)), model.vertex(2)->num());
+    EXPECT_THROW({ auto idx = numbering.index(*other.vertex(3)); }, Exception);
+}
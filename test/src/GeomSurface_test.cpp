@@ -6,6 +6,8 @@
 #include "krado/uv_param.h"
 #include "BRepGProp.hxx"
 #include "GProp_GProps.hxx"
+#include "BRep_Tool.hxx"
+#include "GeomLProp_SLProps.hxx"
 #include "builder.h"
 
 using namespace krado;
@@ -92,6 +94,46 @@ TEST(GeomSurfaceTest, normal)
     EXPECT_DOUBLE_EQ(n.z, 1.);
 }
 
+TEST(GeomSurfaceTest, batch_eval)
+{
+    auto cyl = testing::build_cylinder(Point(0, 0, 0), 2., 3.);
+    for (auto & surf : cyl.surfaces()) {
+        auto [u_lo, u_hi] = surf.param_range(0);
+        auto [v_lo, v_hi] = surf.param_range(1);
+        std::vector<UVParam> uv;
+        for (int i = 0; i <= 4; ++i)
+            for (int j = 0; j <= 4; ++j)
+                uv.emplace_back(u_lo + (u_hi - u_lo) * i / 4., v_lo + (v_hi - v_lo) * j / 4.);
+
+        std::vector<Point> pts(uv.size());
+        std::vector<Vector> normals(uv.size());
+        surf.point(uv, pts);
+        surf.normal(uv, normals);
+        // compare with OpenCASCADE
+        auto occ_surf = BRep_Tool::Surface(surf);
+        for (std::size_t i = 0; i < uv.size(); ++i) {
+            auto occ_pt = occ_surf->Value(uv[i].u, uv[i].v);
+            EXPECT_NEAR(pts[i].x, occ_pt.X(), 1e-12);
+            EXPECT_NEAR(pts[i].y, occ_pt.Y(), 1e-12);
+            EXPECT_NEAR(pts[i].z, occ_pt.Z(), 1e-12);
+            GeomLProp_SLProps props(occ_surf, uv[i].u, uv[i].v, 1, 1e-10);
+            ASSERT_TRUE(props.IsNormalDefined());
+            const auto & occ_n = props.Normal();
+            EXPECT_NEAR(normals[i].x, occ_n.X(), 1e-12);
+            EXPECT_NEAR(normals[i].y, occ_n.Y(), 1e-12);
+            EXPECT_NEAR(normals[i].z, occ_n.Z(), 1e-12);
+        }
+    }
+}
+
+TEST(GeomSurfaceTest, batch_eval_size_mismatch)
+{
+    auto circ = testing::build_circle(Point(0, 0, 0), 2.);
+    std::vector<UVParam> uv = { { 0., 0. } };
+    std::vector<Vector> normals(2);
+    EXPECT_THROW(circ.normal(uv, normals), Exception);
+}
+
 TEST(GeomSurfaceTest, param_from_pt)
 {
     constexpr double r = 2.;
@@ -105,6 +147,49 @@ TEST(GeomSurfaceTest, param_from_pt)
     EXPECT_THROW([[maybe_unused]] auto u = circ.parameter_from_point(Point(3, 3, 0)), Exception);
 }
 
+TEST(GeomSurfaceTest, param_from_pt_guess)
+{
+    constexpr double r = 2.;
+    auto tri = testing::build_triangle(Point(0, 0, 0), r);
+
+    auto [u, v] = tri.parameter_from_point(Point(0.5, 1, 0), UVParam(0.25, 0.25));
+    EXPECT_NEAR(u, 0.2071067811865474, 1e-9);
+    EXPECT_NEAR(v, 0.2928932188134525, 1e-9);
+
+    EXPECT_THROW(
+        [[maybe_unused]] auto u = tri.parameter_from_point(Point(3, 3, 0), UVParam(0.2, 0.2)),
+        Exception);
+}
+
+TEST(GeomSurfaceTest, param_from_pt_batch)
+{
+    auto cyl = testing::build_cylinder(Point(0, 0, 0), 2., 3.);
+    for (auto & surf : cyl.surfaces()) {
+        auto [u_lo, u_hi] = surf.param_range(0);
+        auto [v_lo, v_hi] = surf.param_range(1);
+        std::vector<UVParam> exact;
+        for (int i = 1; i < 40; ++i)
+            for (int j = 1; j < 40; ++j)
+                exact.emplace_back(u_lo + (u_hi - u_lo) * i / 40., v_lo + (v_hi - v_lo) * j / 40.);
+        std::vector<Point> pts(exact.size());
+        surf.point(exact, pts);
+
+        std::vector<UVParam> uv(pts.size());
+        surf.parameter_from_point(pts, uv);
+        for (std::size_t i = 0; i < uv.size(); ++i)
+            EXPECT_TRUE(surf.point(uv[i]).is_equal(pts[i], 1e-9));
+
+        std::vector<UVParam> guess(exact);
+        for (auto & g : guess) {
+            g.u += 0.01 * (u_hi - u_lo);
+            g.v -= 0.01 * (v_hi - v_lo);
+        }
+        surf.parameter_from_point(pts, guess, uv);
+        for (std::size_t i = 0; i < uv.size(); ++i)
+            EXPECT_TRUE(surf.point(uv[i]).is_equal(pts[i], 1e-9));
+    }
+}
+
 TEST(GeomSurfaceTest, nearest_point)
 {
     auto circ = testing::build_circle(Point(0, 0, 0), 2.);
@@ -0,0 +1,157 @@
+#include "gmock/gmock.h"
+#include "ExceptionTestMacros.h"
+#include "krado/gmsh_file.h"
+#include "krado/element.h"
+#include "krado/mesh.h"
+#include "krado/point.h"
+#include <filesystem>
+#include <fstream>
+
+using namespace krado;
+using namespace testing;
+namespace fs = std::filesystem;
+
+namespace {
+
+fs::path
+temp_file_name()
+{
+    return fs::temp_directory_path() / ("krado_" + std::to_string(rand()) + ".msh");
+}
+
+std::vector<Index>
+side_vertices(const Mesh & mesh, const SideEntry & side)
+{
+    std::array<Index, 4> vtx;
+    auto n = facet_vertices(mesh.element(side.elem), side.side, vtx);
+    std::vector<Index> vertices(vtx.begin(), vtx.begin() + n);
+    std::sort(vertices.begin(), vertices.end());
+    return vertices;
+}
+
+void
+round_trip(bool binary)
+{
+    std::vector<Point> pts = { Point(0, 0, 0), Point(1, 0, 0), Point(2, 0, 0),
+                               Point(0, 1, 0), Point(1, 1, 0), Point(2, 1, 0) };
+    std::vector<Element> elems = { Element::Quad4({ 0, 1, 4, 3 }),
+                                   Element::Tri3({ 1, 2, 5 }),
+                                   Element::Tri3({ 1, 5, 4 }) };
+    auto mesh = Ptr<Mesh>::alloc(pts, elems);
+    mesh->set_cell_set(1, { 0 });
+    mesh->set_cell_set_name(1, "quads");
+    mesh->set_cell_set(2, { 1, 2 });
+    // overlaps both sets above
+    mesh->set_cell_set(3, { 0, 2 });
+    mesh->set_cell_set_name(3, "mixed");
+    mesh->set_side_set(10, { SideEntry(0, 0), SideEntry(1, 0) });
+    mesh->set_side_set_name(10, "bottom");
+
+    auto fname = temp_file_name();
+    GmshFile::Options opts;
+    opts.binary = binary;
+    GmshFile(fname, opts).write(mesh);
+    auto mesh_rd = GmshFile(fname).read();
+
+    ASSERT_EQ(mesh_rd->num_points(), 6);
+    for (Index i = 0; i < 6; ++i)
+        EXPECT_EQ(mesh_rd->point(i), mesh->point(i));
+    ASSERT_EQ(mesh_rd->num_elements(), 3);
+    EXPECT_EQ(mesh_rd->element(0).type(), ElementType::QUAD4);
+    EXPECT_THAT(mesh_rd->element(0).indices(), ElementsAre(0, 1, 4, 3));
+    EXPECT_EQ(mesh_rd->element(2).type(), ElementType::TRI3);
+    EXPECT_THAT(mesh_rd->element(2).indices(), ElementsAre(1, 5, 4));
+
+    EXPECT_THAT(mesh_rd->cell_set_ids(), ElementsAre(1, 2, 3));
+    EXPECT_THAT(mesh_rd->cell_set(1), ElementsAre(0));
+    EXPECT_THAT(mesh_rd->cell_set(2), ElementsAre(1, 2));
+    EXPECT_THAT(mesh_rd->cell_set(3), ElementsAre(0, 2));
+    EXPECT_EQ(mesh_rd->cell_set_name(1).value(), "quads");
+    EXPECT_FALSE(mesh_rd->cell_set_name(2).has_value());
+    EXPECT_EQ(mesh_rd->cell_set_name(3).value(), "mixed");
+
+    EXPECT_THAT(mesh_rd->side_set_ids(), ElementsAre(10));
+    EXPECT_THAT(mesh_rd->side_set(10), ElementsAre(SideEntry(0, 0), SideEntry(1, 0)));
+    EXPECT_EQ(mesh_rd->side_set_name(10).value(), "bottom");
+
+    fs::remove(fname);
+}
+
+} // namespace
+
+TEST(GmshFileTest, read_ascii)
+{
+    auto fname = temp_file_name();
+    {
+        std::ofstream out(fname);
+        out << "$MeshFormat\n"
+               "4.1 0 8\n"
+               "$EndMeshFormat\n"
+               "$PhysicalNames\n"
+               "2\n"
+               "1 7 \"bottom\"\n"
+               "2 5 \"domain\"\n"
+               "$EndPhysicalNames\n"
+               "$Entities\n"
+               "0 1 1 0\n"
+               "1 0 0 0 1 0 0 1 7 0\n"
+               "1 0 0 0 1 1 0 1 5 0\n"
+               "$EndEntities\n"
+               "$Nodes\n"
+               "1 4 1 4\n"
+               "2 1 0 4\n"
+               "1\n2\n3\n4\n"
+               "0 0 0\n1 0 0\n1 1 0\n0 1 0\n"
+               "$EndNodes\n"
+               "$Elements\n"
+               "2 3 1 3\n"
+               "1 1 1 1\n"
+               "1 1 2\n"
+               "2 1 2 2\n"
+               "2 1 2 3\n"
+               "3 1 3 4\n"
+               "$EndElements\n";
+    }
+
+    auto mesh = GmshFile(fname).read();
+    EXPECT_EQ(mesh->num_points(), 4);
+    EXPECT_EQ(mesh->point(2), Point(1, 1, 0));
+    ASSERT_EQ(mesh->num_elements(), 2);
+    EXPECT_EQ(mesh->element(1).type(), ElementType::TRI3);
+    EXPECT_THAT(mesh->element(1).indices(), ElementsAre(0, 2, 3));
+
+    EXPECT_THAT(mesh->cell_set_ids(), ElementsAre(5));
+    EXPECT_THAT(mesh->cell_set(5), ElementsAre(0, 1));
+    EXPECT_EQ(mesh->cell_set_name(5).value(), "domain");
+
+    EXPECT_THAT(mesh->side_set_ids(), ElementsAre(7));
+    auto ss = mesh->side_set(7);
+    ASSERT_EQ(ss.size(), 1);
+    EXPECT_EQ(ss[0].elem, 0);
+    EXPECT_THAT(side_vertices(*mesh, ss[0]), ElementsAre(0, 1));
+    EXPECT_EQ(mesh->side_set_name(7).value(), "bottom");
+
+    fs::remove(fname);
+}
+
+TEST(GmshFileTest, round_trip_binary)
+{
+    round_trip(true);
+}
+
+TEST(GmshFileTest, round_trip_ascii)
+{
+    round_trip(false);
+}
+
+TEST(GmshFileTest, unsupported_version)
+{
+    auto fname = temp_file_name();
+    {
+        std::ofstream out(fname);
+        out << "$MeshFormat\n2.2 0 8\n$EndMeshFormat\n";
+    }
+    EXPECT_THROW_MSG(GmshFile(fname).read(),
+                     fmt::format("Unsupported MSH version '2.2' in '{}'", fname.string()).c_str());
+    fs::remove(fname);
+}
@@ -2,8 +2,10 @@
 #include "krado/point.h"
 #include "krado/mesh.h"
 #include "krado/hasse_diagram.h"
+#include "krado/exception.h"
 
 using namespace krado;
+using namespace testing;
 
 TEST(HasseDiagramTest, hasse_1d)
 {
@@ -60,3 +62,122 @@ TEST(HasseDiagramTest, hasse_3d)
     Mesh mesh(pts, elems);
     HasseDiagram hasse(mesh);
 }
+
+TEST(HasseDiagramTest, adjacency_2d)
+{
+    // clang-format off
+    std::vector<Point> pts = {
+        Point(0., 0.),
+        Point(1., 0.),
+        Point(0., 1.),
+        Point(1., 1.)
+    };
+    std::vector<Element> elems = {
+        Element::Tri3({ 0, 1, 2 }),
+        Element::Tri3({ 2, 1, 3 })
+    };
+    // clang-format on
+    Mesh mesh(pts, elems);
+    HasseDiagram hasse(mesh);
+
+    EXPECT_EQ(hasse.cells(), make_range(HasseIndex(0), HasseIndex(2)));
+    EXPECT_EQ(hasse.vertices(), make_range(HasseIndex(2), HasseIndex(6)));
+    EXPECT_EQ(hasse.faces().first(), hasse.faces().last());
+    EXPECT_EQ(hasse.edges(), make_range(HasseIndex(6), HasseIndex(11)));
+
+    EXPECT_THAT(hasse.out_vertices(HasseIndex(0)),
+                ElementsAre(HasseIndex(6), HasseIndex(7), HasseIndex(8)));
+    EXPECT_THAT(hasse.out_vertices(HasseIndex(1)),
+                ElementsAre(HasseIndex(7), HasseIndex(9), HasseIndex(10)));
+    EXPECT_THAT(hasse.out_vertices(HasseIndex(7)), ElementsAre(HasseIndex(3), HasseIndex(4)));
+    EXPECT_THAT(hasse.out_vertices(HasseIndex(10)), ElementsAre(HasseIndex(5), HasseIndex(4)));
+    EXPECT_THAT(hasse.in_vertices(HasseIndex(7)), ElementsAre(HasseIndex(0), HasseIndex(1)));
+    EXPECT_THAT(hasse.in_vertices(HasseIndex(9)), ElementsAre(HasseIndex(1)));
+    EXPECT_THAT(hasse.in_vertices(HasseIndex(3)),
+                ElementsAre(HasseIndex(6), HasseIndex(7), HasseIndex(9)));
+}
+
+TEST(HasseDiagramTest, shared_face_3d)
+{
+    // clang-format off
+    std::vector<Point> pts = {
+        Point(0., 0., 0.),
+        Point(1., 0., 0.),
+        Point(1., 1., 0.),
+        Point(0., 1., 0.),
+        Point(0., 0., 1.),
+        Point(1., 0., 1.),
+        Point(1., 1., 1.),
+        Point(0., 1., 1.),
+        Point(2., 0., 0.),
+        Point(2., 1., 0.),
+        Point(2., 0., 1.),
+        Point(2., 1., 1.)
+    };
+    std::vector<Element> elems = {
+        Element::Hex8({ 0, 1, 2, 3, 4, 5, 6, 7 }),
+        Element::Hex8({ 1, 8, 9, 2, 5, 10, 11, 6 })
+    };
+    // clang-format on
+    Mesh mesh(pts, elems);
+    HasseDiagram hasse(mesh);
+
+    EXPECT_EQ(hasse.faces(), make_range(HasseIndex(14), HasseIndex(25)));
+    EXPECT_EQ(hasse.edges(), make_range(HasseIndex(25), HasseIndex(45)));
+
+    // face shared by both hexes
+    EXPECT_THAT(hasse.in_vertices(HasseIndex(17)), ElementsAre(HasseIndex(0), HasseIndex(1)));
+    EXPECT_THAT(hasse.out_vertices(HasseIndex(1)),
+                ElementsAre(HasseIndex(20),
+                            HasseIndex(21),
+                            HasseIndex(17),
+                            HasseIndex(22),
+                            HasseIndex(23),
+                            HasseIndex(24)));
+    for (auto face : hasse.faces())
+        EXPECT_EQ(hasse.out_vertices(face).size(), 4);
+    for (auto edge : hasse.edges())
+        EXPECT_EQ(hasse.out_vertices(edge).size(), 2);
+}
+
+TEST(HasseDiagramTest, relations)
+{
+    // clang-format off
+    std::vector<Point> pts = {
+        Point(0., 0.),
+        Point(1., 0.),
+        Point(0., 1.),
+        Point(1., 1.)
+    };
+    std::vector<Element> elems = {
+        Element::Tri3({ 0, 1, 2 }),
+        Element::Tri3({ 2, 1, 3 })
+    };
+    // clang-format on
+    Mesh mesh(pts, elems);
+
+    HasseDiagram full(mesh);
+    EXPECT_TRUE(full.has_downward());
+    EXPECT_TRUE(full.has_upward());
+
+    HasseDiagram down(mesh, HasseDiagram::DOWNWARD);
+    EXPECT_TRUE(down.has_downward());
+    EXPECT_FALSE(down.has_upward());
+    EXPECT_THAT(down.out_vertices(HasseIndex(1)),
+                ElementsAre(HasseIndex(7), HasseIndex(9), HasseIndex(10)));
+    EXPECT_THROW({ auto s = down.in_vertices(HasseIndex(3)); }, Exception);
+
+    HasseDiagram up(mesh, HasseDiagram::UPWARD);
+    EXPECT_FALSE(up.has_downward());
+    EXPECT_TRUE(up.has_upward());
+    EXPECT_THAT(up.in_vertices(HasseIndex(3)),
+                ElementsAre(HasseIndex(6), HasseIndex(7), HasseIndex(9)));
+    EXPECT_THROW({ auto s = up.out_vertices(HasseIndex(1)); }, Exception);
+
+    // 11 nodes and 16 connections in each direction with 32-bit offsets. Vectors can reserve more
+    // than they hold, so only the lower bound is exact.
+    const std::size_t one_way = 12 * sizeof(u32) + 16 * sizeof(HasseIndex);
+    EXPECT_GE(down.memory_usage(), one_way);
+    EXPECT_GE(up.memory_usage(), one_way);
+    EXPECT_GE(full.memory_usage(), 2 * one_way);
+}
@@ -31,3 +31,47 @@ TEST(IOTest, export_geom)
     IO::export_geometry(shapes, "box.step");
     IO::export_geometry(shapes, "box.iges");
 }
+
+TEST(IOTest, export_import_kmesh)
+{
+    std::vector<Point> pts = { Point(0, 0, 0), Point(1, 0, 0), Point(1, 1, 0), Point(0, 1, 0) };
+    std::vector<Element> elems = { Element::Quad4({ 0, 1, 2, 3 }) };
+    auto mesh = Ptr<Mesh>::alloc(pts, elems);
+    mesh->set_cell_set(3, { 0 });
+
+    auto fname = fs::temp_directory_path() / ("krado_" + std::to_string(rand()) + ".kmesh");
+    IO::export_mesh(mesh, fname);
+    auto mesh_rd = IO::import_mesh(fname);
+    EXPECT_EQ(mesh_rd->num_points(), 4);
+    EXPECT_EQ(mesh_rd->num_elements(), 1);
+    EXPECT_THAT(mesh_rd->cell_set(3), testing::ElementsAre(0));
+    fs::remove(fname);
+}
+
+TEST(IOTest, export_import_gmsh)
+{
+    std::vector<Point> pts = { Point(0, 0, 0), Point(1, 0, 0), Point(1, 1, 0), Point(0, 1, 0) };
+    std::vector<Element> elems = { Element::Quad4({ 0, 1, 2, 3 }) };
+    auto mesh = Ptr<Mesh>::alloc(pts, elems);
+    mesh->set_cell_set(3, { 0 });
+
+    auto fname = fs::temp_directory_path() / ("krado_" + std::to_string(rand()) + ".msh");
+    IO::export_mesh(mesh, fname);
+    auto mesh_rd = IO::import_mesh(fname);
+    EXPECT_EQ(mesh_rd->num_points(), 4);
+    EXPECT_EQ(mesh_rd->num_elements(), 1);
+    EXPECT_THAT(mesh_rd->cell_set(3), testing::ElementsAre(0));
+    fs::remove(fname);
+}
+
+TEST(IOTest, export_exodusii_options_other_format)
+{
+    std::vector<Point> pts = { Point(0, 0, 0), Point(1, 0, 0), Point(1, 1, 0) };
+    std::vector<Element> elems = { Element::Tri3({ 0, 1, 2 }) };
+    auto mesh = Ptr<Mesh>::alloc(pts, elems);
+
+    ExodusIIFile::Options opts;
+    opts.format = ExodusIIFile::Format::NETCDF4;
+    EXPECT_THROW(IO::export_mesh(mesh, "mesh.msh", opts), Exception);
+    EXPECT_THROW(IO::export_mesh(mesh, "mesh.kmesh", opts), Exception);
+}
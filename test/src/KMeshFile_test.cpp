@@ -0,0 +1,169 @@
+#include "gmock/gmock.h"
+#include "ExceptionTestMacros.h"
+#include "krado/kmesh_file.h"
+#include "krado/element.h"
+#include "krado/mesh.h"
+#include "krado/point.h"
+#include <filesystem>
+#include <fstream>
+
+using namespace krado;
+using namespace testing;
+namespace fs = std::filesystem;
+
+namespace {
+
+Ptr<Mesh>
+build_mesh()
+{
+    std::vector<Point> pts = { Point(0, 0, 0), Point(1, 0, 0), Point(1, 1, 0),
+                               Point(0, 1, 0), Point(2, 0, 0), Point(2, 1, 0) };
+    std::vector<Element> elems = { Element::Quad4({ 0, 1, 2, 3 }),
+                                   Element::Tri3({ 1, 4, 5 }),
+                                   Element::Tri3({ 1, 5, 2 }) };
+    auto mesh = Ptr<Mesh>::alloc(pts, elems);
+    mesh->set_cell_set(1, { 0 });
+    mesh->set_cell_set(2, { 1, 2 });
+    mesh->set_cell_set_name(2, "tris");
+    mesh->set_side_set(10, { SideEntry(0, 3), SideEntry(1, 1) });
+    mesh->set_side_set_name(10, "outer");
+    mesh->set_node_set(20, { 0, 3 });
+    mesh->set_node_set_name(20, "left");
+    return mesh;
+}
+
+/// Overwrite item `idx` of a section of a `.kmesh` file
+void
+overwrite_item(const fs::path & fname, u32 kind, std::size_t idx, u64 value, u32 width = 0)
+{
+    std::fstream f(fname, std::ios::in | std::ios::out | std::ios::binary);
+    u64 n_sections;
+    f.seekg(16);
+    f.read(reinterpret_cast<char *>(&n_sections), sizeof(n_sections));
+    for (u64 i = 0; i < n_sections; ++i) {
+        // kind, item size, offset, count
+        u32 entry_kind, item_size;
+        u64 offset;
+        f.seekg(64 + 32 * i);
+        f.read(reinterpret_cast<char *>(&entry_kind), sizeof(entry_kind));
+        f.read(reinterpret_cast<char *>(&item_size), sizeof(item_size));
+        f.read(reinterpret_cast<char *>(&offset), sizeof(offset));
+        if (entry_kind == kind) {
+            // `width` addresses fields inside records larger than `value`
+            if (width != 0)
+                item_size = width;
+            f.seekp(offset + idx * item_size);
+            // little-endian machines only, like the files themselves
+            f.write(reinterpret_cast<const char *>(&value), item_size);
+            return;
+        }
+    }
+    FAIL() << "Section " << kind << " not found";
+}
+
+} // namespace
+
+TEST(KMeshFileTest, round_trip)
+{
+    auto mesh = build_mesh();
+    mesh->set_up();
+
+    auto fname = fs::temp_directory_path() / ("krado_" + std::to_string(rand()) + ".kmesh");
+    KMeshFile(fname).write(mesh);
+    EXPECT_EQ(fs::file_size(fname) % 64, 0);
+
+    auto mesh_rd = KMeshFile(fname).read();
+    ASSERT_EQ(mesh_rd->num_points(), 6);
+    for (Index i = 0; i < 6; ++i)
+        EXPECT_EQ(mesh_rd->point(i), mesh->point(i));
+    ASSERT_EQ(mesh_rd->num_elements(), 3);
+    EXPECT_EQ(mesh_rd->element(0).type(), ElementType::QUAD4);
+    EXPECT_THAT(mesh_rd->element(0).indices(), ElementsAre(0, 1, 2, 3));
+    EXPECT_EQ(mesh_rd->element(2).type(), ElementType::TRI3);
+    EXPECT_THAT(mesh_rd->element(2).indices(), ElementsAre(1, 5, 2));
+
+    EXPECT_THAT(mesh_rd->cell_set_ids(), ElementsAre(1, 2));
+    EXPECT_THAT(mesh_rd->cell_set(2), ElementsAre(1, 2));
+    EXPECT_EQ(mesh_rd->cell_set_name(2).value(), "tris");
+    EXPECT_FALSE(mesh_rd->cell_set_name(1).has_value());
+    EXPECT_THAT(mesh_rd->side_set(10), ElementsAre(SideEntry(0, 3), SideEntry(1, 1)));
+    EXPECT_EQ(mesh_rd->side_set_name(10).value(), "outer");
+    EXPECT_THAT(mesh_rd->node_set(20), ElementsAre(0, 3));
+    EXPECT_EQ(mesh_rd->node_set_name(20).value(), "left");
+
+    // Hasse diagram is restored without calling `set_up`
+    const auto & hasse = mesh->hasse_diagram();
+    const auto & hasse_rd = mesh_rd->hasse_diagram();
+    ASSERT_TRUE(hasse_rd.has_downward());
+    ASSERT_TRUE(hasse_rd.has_upward());
+    EXPECT_EQ(hasse_rd.edges().first().value(), hasse.edges().first().value());
+    EXPECT_EQ(hasse_rd.edges().last().value(), hasse.edges().last().value());
+    EXPECT_THAT(mesh_rd->boundary_edges(), ElementsAreArray(mesh->boundary_edges()));
+    for (auto e : hasse.edges())
+        EXPECT_THAT(mesh_rd->support(e), ElementsAreArray(mesh->support(e)));
+
+    fs::remove(fname);
+}
+
+TEST(KMeshFileTest, without_hasse_diagram)
+{
+    auto mesh = build_mesh();
+
+    auto fname = fs::temp_directory_path() / ("krado_" + std::to_string(rand()) + ".kmesh");
+    KMeshFile(fname).write(mesh);
+    auto mesh_rd = KMeshFile(fname).read();
+    EXPECT_EQ(mesh_rd->num_elements(), 3);
+    EXPECT_FALSE(mesh_rd->hasse_diagram().has_downward());
+    EXPECT_FALSE(mesh_rd->hasse_diagram().has_upward());
+
+    fs::remove(fname);
+}
+
+TEST(KMeshFileTest, not_a_kmesh_file)
+{
+    auto fname = fs::temp_directory_path() / ("krado_" + std::to_string(rand()) + ".kmesh");
+    {
+        std::ofstream out(fname);
+        out << "not a mesh";
+    }
+    EXPECT_THROW_MSG(KMeshFile(fname).read(),
+                     fmt::format("'{}' is not a .kmesh file", fname.string()).c_str());
+    fs::remove(fname);
+
+    EXPECT_THROW(KMeshFile("non-existent.kmesh").read(), Exception);
+}
+
+TEST(KMeshFileTest, corrupted_contents)
+{
+    auto mesh = build_mesh();
+    mesh->set_up();
+
+    // section kind, item and invalid value
+    struct Case {
+        u32 kind;
+        std::size_t idx;
+        u64 value;
+        u32 width = 0;
+    };
+    std::vector<Case> cases = {
+        { 4, 0, 200 },    // element type
+        { 5, 1, 8 },      // decreasing element offsets
+        { 5, 3, 9 },      // last offset past the vertex IDs
+        { 6, 0, 6 },      // vertex ID
+        { 9, 0, 3 },      // cell set element
+        { 10, 0, 3 },     // side set element
+        { 11, 0, 4 },     // side of a quadrilateral
+        { 12, 0, 6 },     // node set node
+        { 14, 6, 1, 4 },  // Hasse cell range not starting at 0
+        { 14, 1, 8, 4 },  // Hasse vertex range not matching the points
+        { 16, 0, 1000 },  // Hasse diagram node
+    };
+    for (auto & c : cases) {
+        auto fname = fs::temp_directory_path() / ("krado_" + std::to_string(rand()) + ".kmesh");
+        KMeshFile(fname).write(mesh);
+        overwrite_item(fname, c.kind, c.idx, c.value, c.width);
+        EXPECT_THROW_MSG(KMeshFile(fname).read(),
+                         fmt::format("Corrupted .kmesh file '{}'", fname.string()).c_str());
+        fs::remove(fname);
+    }
+}
@@ -0,0 +1,108 @@
+#include "gmock/gmock.h"
+#include "krado/mesh_builder.h"
+#include "krado/mesh.h"
+#include "krado/exception.h"
+
+using namespace krado;
+using namespace testing;
+
+namespace {
+
+Ptr<Mesh>
+square()
+{
+    // clang-format off
+    std::vector<Point> pts = {
+        Point(0., 0.),
+        Point(1., 0.),
+        Point(0., 1.),
+        Point(1., 1.)
+    };
+    std::vector<Element> elems = {
+        Element::Tri3({ 0, 1, 2 }),
+        Element::Tri3({ 2, 1, 3 })
+    };
+    // clang-format on
+    auto mesh = Ptr<Mesh>::alloc(pts, elems);
+    mesh->set_cell_set(1, { 0, 1 });
+    mesh->set_cell_set_name(1, "sq");
+    mesh->set_side_set(10, { SideEntry(0, 0), SideEntry(1, 2) });
+    mesh->set_side_set_name(10, "bottom");
+    mesh->set_node_set(20, { 0, 3 });
+    return mesh;
+}
+
+} // namespace
+
+TEST(MeshBuilderTest, add)
+{
+    auto sq = square();
+
+    MeshBuilder builder;
+    builder.add(sq);
+    builder.add(sq->translated(2., 0.));
+    builder.add(sq->translated(4., 0.));
+    EXPECT_EQ(builder.num_points(), 12);
+    EXPECT_EQ(builder.num_elements(), 6);
+
+    auto mesh = builder.build();
+    EXPECT_EQ(builder.num_points(), 0);
+    EXPECT_EQ(builder.num_elements(), 0);
+
+    ASSERT_EQ(mesh->num_points(), 12);
+    EXPECT_EQ(mesh->point(5), Point(3., 0.));
+    ASSERT_EQ(mesh->num_elements(), 6);
+    EXPECT_THAT(mesh->element(1).indices(), ElementsAre(2, 1, 3));
+    EXPECT_THAT(mesh->element(2).indices(), ElementsAre(4, 5, 6));
+    EXPECT_THAT(mesh->element(5).indices(), ElementsAre(10, 9, 11));
+
+    EXPECT_THAT(mesh->cell_set(1), ElementsAre(0, 1, 2, 3, 4, 5));
+    EXPECT_EQ(mesh->cell_set_name(1), "sq");
+    EXPECT_THAT(mesh->side_set(10),
+                ElementsAre(SideEntry(0, 0),
+                            SideEntry(1, 2),
+                            SideEntry(2, 0),
+                            SideEntry(3, 2),
+                            SideEntry(4, 0),
+                            SideEntry(5, 2)));
+    EXPECT_EQ(mesh->side_set_name(10), "bottom");
+    EXPECT_THAT(mesh->node_set(20), ElementsAre(0, 3, 4, 7, 8, 11));
+    EXPECT_FALSE(mesh->node_set_name(20).has_value());
+}
+
+TEST(MeshBuilderTest, add_entities)
+{
+    MeshBuilder builder;
+    builder.reserve(3, 1);
+    auto a = builder.add_point(Point(0., 0.));
+    auto b = builder.add_point(Point(1., 0.));
+    auto c = builder.add_point(Point(0., 1.));
+    auto e = builder.add_element(Element::Tri3({ a, b, c }));
+    builder.add_to_cell_set(3, e);
+    builder.set_cell_set_name(3, "tri");
+    builder.add_to_side_set(4, SideEntry(e, 1));
+    builder.set_side_set_name(4, "diag");
+    builder.add_to_node_set(5, c);
+    builder.set_node_set_name(5, "top");
+    builder.add(square());
+
+    auto mesh = builder.build();
+    ASSERT_EQ(mesh->num_points(), 7);
+    ASSERT_EQ(mesh->num_elements(), 3);
+    EXPECT_THAT(mesh->element(0).indices(), ElementsAre(0, 1, 2));
+    EXPECT_THAT(mesh->element(1).indices(), ElementsAre(3, 4, 5));
+    EXPECT_THAT(mesh->cell_set_ids(), ElementsAre(1, 3));
+    EXPECT_THAT(mesh->cell_set(3), ElementsAre(0));
+    EXPECT_EQ(mesh->cell_set_name(3), "tri");
+    EXPECT_THAT(mesh->side_set(4), ElementsAre(SideEntry(0, 1)));
+    EXPECT_EQ(mesh->side_set_name(4), "diag");
+    EXPECT_THAT(mesh->node_set(5), ElementsAre(2));
+    EXPECT_EQ(mesh->node_set_name(5), "top");
+}
+
+TEST(MeshBuilderTest, null_mesh)
+{
+    MeshBuilder builder;
+    Ptr<const Mesh> mesh;
+    EXPECT_THROW(builder.add(mesh), Exception);
+}
@@ -0,0 +1,131 @@
+#include "gmock/gmock.h"
+#include "builder.h"
+#include "krado/geom_model.h"
+#include "krado/mesh_cache.h"
+#include "krado/mesh_curve.h"
+#include "krado/mesh_curve_vertex.h"
+#include "krado/mesh_element.h"
+#include "krado/mesh_surface.h"
+#include "krado/mesh_surface_vertex.h"
+#include "krado/scheme/equal.h"
+#include "krado/scheme/structured.h"
+#include "TopoDS.hxx"
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+using namespace krado;
+namespace fs = std::filesystem;
+
+namespace {
+
+std::size_t
+count_files(const fs::path & dir)
+{
+    return std::distance(fs::directory_iterator(dir), fs::directory_iterator());
+}
+
+/// Mesh 3x2 rectangle with structured quads
+Ptr<MeshSurface>
+mesh_rect(GeomModel & model, int h_intervals)
+{
+    SchemeEqual::Options opts_h;
+    opts_h.intervals = h_intervals;
+    SchemeEqual::Options opts_v;
+    opts_v.intervals = 2;
+    model.curve(1)->set_scheme<SchemeEqual>(opts_h);
+    model.curve(2)->set_scheme<SchemeEqual>(opts_v);
+    model.curve(3)->set_scheme<SchemeEqual>(opts_h);
+    model.curve(4)->set_scheme<SchemeEqual>(opts_v);
+    for (int i = 1; i <= 4; ++i)
+        model.mesh_curve(i);
+
+    SchemeStructured::Options opts_struct;
+    model.surface(1)->set_scheme<SchemeStructured>(opts_struct);
+    model.mesh_surface(1);
+    return model.surface(1);
+}
+
+} // namespace
+
+TEST(MeshCacheTest, restore)
+{
+    auto dir = fs::temp_directory_path() / ("krado_cache_" + std::to_string(rand()));
+    auto rect = testing::build_rect(Point(0, 0, 0), Point(3, 2, 0));
+
+    GeomModel model1(rect);
+    model1.set_mesh_cache(dir);
+    auto srf1 = mesh_rect(model1, 3);
+    // 4 curves and 1 surface
+    EXPECT_EQ(count_files(dir), 5);
+
+    GeomModel model2(testing::build_rect(Point(0, 0, 0), Point(3, 2, 0)));
+    model2.set_mesh_cache(dir);
+    auto srf2 = mesh_rect(model2, 3);
+    EXPECT_EQ(count_files(dir), 5);
+
+    for (int i = 1; i <= 4; ++i) {
+        auto cvs1 = model1.curve(i)->curve_vertices();
+        auto cvs2 = model2.curve(i)->curve_vertices();
+        ASSERT_EQ(cvs1.size(), cvs2.size());
+        for (std::size_t j = 0; j < cvs1.size(); ++j)
+            EXPECT_DOUBLE_EQ(cvs1[j]->parameter(), cvs2[j]->parameter());
+        EXPECT_EQ(model2.curve(i)->segments().size(), model1.curve(i)->segments().size());
+    }
+
+    ASSERT_EQ(srf2->quadrangles().size(), 6);
+    ASSERT_EQ(srf2->surface_vertices().size(), srf1->surface_vertices().size());
+    for (std::size_t i = 0; i < srf1->quadrangles().size(); ++i) {
+        auto v1 = srf1->quadrangles()[i].vertices();
+        auto v2 = srf2->quadrangles()[i].vertices();
+        for (std::size_t j = 0; j < v1.size(); ++j) {
+            EXPECT_DOUBLE_EQ(v1[j]->point().x, v2[j]->point().x);
+            EXPECT_DOUBLE_EQ(v1[j]->point().y, v2[j]->point().y);
+        }
+    }
+
+    // different scheme parameters give different meshes
+    GeomModel model3(rect);
+    model3.set_mesh_cache(dir);
+    auto srf3 = mesh_rect(model3, 4);
+    EXPECT_EQ(srf3->quadrangles().size(), 8);
+    EXPECT_EQ(count_files(dir), 8);
+
+    fs::remove_all(dir);
+}
+
+TEST(MeshCacheTest, corrupted_file)
+{
+    auto dir = fs::temp_directory_path() / ("krado_cache_" + std::to_string(rand()));
+    auto rect = testing::build_rect(Point(0, 0, 0), Point(3, 2, 0));
+
+    GeomModel model1(rect);
+    model1.set_mesh_cache(dir);
+    mesh_rect(model1, 3);
+
+    for (auto & entry : fs::directory_iterator(dir)) {
+        std::ofstream out(entry.path(), std::ios::binary | std::ios::trunc);
+        out << "KRMCACHE1garbage";
+    }
+
+    GeomModel model2(rect);
+    model2.set_mesh_cache(dir);
+    auto srf2 = mesh_rect(model2, 3);
+    EXPECT_EQ(srf2->quadrangles().size(), 6);
+    EXPECT_EQ(model2.curve(1)->curve_vertices().size(), 2);
+
+    fs::remove_all(dir);
+}
+
+TEST(MeshCacheTest, reversed_surface)
+{
+    auto rect = testing::build_rect(Point(0, 0, 0), Point(3, 2, 0));
+    const TopoDS_Face & face = rect;
+    GeomSurface rect_rev(TopoDS::Face(face.Reversed()));
+
+    GeomModel model1(rect);
+    GeomModel model2(rect_rev);
+    SchemeStructured scheme(SchemeStructured::Options {});
+    EXPECT_NE(MeshCache::fingerprint(model1.surface(1), scheme),
+              MeshCache::fingerprint(model2.surface(1), scheme));
+}
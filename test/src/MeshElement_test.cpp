@@ -3,6 +3,7 @@
 #include "krado/point.h"
 #include "krado/mesh_vertex.h"
 #include "krado/mesh_element.h"
+#include "krado/exception.h"
 
 using namespace krado;
 
@@ -56,3 +57,28 @@ TEST(MeshElementTest, barycenter)
     EXPECT_NEAR(bc.y, 2. / 3., 1e-15);
     EXPECT_NEAR(bc.z, 0., 1e-15);
 }
+
+TEST(MeshElementTest, vertices)
+{
+    auto tri_shape = testing::build_triangle(Point(0, 0, 0), 2);
+    auto gv0 = tri_shape.curves()[0].first_vertex();
+    auto gv1 = tri_shape.curves()[1].first_vertex();
+    auto gv2 = tri_shape.curves()[2].last_vertex();
+
+    auto v0 = Ptr<MeshVertex>::alloc(1, gv0);
+    auto v1 = Ptr<MeshVertex>::alloc(2, gv1);
+    auto v2 = Ptr<MeshVertex>::alloc(3, gv2);
+
+    auto tri = MeshElement::Tri3({ v0, v1, v2 });
+    EXPECT_EQ(tri.num_vertices(), 3);
+    ASSERT_EQ(tri.vertices().size(), 3);
+    EXPECT_EQ(tri.vertices()[0], v0);
+    EXPECT_EQ(tri.vertices()[2], v2);
+
+    tri.swap_vertices(0, 2);
+    EXPECT_EQ(tri.vertex(0), v2);
+    EXPECT_EQ(tri.vertex(2), v0);
+
+    std::vector<Ptr<MeshVertexAbstract>> too_many = { v0, v1, v2, v0, v1 };
+    EXPECT_THROW(MeshElement(ElementType::QUAD4, too_many), Exception);
+}
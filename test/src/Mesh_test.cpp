@@ -348,6 +348,139 @@ TEST(MeshTest, boundary_faces)
                                      HasseIndex(14)));
 }
 
+TEST(MeshTest, remove_duplicate_points_tolerance)
+{
+    // clang-format off
+    std::vector<Point> pts = {
+        Point(0., 0.),
+        Point(1., 0.),
+        Point(1., 1.),
+        Point(0., 1.),
+        Point(1. + 1e-9, 0.),
+        Point(2., 0.),
+        Point(2., 1.),
+        Point(1., 1. - 1e-9)
+    };
+    std::vector<Element> elems = {
+        Element::Quad4({ 0, 1, 2, 3 }),
+        Element::Quad4({ 4, 5, 6, 7 })
+    };
+    // clang-format on
+
+    Mesh mesh(pts, elems);
+    mesh.set_node_set(1, { 1, 4, 7 });
+    mesh.remove_duplicate_points(1e-6);
+
+    auto pnts = mesh.points();
+    ASSERT_EQ(pnts.size(), 6);
+    EXPECT_EQ(pnts[4], Point(2., 0.));
+    EXPECT_EQ(pnts[5], Point(2., 1.));
+    EXPECT_THAT(mesh.element(0).indices(), ElementsAre(0, 1, 2, 3));
+    EXPECT_THAT(mesh.element(1).indices(), ElementsAre(1, 4, 5, 2));
+    EXPECT_THAT(mesh.node_set(1), ElementsAre(1, 2));
+}
+
+TEST(MeshTest, remove_duplicate_points_exact)
+{
+    // clang-format off
+    std::vector<Point> pts = {
+        Point(0.),
+        Point(1.),
+        Point(1.),
+        Point(1. + 1e-9),
+        Point(2.)
+    };
+    std::vector<Element> elems = {
+        Element::Line2({ 0, 1 }),
+        Element::Line2({ 2, 3 }),
+        Element::Line2({ 3, 4 })
+    };
+    // clang-format on
+
+    Mesh mesh(pts, elems);
+    mesh.remove_duplicate_points(0.);
+
+    ASSERT_EQ(mesh.points().size(), 4);
+    EXPECT_THAT(mesh.element(0).indices(), ElementsAre(0, 1));
+    EXPECT_THAT(mesh.element(1).indices(), ElementsAre(1, 2));
+    EXPECT_THAT(mesh.element(2).indices(), ElementsAre(2, 3));
+}
+
+TEST(MeshTest, boundary_sides_1d)
+{
+    // clang-format off
+    std::vector<Point> pts = {
+        Point(0.),
+        Point(1.),
+        Point(2.)
+    };
+    std::vector<Element> elems = {
+        Element::Line2({ 0, 1 }),
+        Element::Line2({ 1, 2 })
+    };
+    // clang-format on
+
+    Mesh mesh(pts, elems);
+    EXPECT_THAT(boundary_sides(mesh), ElementsAre(SideEntry(0, 0), SideEntry(1, 1)));
+}
+
+TEST(MeshTest, boundary_sides_2d)
+{
+    // clang-format off
+    std::vector<Point> pts = {
+        Point(0., 0.),
+        Point(1., 0.),
+        Point(0., 1.),
+        Point(1., 1.)
+    };
+    std::vector<Element> elems = {
+        Element::Tri3({ 0, 1, 2 }),
+        Element::Tri3({ 2, 1, 3 })
+    };
+    // clang-format on
+
+    Mesh mesh(pts, elems);
+    auto sides = boundary_sides(mesh);
+    EXPECT_THAT(sides,
+                ElementsAre(SideEntry(0, 0), SideEntry(0, 2), SideEntry(1, 1), SideEntry(1, 2)));
+
+    mesh.set_up();
+    EXPECT_THAT(create_side_set(mesh, mesh.boundary_edges()), UnorderedElementsAreArray(sides));
+}
+
+TEST(MeshTest, boundary_sides_3d)
+{
+    // clang-format off
+    std::vector<Point> pts = {
+        Point(0., 0., 0.),
+        Point(1., 0., 0.),
+        Point(1., 1., 0.),
+        Point(0., 1., 0.),
+        Point(0., 0., 1.),
+        Point(1., 0., 1.),
+        Point(1., 1., 1.),
+        Point(0., 1., 1.),
+        Point(2., 0., 0.),
+        Point(2., 1., 0.),
+        Point(2., 0., 1.),
+        Point(2., 1., 1.)
+    };
+    std::vector<Element> elems = {
+        Element::Hex8({ 0, 1, 2, 3, 4, 5, 6, 7 }),
+        Element::Hex8({ 1, 8, 9, 2, 5, 10, 11, 6 })
+    };
+    // clang-format on
+
+    Mesh mesh(pts, elems);
+    auto sides = boundary_sides(mesh);
+    EXPECT_EQ(sides.size(), 10);
+    EXPECT_THAT(sides, Not(Contains(SideEntry(0, 3))));
+    EXPECT_THAT(sides, Not(Contains(SideEntry(1, 2))));
+
+    mesh.set_up();
+    EXPECT_THAT(create_side_set(mesh, mesh.boundary_faces()), UnorderedElementsAreArray(sides));
+}
+
 TEST(MeshTest, centroid_2d)
 {
     // clang-format off
@@ -533,3 +666,129 @@ TEST(MeshTest, mirrored)
                                      SideEntry(45, 0),
                                      SideEntry(46, 1)));
 }
+
+namespace {
+
+/// Quad mesh of `nx` x `ny` unit squares with scrambled node and element numbering
+Ptr<Mesh>
+scrambled_grid(Index nx, Index ny)
+{
+    const Index n_nodes = (nx + 1) * (ny + 1);
+    const Index n_elems = nx * ny;
+    // 7919 is a prime, so multiplying by it modulo the size is a permutation
+    auto node = [&](Index i, Index j) { return (7919 * (j * (nx + 1) + i)) % n_nodes; };
+
+    std::vector<Point> pts(n_nodes, Point(0, 0));
+    for (Index j = 0; j <= ny; ++j)
+        for (Index i = 0; i <= nx; ++i)
+            pts[node(i, j)] = Point(i, j);
+    std::vector<Element> elems(n_elems, Element::Quad4({ 0, 0, 0, 0 }));
+    for (Index j = 0; j < ny; ++j)
+        for (Index i = 0; i < nx; ++i)
+            elems[(7919 * (j * nx + i)) % n_elems] = Element::Quad4(
+                { node(i, j), node(i + 1, j), node(i + 1, j + 1), node(i, j + 1) });
+    return Ptr<Mesh>::alloc(pts, elems);
+}
+
+/// Sorted element centroids (independent of the numbering)
+std::vector<std::tuple<double, double, double>>
+element_centroids(const Mesh & mesh)
+{
+    std::vector<std::tuple<double, double, double>> ctrs;
+    for (auto elem : mesh.elements()) {
+        auto ctr = mesh.compute_centroid(elem.indices());
+        ctrs.emplace_back(ctr.x, ctr.y, ctr.z);
+    }
+    std::sort(ctrs.begin(), ctrs.end());
+    return ctrs;
+}
+
+} // namespace
+
+TEST(MeshTest, renumber)
+{
+    std::vector<Point> pts = { Point(0, 0), Point(1, 0), Point(1, 1), Point(0, 1), Point(2, 0) };
+    std::vector<Element> elems = { Element::Tri3({ 0, 1, 2 }),
+                                   Element::Tri3({ 0, 2, 3 }),
+                                   Element::Tri3({ 1, 4, 2 }) };
+    Mesh mesh(pts, elems);
+    mesh.set_cell_set(1, { 0, 2 });
+    mesh.set_side_set(2, { SideEntry(0, 0), SideEntry(2, 1), SideEntry(1, 2) });
+    mesh.set_node_set(3, { 0, 4 });
+
+    std::vector<Index> node_ids = { 4, 3, 2, 1, 0 };
+    std::vector<Index> elem_ids = { 2, 0, 1 };
+    mesh.renumber(node_ids, elem_ids);
+
+    EXPECT_EQ(mesh.point(0), Point(2, 0));
+    EXPECT_EQ(mesh.point(4), Point(0, 0));
+    EXPECT_EQ(mesh.element(0), Element::Tri3({ 4, 2, 1 }));
+    EXPECT_EQ(mesh.element(1), Element::Tri3({ 3, 0, 2 }));
+    EXPECT_EQ(mesh.element(2), Element::Tri3({ 4, 3, 2 }));
+    EXPECT_THAT(mesh.cell_set(1), ElementsAre(1, 2));
+    EXPECT_THAT(mesh.side_set(2), ElementsAre(SideEntry(0, 2), SideEntry(1, 1), SideEntry(2, 0)));
+    EXPECT_THAT(mesh.node_set(3), ElementsAre(0, 4));
+}
+
+TEST(MeshTest, node_bandwidth)
+{
+    std::vector<Point> pts = { Point(0, 0), Point(1, 0), Point(1, 1), Point(0, 1) };
+    Mesh mesh(pts, { Element::Tri3({ 0, 1, 2 }), Element::Tri3({ 0, 2, 3 }) });
+    EXPECT_EQ(node_bandwidth(mesh), 3);
+}
+
+TEST(MeshTest, reorder_rcm)
+{
+    auto mesh = scrambled_grid(40, 10);
+    auto ctrs = element_centroids(*mesh);
+    auto bw = node_bandwidth(*mesh);
+
+    reorder(*mesh, Ordering::RCM);
+    EXPECT_EQ(element_centroids(*mesh), ctrs);
+    // banded numbering goes across the short side of the grid
+    EXPECT_LT(node_bandwidth(*mesh), bw);
+    EXPECT_LE(node_bandwidth(*mesh), 2 * 11 + 1);
+    // elements are sorted by their lowest node
+    for (Index e = 1; e < mesh->num_elements(); ++e) {
+        auto a = mesh->element(e - 1).indices();
+        auto b = mesh->element(e).indices();
+        EXPECT_LE(*std::min_element(a.begin(), a.end()), *std::min_element(b.begin(), b.end()));
+    }
+}
+
+TEST(MeshTest, reorder_hilbert)
+{
+    auto mesh = scrambled_grid(16, 16);
+    mesh->set_cell_set(1, { 0, 1, 2 });
+    auto ctrs = element_centroids(*mesh);
+    auto bw = node_bandwidth(*mesh);
+
+    reorder(*mesh, Ordering::HILBERT);
+    EXPECT_EQ(element_centroids(*mesh), ctrs);
+    EXPECT_LT(node_bandwidth(*mesh), bw);
+    EXPECT_EQ(mesh->cell_set(1).size(), 3);
+    // consecutive elements along the Hilbert curve share an edge
+    for (Index e = 1; e < mesh->num_elements(); ++e) {
+        auto a = mesh->compute_centroid(mesh->element(e - 1).indices());
+        auto b = mesh->compute_centroid(mesh->element(e).indices());
+        EXPECT_DOUBLE_EQ(std::abs(a.x - b.x) + std::abs(a.y - b.y), 1.);
+    }
+    // nodes are numbered in the order of first use
+    EXPECT_THAT(mesh->element(0).indices(), ElementsAre(0, 1, 2, 3));
+}
+
+TEST(MeshTest, reorder_morton)
+{
+    auto mesh = scrambled_grid(8, 8);
+    auto ctrs = element_centroids(*mesh);
+    auto bw = node_bandwidth(*mesh);
+
+    reorder(*mesh, Ordering::MORTON);
+    EXPECT_EQ(element_centroids(*mesh), ctrs);
+    EXPECT_LT(node_bandwidth(*mesh), bw);
+    // the Z-curve visits the lower left 2x2 block first
+    EXPECT_EQ(mesh->compute_centroid(mesh->element(0).indices()), Point(0.5, 0.5));
+    EXPECT_EQ(mesh->compute_centroid(mesh->element(1).indices()), Point(0.5, 1.5));
+    EXPECT_EQ(mesh->compute_centroid(mesh->element(2).indices()), Point(1.5, 0.5));
+    EXPECT_EQ(mesh->compute_centroid(mesh->element(3).indices()), Point(1.5, 1.5));
+}
@@ -13,6 +13,8 @@
 #include "krado/line.h"
 #include "krado/arc_of_circle.h"
 #include "krado/step_file.h"
+#include "krado/pattern.h"
+#include "krado/transform.h"
 
 using namespace krado;
 using namespace testing;
@@ -128,6 +130,111 @@ TEST(OperationsTest, combine_meshes)
     EXPECT_THAT(cs101, ElementsAre(1, 5, 9, 13));
 }
 
+TEST(OperationsTest, combine_meshes_merge)
+{
+    std::vector<Point> pts2d = { Point(0.0, 0.0), Point(0.5, 0.0), Point(1.0, 0.0),
+                                 Point(0.0, 0.5), Point(0.5, 0.5), Point(1.0, 0.5),
+                                 Point(0.0, 1.0), Point(0.5, 1.0), Point(1.0, 1.0) };
+    std::vector<Element> elems2d = {
+        Element::Quad4({ 0, 1, 4, 3 }),
+        Element::Quad4({ 1, 2, 5, 4 }),
+        Element::Quad4({ 3, 4, 7, 6 }),
+        Element::Quad4({ 4, 5, 8, 7 }),
+    };
+
+    Mesh sq(pts2d, elems2d);
+    sq.set_cell_set(100, { 0, 2, 3 });
+    sq.set_cell_set(101, { 1 });
+    sq.set_side_set(10, { SideEntry(1, 1) });
+    sq.set_node_set(20, { 2, 5, 8 });
+
+    std::vector<Ptr<Mesh>> parts;
+    parts.push_back(sq.translated(0, 0, 0));
+    parts.push_back(sq.translated(1, 0, 0));
+    parts.push_back(sq.translated(0, 1, 0));
+    parts.push_back(sq.translated(1, 1, 0));
+
+    auto m = combine(parts, 1e-10);
+
+    EXPECT_EQ(m->num_elements(), 16);
+    EXPECT_EQ(m->num_points(), 25);
+    auto pnts = m->points();
+    EXPECT_EQ(pnts[9], Point(1.5, 0.0));
+    EXPECT_THAT(m->element(4).indices(), ElementsAre(2, 9, 11, 5));
+    EXPECT_THAT(m->element(8).indices(), ElementsAre(6, 7, 16, 15));
+
+    EXPECT_THAT(m->cell_set(101), ElementsAre(1, 5, 9, 13));
+    EXPECT_THAT(m->side_set(10),
+                ElementsAre(SideEntry(1, 1), SideEntry(5, 1), SideEntry(9, 1), SideEntry(13, 1)));
+    // x = 1 and x = 2
+    EXPECT_THAT(m->node_set(20), ElementsAre(2, 5, 8, 10, 12, 14, 17, 20, 22, 24));
+
+    // same as combining everything and removing duplicates afterwards
+    auto ref = combine(parts);
+    ref->remove_duplicate_points(1e-10);
+    ASSERT_EQ(ref->num_points(), m->num_points());
+    for (auto i : make_range(m->num_points()))
+        EXPECT_EQ(ref->point(i), m->point(i));
+    for (auto i : make_range(m->num_elements()))
+        EXPECT_THAT(ref->element(i).indices(), ElementsAreArray(m->element(i).indices()));
+}
+
+TEST(OperationsTest, instantiate)
+{
+    std::vector<Point> pts2d = { Point(0.0, 0.0), Point(0.5, 0.0), Point(1.0, 0.0),
+                                 Point(0.0, 0.5), Point(0.5, 0.5), Point(1.0, 0.5),
+                                 Point(0.0, 1.0), Point(0.5, 1.0), Point(1.0, 1.0) };
+    std::vector<Element> elems2d = {
+        Element::Quad4({ 0, 1, 4, 3 }),
+        Element::Quad4({ 1, 2, 5, 4 }),
+        Element::Quad4({ 3, 4, 7, 6 }),
+        Element::Quad4({ 4, 5, 8, 7 }),
+    };
+
+    Mesh sq(pts2d, elems2d);
+    sq.set_cell_set(100, { 0, 2, 3 });
+    sq.set_cell_set(101, { 1 });
+    sq.set_cell_set_name(101, "fuel");
+    sq.set_side_set(10, { SideEntry(1, 1) });
+    sq.set_node_set(20, { 2, 5, 8 });
+
+    std::vector<Trsf> placements = { Trsf::translated(0, 0, 0),
+                                     Trsf::translated(1, 0, 0),
+                                     Trsf::translated(0, 1, 0),
+                                     Trsf::translated(1, 1, 0) };
+    auto m = instantiate(sq, placements, 1e-10);
+
+    EXPECT_EQ(m->num_elements(), 16);
+    EXPECT_EQ(m->num_points(), 25);
+    EXPECT_THAT(m->cell_set(101), ElementsAre(1, 5, 9, 13));
+    EXPECT_EQ(m->cell_set_name(101), "fuel");
+    EXPECT_THAT(m->side_set(10),
+                ElementsAre(SideEntry(1, 1), SideEntry(5, 1), SideEntry(9, 1), SideEntry(13, 1)));
+    EXPECT_THAT(m->node_set(20), ElementsAre(2, 5, 8, 10, 12, 14, 17, 20, 22, 24));
+
+    // same as combining transformed copies
+    std::vector<Ptr<Mesh>> parts;
+    for (auto & tr : placements)
+        parts.push_back(sq.transformed(tr));
+    auto ref = combine(parts, 1e-10);
+    ASSERT_EQ(ref->num_points(), m->num_points());
+    for (auto i : make_range(m->num_points()))
+        EXPECT_EQ(ref->point(i), m->point(i));
+    for (auto i : make_range(m->num_elements()))
+        EXPECT_THAT(ref->element(i).indices(), ElementsAreArray(m->element(i).indices()));
+
+    // copies placed by a pattern
+    Pattern pattern({ Point(0, 0), Point(1, 0), Point(0, 1), Point(1, 1) });
+    auto mp = instantiate(sq, pattern, 1e-10);
+    ASSERT_EQ(mp->num_points(), m->num_points());
+    for (auto i : make_range(m->num_points()))
+        EXPECT_EQ(mp->point(i), m->point(i));
+
+    Ptr<const Mesh> null;
+    EXPECT_THROW(instantiate(null, placements, 1e-10), Exception);
+    EXPECT_THROW(instantiate(null, pattern, 1e-10), Exception);
+}
+
 TEST(OperationsTest, extrude)
 {
     auto circ = Circle::create(Point(0, 0, 0), 2);
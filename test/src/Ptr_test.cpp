@@ -1,6 +1,7 @@
 #include <gmock/gmock.h>
 #include "krado/ptr.h"
 #include "krado/exception.h"
+#include <thread>
 
 using namespace krado;
 
@@ -60,6 +61,49 @@ private:
     int b;
 };
 
+class Counted {
+public:
+    explicit Counted(int * n_dtors) : n_dtors(n_dtors) {}
+    ~Counted() { ++*this->n_dtors; }
+
+private:
+    int * n_dtors;
+};
+
+class Tagged {
+public:
+    Tagged() : t(7) {}
+    virtual ~Tagged() = default;
+
+    int
+    tag() const
+    {
+        return this->t;
+    }
+
+private:
+    int t;
+};
+
+class Multi : public Derived, public Tagged {
+public:
+    Multi() : c(3) {}
+
+    int
+    extra() const
+    {
+        return this->c;
+    }
+
+private:
+    int c;
+};
+
+class Throwing {
+public:
+    Throwing() { throw Exception("ctor failed"); }
+};
+
 std::vector<Ptr<Derived>>
 create_objs()
 {
@@ -239,3 +283,66 @@ TEST(PtrTest, op_dynamic_cast)
     auto c = Ptr<Derived>::downcast(a);
     EXPECT_EQ(c->value(), 2);
 }
+
+TEST(PtrTest, destroy_once)
+{
+    int n_dtors = 0;
+    {
+        auto a = Ptr<Counted>::alloc(&n_dtors);
+        auto b = a;
+        Ptr<Counted> c(new Counted(&n_dtors));
+        c = b;
+        EXPECT_EQ(n_dtors, 1);
+        EXPECT_EQ(a.ref_count(), 3);
+    }
+    EXPECT_EQ(n_dtors, 2);
+}
+
+TEST(PtrTest, alloc_ctor_throws)
+{
+    EXPECT_THROW({ auto p = Ptr<Throwing>::alloc(); }, Exception);
+}
+
+TEST(PtrTest, copy_from_threads)
+{
+    auto d = Ptr<Derived>::alloc();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+        threads.emplace_back([&d] {
+            for (int i = 0; i < 10000; ++i) {
+                Ptr<Base> b = d;
+                auto c = b;
+            }
+        });
+    for (auto & th : threads)
+        th.join();
+    EXPECT_EQ(d.ref_count(), 1);
+}
+
+TEST(PtrTest, secondary_base)
+{
+    auto m = Ptr<Multi>::alloc();
+    Ptr<Tagged> t = m;
+    EXPECT_EQ(static_cast<void *>(t.get()), static_cast<void *>(static_cast<Tagged *>(m.get())));
+    EXPECT_EQ(t->tag(), 7);
+    EXPECT_EQ((*t).tag(), 7);
+    EXPECT_EQ(m.ref_count(), 2);
+
+    Ptr<Tagged> t2;
+    t2 = m;
+    EXPECT_EQ(t2->tag(), 7);
+
+    auto back = dynamic_ptr_cast<Multi>(t);
+    ASSERT_TRUE(back);
+    EXPECT_EQ(back.get(), m.get());
+    EXPECT_EQ(back->extra(), 3);
+
+    auto down = Ptr<Multi>::cast(t2);
+    EXPECT_EQ(down.get(), m.get());
+    EXPECT_EQ(down->value(), 2);
+
+    Ptr<Tagged> moved = std::move(t2);
+    EXPECT_EQ(moved->tag(), 7);
+    EXPECT_EQ(t2.get(), nullptr);
+    EXPECT_EQ(m.ref_count(), 5);
+}
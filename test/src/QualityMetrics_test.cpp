@@ -251,3 +251,41 @@ TEST(QualityMetricsTest, unsupported_metric)
 
     EXPECT_THROW(compute_quality(mesh, qm::Metric::SKEWNESS), krado::Exception);
 }
+
+TEST(QualityMetricsTest, wrong_number_of_vertices)
+{
+    // e.g. a HEX27 block read as HEX8
+    std::vector<Point> points(27, Point(0, 0, 0));
+    std::vector<Index> ids(27);
+    for (Index i = 0; i < 27; ++i)
+        ids[i] = i;
+    Connectivity connect({ ElementType::HEX8 }, { 0, 27 }, ids);
+    Mesh mesh(Coordinates(points), connect);
+
+    EXPECT_THROW(compute_quality(mesh, qm::Metric::ASPECT_RATIO), krado::Exception);
+}
+
+TEST(QualityMetricsTest, compute_metric_points)
+{
+    std::vector<Point> points = { Point(0, 0, 0), Point(1, 0, 0), Point(0, 1, 0) };
+    std::vector<Element> elements = { Element::Tri3({ 0, 1, 2 }) };
+    Mesh mesh(points, elements);
+
+    EXPECT_DOUBLE_EQ(qm::compute_metric(ElementType::TRI3, points, qm::Metric::MIN_ANGLE),
+                     qm::min_angle<ElementType::TRI3>(mesh.element(0), mesh));
+    EXPECT_DOUBLE_EQ(qm::compute_metric(ElementType::TRI3, points, qm::Metric::GAMMA),
+                     qm::gamma<ElementType::TRI3>(mesh.element(0), mesh));
+
+    EXPECT_THROW(qm::compute_metric(ElementType::QUAD4, points, qm::Metric::MIN_ANGLE),
+                 krado::Exception);
+    EXPECT_THROW(qm::compute_metric(ElementType::TRI3, points, qm::Metric::SKEWNESS),
+                 krado::Exception);
+}
+
+TEST(QualityMetricsTest, higher_is_better)
+{
+    EXPECT_TRUE(qm::higher_is_better(qm::Metric::MIN_ANGLE));
+    EXPECT_TRUE(qm::higher_is_better(qm::Metric::SCALED_JACOBIAN));
+    EXPECT_FALSE(qm::higher_is_better(qm::Metric::ASPECT_RATIO));
+    EXPECT_FALSE(qm::higher_is_better(qm::Metric::MAX_ANGLE));
+}
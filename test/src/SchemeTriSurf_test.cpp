@@ -10,6 +10,8 @@
 #include "krado/mesh_volume.h"
 #include "krado/scheme/trisurf.h"
 #include "krado/exodusii_file.h"
+#include <memory>
+#include <set>
 
 using namespace krado;
 
@@ -52,3 +54,71 @@ TEST(SchemeTriSurfTest, box)
     model.volume(1)->set_marker(100);
     model.mesh_volume(1);
 }
+
+TEST(SchemeTriSurfTest, cylinder_serial)
+{
+    auto cyl = testing::build_cylinder(Point(0, 0, 0), 0.75, 1.25);
+    GeomModel model(cyl);
+
+    SchemeTriSurf::Options opts;
+    opts.is_relative = true;
+    opts.linear_deflection = 1.;
+    opts.angular_deflection = 1.;
+    opts.in_parallel = false;
+    model.volume(1)->set_scheme<SchemeTriSurf>(opts);
+    model.volume(1)->set_marker(100);
+    model.mesh_volume(1);
+
+    EXPECT_EQ(model.surface(1)->triangles().size(), 26);
+    EXPECT_EQ(model.surface(2)->triangles().size(), 11);
+    EXPECT_EQ(model.surface(3)->triangles().size(), 11);
+
+    // surfaces share the vertices on their common curves
+    std::set<const MeshVertexAbstract *> side_vtxs;
+    for (auto & tri : model.surface(1)->triangles())
+        for (auto & v : tri.vertices())
+            side_vtxs.insert(v.get());
+    for (auto & curve : model.surface(2)->curves())
+        for (auto & v : curve->curve_vertices())
+            EXPECT_TRUE(side_vtxs.contains(v.get()));
+}
+
+TEST(SchemeTriSurfTest, parallel_matches_serial)
+{
+    auto mesh = [](bool in_parallel) {
+        auto cyl = testing::build_cylinder(Point(0, 0, 0), 0.75, 1.25);
+        auto model = std::make_unique<GeomModel>(cyl);
+        SchemeTriSurf::Options opts;
+        opts.is_relative = true;
+        opts.linear_deflection = 0.5;
+        opts.angular_deflection = 0.5;
+        opts.in_parallel = in_parallel;
+        model->volume(1)->set_scheme<SchemeTriSurf>(opts);
+        model->mesh_volume(1);
+        return model;
+    };
+    auto serial = mesh(false);
+    auto parallel = mesh(true);
+
+    for (int id = 1; id <= 3; ++id) {
+        auto srf_s = serial->surface(id);
+        auto srf_p = parallel->surface(id);
+
+        auto vtxs_s = srf_s->surface_vertices();
+        auto vtxs_p = srf_p->surface_vertices();
+        ASSERT_EQ(vtxs_p.size(), vtxs_s.size());
+        for (std::size_t i = 0; i < vtxs_s.size(); ++i)
+            EXPECT_EQ(vtxs_p[i]->point(), vtxs_s[i]->point());
+
+        auto tris_s = srf_s->triangles();
+        auto tris_p = srf_p->triangles();
+        ASSERT_EQ(tris_p.size(), tris_s.size());
+        for (std::size_t i = 0; i < tris_s.size(); ++i) {
+            auto v_s = tris_s[i].vertices();
+            auto v_p = tris_p[i].vertices();
+            ASSERT_EQ(v_p.size(), v_s.size());
+            for (std::size_t j = 0; j < v_s.size(); ++j)
+                EXPECT_EQ(v_p[j]->point(), v_s[j]->point());
+        }
+    }
+}
@@ -11,6 +11,7 @@
 #include "krado/line.h"
 #include "krado/ops.h"
 #include "krado/ptr.h"
+#include "krado/quality_measures.h"
 
 using namespace krado;
 using namespace testing;
@@ -122,3 +123,63 @@ TEST(SmoothingTest, smooth_surface)
     EXPECT_NEAR(v4->point().y, 1.0, 1e-7);
     EXPECT_THAT(v4->point().z, DoubleEq(0.0));
 }
+
+TEST(SmoothingTest, optimize_surface)
+{
+    auto rect = build_rect(Point(0., 0., 0.), Point(3., 2., 0.));
+
+    auto curves = rect.curves();
+    GeomVertex gv1(curves[3].last_vertex());
+    GeomVertex gv2(curves[0].last_vertex());
+    GeomVertex gv3(curves[2].last_vertex());
+    GeomVertex gv4(curves[1].last_vertex());
+
+    auto v0 = Ptr<MeshVertex>::alloc(1, gv1);
+    auto v1 = Ptr<MeshCurveVertex>::alloc(curves[0], 1.0);
+    auto v2 = Ptr<MeshVertex>::alloc(2, gv2);
+    auto v3 = Ptr<MeshCurveVertex>::alloc(curves[3], 1.0);
+    auto v4 = Ptr<MeshSurfaceVertex>::alloc(rect, 1.2, 0.8);
+    auto v5 = Ptr<MeshCurveVertex>::alloc(curves[1], 1.0);
+    auto v6 = Ptr<MeshVertex>::alloc(3, gv3);
+    auto v7 = Ptr<MeshCurveVertex>::alloc(curves[2], 1.0);
+    auto v8 = Ptr<MeshVertex>::alloc(4, gv4);
+
+    std::vector<Ptr<MeshCurve>> mcrvs;
+    auto surface = Ptr<MeshSurface>::alloc(1, rect, mcrvs);
+    surface->add_vertex(v4);
+    surface->add_triangle({ v0, v1, v4 });
+    surface->add_triangle({ v0, v4, v3 });
+    surface->add_triangle({ v1, v2, v4 });
+    surface->add_triangle({ v2, v5, v4 });
+    surface->add_triangle({ v3, v4, v6 });
+    surface->add_triangle({ v4, v7, v6 });
+    surface->add_triangle({ v4, v5, v8 });
+    surface->add_triangle({ v4, v8, v7 });
+
+    auto min_angle = [&]() {
+        double q = 180.;
+        for (auto & tri : surface->triangles()) {
+            auto vtxs = tri.vertices();
+            std::array<Point, 3> pts = { vtxs[0]->point(), vtxs[1]->point(), vtxs[2]->point() };
+            q = std::min(q, qm::compute_metric(ElementType::TRI3, pts, qm::Metric::MIN_ANGLE));
+        }
+        return q;
+    };
+
+    auto q_before = min_angle();
+
+    SmoothingOptions opts;
+    opts.method = SmoothingMethod::OPTIMIZE;
+    opts.metric = qm::Metric::MIN_ANGLE;
+    opts.iterations = 10;
+    opts.tolerance = 1e-6;
+    krado::smooth(surface, opts);
+
+    EXPECT_GT(min_angle(), q_before);
+    EXPECT_THAT(v4->point().z, DoubleEq(0.0));
+    // vertex stays inside the surface
+    EXPECT_GT(v4->point().x, 0.);
+    EXPECT_LT(v4->point().x, 3.);
+    EXPECT_GT(v4->point().y, 0.);
+    EXPECT_LT(v4->point().y, 2.);
+}
@@ -0,0 +1,72 @@
+#include "gmock/gmock.h"
+#include "krado/task_graph.h"
+#include "krado/thread_pool.h"
+#include "krado/exception.h"
+#include <atomic>
+#include <mutex>
+
+using namespace krado;
+using namespace testing;
+
+TEST(TaskGraphTest, dependencies)
+{
+    std::mutex mutex;
+    std::vector<int> order;
+    auto record = [&](int id) {
+        return [&, id] {
+            std::lock_guard<std::mutex> lock(mutex);
+            order.push_back(id);
+        };
+    };
+
+    TaskGraph graph;
+    auto a = graph.add(record(0));
+    auto b = graph.add(record(1));
+    auto c = graph.add(record(2), { a, b });
+    graph.add(record(3), { c });
+    EXPECT_EQ(graph.size(), 4);
+    graph.run();
+
+    ASSERT_EQ(order.size(), 4);
+    EXPECT_THAT(std::vector<int>(order.begin(), order.begin() + 2), UnorderedElementsAre(0, 1));
+    EXPECT_EQ(order[2], 2);
+    EXPECT_EQ(order[3], 3);
+}
+
+TEST(TaskGraphTest, many)
+{
+    std::atomic<int> count { 0 };
+    TaskGraph graph;
+    std::vector<Index> leaves;
+    for (int i = 0; i < 100; ++i)
+        leaves.push_back(graph.add([&] { count++; }));
+    int total = -1;
+    graph.add([&] { total = count; }, leaves);
+    graph.run();
+    EXPECT_EQ(total, 100);
+}
+
+TEST(TaskGraphTest, single_thread)
+{
+    auto n = num_threads();
+    set_num_threads(1);
+    int val = 0;
+    TaskGraph graph;
+    auto a = graph.add([&] { val += 1; });
+    graph.add([&] { val *= 10; }, { a });
+    graph.run();
+    EXPECT_EQ(val, 10);
+    set_num_threads(n);
+}
+
+TEST(TaskGraphTest, throws)
+{
+    bool ran = false;
+    TaskGraph graph;
+    auto a = graph.add([] { throw Exception("Task failed"); });
+    graph.add([&] { ran = true; }, { a });
+    EXPECT_THROW(graph.run(), Exception);
+    EXPECT_FALSE(ran);
+
+    EXPECT_THROW(graph.add([] {}, { 5 }), Exception);
+}
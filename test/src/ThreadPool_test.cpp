@@ -0,0 +1,78 @@
+#include "gmock/gmock.h"
+#include "krado/thread_pool.h"
+#include "krado/parallel.h"
+#include "krado/exception.h"
+#include <atomic>
+#include <numeric>
+
+using namespace krado;
+using namespace testing;
+
+TEST(ThreadPoolTest, run)
+{
+    ThreadPool pool(4);
+    EXPECT_EQ(pool.num_threads(), 4);
+
+    std::vector<int> vals(1000, 0);
+    pool.run(vals.size(), [&](std::size_t i) { vals[i] = i; });
+    for (std::size_t i = 0; i < vals.size(); ++i)
+        EXPECT_EQ(vals[i], i);
+
+    pool.resize(1);
+    EXPECT_EQ(pool.num_threads(), 1);
+    pool.run(vals.size(), [&](std::size_t i) { vals[i] = 2 * i; });
+    EXPECT_EQ(vals[999], 1998);
+}
+
+TEST(ThreadPoolTest, run_throws)
+{
+    ThreadPool pool(4);
+    EXPECT_THROW(pool.run(100,
+                          [](std::size_t i) {
+                              if (i == 50)
+                                  throw Exception("Failed at {}", i);
+                          }),
+                 Exception);
+}
+
+TEST(ThreadPoolTest, nested)
+{
+    ThreadPool pool(3);
+    std::atomic<int> count { 0 };
+    pool.run(8, [&](std::size_t) { pool.run(8, [&](std::size_t) { count++; }); });
+    EXPECT_EQ(count, 64);
+}
+
+TEST(ThreadPoolTest, num_threads)
+{
+    auto n = num_threads();
+    set_num_threads(2);
+    EXPECT_EQ(num_threads(), 2);
+    set_num_threads(0);
+    EXPECT_GE(num_threads(), 1);
+    set_num_threads(n);
+}
+
+TEST(ThreadPoolTest, parallel_reduce)
+{
+    auto n = num_threads();
+    set_num_threads(4);
+    std::vector<double> vals(100000);
+    std::iota(vals.begin(), vals.end(), 1.);
+    auto sum = parallel_reduce(
+        vals.size(),
+        0.,
+        [&](std::size_t begin, std::size_t end) {
+            return std::accumulate(vals.begin() + begin, vals.begin() + end, 0.);
+        },
+        [](double a, double b) { return a + b; });
+    EXPECT_DOUBLE_EQ(sum, 100000. * 100001. / 2.);
+
+    auto empty = parallel_reduce(
+        0,
+        -1,
+        [](std::size_t, std::size_t) { return 0; },
+        [](int a, int b) { return a + b; });
+    EXPECT_EQ(empty, -1);
+    set_num_threads(n);
+}
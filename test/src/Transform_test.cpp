@@ -146,3 +146,16 @@ TEST(TransformTest, chain_ops_2)
     EXPECT_NEAR(pt2.y, 11, 1e-10);
     EXPECT_NEAR(pt2.z, 17, 1e-10);
 }
+
+TEST(TransformTest, entries)
+{
+    auto trsf = Trsf::identity().scale(2).translate(3, 5, 9);
+    EXPECT_DOUBLE_EQ(trsf(0, 0), 2);
+    EXPECT_DOUBLE_EQ(trsf(1, 1), 2);
+    EXPECT_DOUBLE_EQ(trsf(2, 2), 2);
+    EXPECT_DOUBLE_EQ(trsf(3, 3), 1);
+    EXPECT_DOUBLE_EQ(trsf(0, 3), 3);
+    EXPECT_DOUBLE_EQ(trsf(1, 3), 5);
+    EXPECT_DOUBLE_EQ(trsf(2, 3), 9);
+    EXPECT_DOUBLE_EQ(trsf(3, 0), 0);
+}
@@ -92,6 +92,15 @@ TEST(UtilsTest, human_time)
     EXPECT_EQ(utils::human_time(3725.2), "1h 2m 5.20s");
 }
 
+TEST(UtilsTest, human_bytes)
+{
+    EXPECT_EQ(utils::human_bytes(0), "0B");
+    EXPECT_EQ(utils::human_bytes(1023), "1023B");
+    EXPECT_EQ(utils::human_bytes(1536), "1.50KiB");
+    EXPECT_EQ(utils::human_bytes(2 * 1024 * 1024), "2.00MiB");
+    EXPECT_EQ(utils::human_bytes(std::size_t(3) << 30), "3.00GiB");
+}
+
 TEST(UtilsTest, shift_span)
 {
     std::vector<Index> idxs = { 10, 11, 15, 23 };